@@ -106,6 +106,11 @@ typedef struct PrintConsole
 	ConsolePrint PrintChar;  ///< Callback for printing a character. Should return true if it has handled rendering the graphics (else the print engine will attempt to render via tiles).
 
 	bool consoleInitialised; ///< True if the console is initialized
+
+	u32 utf8Codepoint;       ///< Internal state, UTF-8 sequence decoded so far
+	u8 utf8Left;             ///< Internal state, UTF-8 continuation bytes left
+	u8 utf8RawLen;           ///< Internal state, UTF-8 sequence bytes buffered
+	u8 utf8Raw[4];           ///< Internal state, printed as is if the sequence is invalid
 }PrintConsole;
 
 #define CONSOLE_COLOR_BOLD	(1<<0) ///< Bold text
@@ -22,5 +22,12 @@
 
 
 
+/**
+ * @brief      Queues loading and verifying a firm without waiting for it.
+ *             The path must stay valid until the command completed.
+ *
+ * @return     A ticket for PXI_pollCmd(), PXI_waitCmd() and PXI_getProgress().
+ */
+u32 loadVerifyFirmAsync(const char *const path, bool skipHashCheck);
 s32 loadVerifyFirm(const char *const path, bool skipHashCheck);
 noreturn void firmLaunch(void);
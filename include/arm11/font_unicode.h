@@ -0,0 +1,1322 @@
+//---------------------------------------------------------------------------------
+// Unicode lookup for the 6x10 font
+//---------------------------------------------------------------------------------
+// Unicode (BMP) to 6x10 font glyph lookup. Glyphs 0-255 are the font glyphs in
+// code page 437 layout. Glyphs from UNICODE_ATLAS_BASE on are Cyrillic and
+// Greek letters the font doesn't have. Those are stored packed in unicodeAtlas
+// and unpacked when the console renders them into its glyph cache. Letters
+// with diacritics that have no glyph fall back to the base letter.
+// unicodePages maps the high byte of a code point to 1 + index in
+// unicodeGlyphs, 0 means no glyphs. A glyph of 0 means not mapped.
+
+#define UNICODE_ATLAS_BASE    (256u)
+#define UNICODE_ATLAS_GLYPHS  (78u)
+#define UNICODE_ATLAS_STRIDE  (7u)
+
+// Packs 10 rows of the font columns 1-5 (column 0 is always empty) as
+// 5 bit fields starting with the top row into UNICODE_ATLAS_STRIDE bytes.
+#define ATLAS_GLYPH(r0, r1, r2, r3, r4, r5, r6, r7, r8, r9)                         \
+	ATLAS_BYTES((u64)(r0) | (u64)(r1)<<5 | (u64)(r2)<<10 | (u64)(r3)<<15 |            \
+	            (u64)(r4)<<20 | (u64)(r5)<<25 | (u64)(r6)<<30 | (u64)(r7)<<35 |       \
+	            (u64)(r8)<<40 | (u64)(r9)<<45)
+#define ATLAS_BYTES(v)  (u8)(v), (u8)((v)>>8), (u8)((v)>>16), (u8)((v)>>24), \
+	                       (u8)((v)>>32), (u8)((v)>>40), (u8)((v)>>48)
+
+static const u8 unicodeAtlas[UNICODE_ATLAS_GLYPHS * UNICODE_ATLAS_STRIDE] = {
+	/* 256 0x100 U+0394 'Δ' */
+	ATLAS_GLYPH(
+		0b00000,
+		0b00100,
+		0b00100,
+		0b01010,
+		0b01010,
+		0b10001,
+		0b10001,
+		0b11111,
+		0b00000,
+		0b00000
+	),
+
+	/* 257 0x101 U+039B 'Λ' */
+	ATLAS_GLYPH(
+		0b00000,
+		0b00100,
+		0b00100,
+		0b01010,
+		0b01010,
+		0b10001,
+		0b10001,
+		0b10001,
+		0b00000,
+		0b00000
+	),
+
+	/* 258 0x102 U+039E 'Ξ' */
+	ATLAS_GLYPH(
+		0b00000,
+		0b11111,
+		0b00000,
+		0b00000,
+		0b01110,
+		0b00000,
+		0b00000,
+		0b11111,
+		0b00000,
+		0b00000
+	),
+
+	/* 259 0x103 U+03A8 'Ψ' */
+	ATLAS_GLYPH(
+		0b00000,
+		0b10101,
+		0b10101,
+		0b10101,
+		0b01110,
+		0b00100,
+		0b00100,
+		0b00100,
+		0b00000,
+		0b00000
+	),
+
+	/* 260 0x104 U+03B3 'γ' */
+	ATLAS_GLYPH(
+		0b00000,
+		0b00000,
+		0b00000,
+		0b10001,
+		0b01010,
+		0b01010,
+		0b00100,
+		0b00100,
+		0b00100,
+		0b00000
+	),
+
+	/* 261 0x105 U+03B6 'ζ' */
+	ATLAS_GLYPH(
+		0b00000,
+		0b01111,
+		0b00010,
+		0b00100,
+		0b01000,
+		0b10000,
+		0b10000,
+		0b01110,
+		0b00001,
+		0b00010
+	),
+
+	/* 262 0x106 U+03B7 'η' */
+	ATLAS_GLYPH(
+		0b00000,
+		0b00000,
+		0b00000,
+		0b10110,
+		0b11001,
+		0b10001,
+		0b10001,
+		0b10001,
+		0b00001,
+		0b00001
+	),
+
+	/* 263 0x107 U+03B8 'θ' */
+	ATLAS_GLYPH(
+		0b00000,
+		0b01110,
+		0b10001,
+		0b10001,
+		0b11111,
+		0b10001,
+		0b10001,
+		0b01110,
+		0b00000,
+		0b00000
+	),
+
+	/* 264 0x108 U+03B9 'ι' */
+	ATLAS_GLYPH(
+		0b00000,
+		0b00000,
+		0b00000,
+		0b01100,
+		0b00100,
+		0b00100,
+		0b00100,
+		0b00011,
+		0b00000,
+		0b00000
+	),
+
+	/* 265 0x109 U+03BB 'λ' */
+	ATLAS_GLYPH(
+		0b00000,
+		0b10000,
+		0b01000,
+		0b01000,
+		0b00100,
+		0b01010,
+		0b10001,
+		0b10001,
+		0b00000,
+		0b00000
+	),
+
+	/* 266 0x10A U+03BE 'ξ' */
+	ATLAS_GLYPH(
+		0b00000,
+		0b01111,
+		0b10000,
+		0b01110,
+		0b10000,
+		0b10000,
+		0b10000,
+		0b01110,
+		0b00001,
+		0b00110
+	),
+
+	/* 267 0x10B U+03C2 'ς' */
+	ATLAS_GLYPH(
+		0b00000,
+		0b00000,
+		0b00000,
+		0b01111,
+		0b10000,
+		0b10000,
+		0b01110,
+		0b00001,
+		0b00010,
+		0b00000
+	),
+
+	/* 268 0x10C U+03C8 'ψ' */
+	ATLAS_GLYPH(
+		0b00000,
+		0b00000,
+		0b00000,
+		0b10101,
+		0b10101,
+		0b10101,
+		0b01110,
+		0b00100,
+		0b00100,
+		0b00000
+	),
+
+	/* 269 0x10D U+03C9 'ω' */
+	ATLAS_GLYPH(
+		0b00000,
+		0b00000,
+		0b00000,
+		0b01010,
+		0b10001,
+		0b10101,
+		0b10101,
+		0b01010,
+		0b00000,
+		0b00000
+	),
+
+	/* 270 0x10E U+0401 'Ё' */
+	ATLAS_GLYPH(
+		0b01010,
+		0b11111,
+		0b10000,
+		0b10000,
+		0b11110,
+		0b10000,
+		0b10000,
+		0b11111,
+		0b00000,
+		0b00000
+	),
+
+	/* 271 0x10F U+0402 'Ђ' */
+	ATLAS_GLYPH(
+		0b00000,
+		0b11111,
+		0b00100,
+		0b00100,
+		0b00111,
+		0b00101,
+		0b00101,
+		0b00101,
+		0b00001,
+		0b00010
+	),
+
+	/* 272 0x110 U+0404 'Є' */
+	ATLAS_GLYPH(
+		0b00000,
+		0b01110,
+		0b10001,
+		0b10000,
+		0b11100,
+		0b10000,
+		0b10001,
+		0b01110,
+		0b00000,
+		0b00000
+	),
+
+	/* 273 0x111 U+0407 'Ї' */
+	ATLAS_GLYPH(
+		0b01010,
+		0b01110,
+		0b00100,
+		0b00100,
+		0b00100,
+		0b00100,
+		0b00100,
+		0b01110,
+		0b00000,
+		0b00000
+	),
+
+	/* 274 0x112 U+0409 'Љ' */
+	ATLAS_GLYPH(
+		0b00000,
+		0b01100,
+		0b10100,
+		0b10100,
+		0b10111,
+		0b10101,
+		0b10101,
+		0b10110,
+		0b00000,
+		0b00000
+	),
+
+	/* 275 0x113 U+040A 'Њ' */
+	ATLAS_GLYPH(
+		0b00000,
+		0b10100,
+		0b10100,
+		0b10100,
+		0b10111,
+		0b11101,
+		0b10101,
+		0b10110,
+		0b00000,
+		0b00000
+	),
+
+	/* 276 0x114 U+040B 'Ћ' */
+	ATLAS_GLYPH(
+		0b00000,
+		0b11111,
+		0b00100,
+		0b00100,
+		0b00111,
+		0b00101,
+		0b00101,
+		0b00101,
+		0b00000,
+		0b00000
+	),
+
+	/* 277 0x115 U+040E 'Ў' */
+	ATLAS_GLYPH(
+		0b10001,
+		0b01110,
+		0b10001,
+		0b10001,
+		0b01111,
+		0b00001,
+		0b10001,
+		0b01110,
+		0b00000,
+		0b00000
+	),
+
+	/* 278 0x116 U+040F 'Џ' */
+	ATLAS_GLYPH(
+		0b00000,
+		0b10001,
+		0b10001,
+		0b10001,
+		0b10001,
+		0b10001,
+		0b10001,
+		0b11111,
+		0b00100,
+		0b00000
+	),
+
+	/* 279 0x117 U+0411 'Б' */
+	ATLAS_GLYPH(
+		0b00000,
+		0b11111,
+		0b10000,
+		0b10000,
+		0b11110,
+		0b10001,
+		0b10001,
+		0b11110,
+		0b00000,
+		0b00000
+	),
+
+	/* 280 0x118 U+0413 'Г' */
+	ATLAS_GLYPH(
+		0b00000,
+		0b11111,
+		0b10000,
+		0b10000,
+		0b10000,
+		0b10000,
+		0b10000,
+		0b10000,
+		0b00000,
+		0b00000
+	),
+
+	/* 281 0x119 U+0414 'Д' */
+	ATLAS_GLYPH(
+		0b00000,
+		0b01110,
+		0b01010,
+		0b01010,
+		0b01010,
+		0b01010,
+		0b01010,
+		0b11111,
+		0b10001,
+		0b00000
+	),
+
+	/* 282 0x11A U+0416 'Ж' */
+	ATLAS_GLYPH(
+		0b00000,
+		0b10101,
+		0b10101,
+		0b01110,
+		0b00100,
+		0b01110,
+		0b10101,
+		0b10101,
+		0b00000,
+		0b00000
+	),
+
+	/* 283 0x11B U+0417 'З' */
+	ATLAS_GLYPH(
+		0b00000,
+		0b01110,
+		0b10001,
+		0b00001,
+		0b00110,
+		0b00001,
+		0b10001,
+		0b01110,
+		0b00000,
+		0b00000
+	),
+
+	/* 284 0x11C U+0418 'И' */
+	ATLAS_GLYPH(
+		0b00000,
+		0b10001,
+		0b10001,
+		0b10011,
+		0b10101,
+		0b11001,
+		0b10001,
+		0b10001,
+		0b00000,
+		0b00000
+	),
+
+	/* 285 0x11D U+0419 'Й' */
+	ATLAS_GLYPH(
+		0b10001,
+		0b01110,
+		0b10001,
+		0b10011,
+		0b10101,
+		0b11001,
+		0b10001,
+		0b10001,
+		0b00000,
+		0b00000
+	),
+
+	/* 286 0x11E U+041B 'Л' */
+	ATLAS_GLYPH(
+		0b00000,
+		0b00111,
+		0b01001,
+		0b01001,
+		0b01001,
+		0b01001,
+		0b01001,
+		0b10001,
+		0b00000,
+		0b00000
+	),
+
+	/* 287 0x11F U+041F 'П' */
+	ATLAS_GLYPH(
+		0b00000,
+		0b11111,
+		0b10001,
+		0b10001,
+		0b10001,
+		0b10001,
+		0b10001,
+		0b10001,
+		0b00000,
+		0b00000
+	),
+
+	/* 288 0x120 U+0423 'У' */
+	ATLAS_GLYPH(
+		0b00000,
+		0b10001,
+		0b10001,
+		0b10001,
+		0b01111,
+		0b00001,
+		0b10001,
+		0b01110,
+		0b00000,
+		0b00000
+	),
+
+	/* 289 0x121 U+0424 'Ф' */
+	ATLAS_GLYPH(
+		0b00000,
+		0b00100,
+		0b01110,
+		0b10101,
+		0b10101,
+		0b10101,
+		0b01110,
+		0b00100,
+		0b00000,
+		0b00000
+	),
+
+	/* 290 0x122 U+0426 'Ц' */
+	ATLAS_GLYPH(
+		0b00000,
+		0b10010,
+		0b10010,
+		0b10010,
+		0b10010,
+		0b10010,
+		0b10010,
+		0b11111,
+		0b00001,
+		0b00000
+	),
+
+	/* 291 0x123 U+0427 'Ч' */
+	ATLAS_GLYPH(
+		0b00000,
+		0b10001,
+		0b10001,
+		0b10001,
+		0b01111,
+		0b00001,
+		0b00001,
+		0b00001,
+		0b00000,
+		0b00000
+	),
+
+	/* 292 0x124 U+0428 'Ш' */
+	ATLAS_GLYPH(
+		0b00000,
+		0b10101,
+		0b10101,
+		0b10101,
+		0b10101,
+		0b10101,
+		0b10101,
+		0b11111,
+		0b00000,
+		0b00000
+	),
+
+	/* 293 0x125 U+0429 'Щ' */
+	ATLAS_GLYPH(
+		0b00000,
+		0b10101,
+		0b10101,
+		0b10101,
+		0b10101,
+		0b10101,
+		0b10101,
+		0b11111,
+		0b00001,
+		0b00000
+	),
+
+	/* 294 0x126 U+042A 'Ъ' */
+	ATLAS_GLYPH(
+		0b00000,
+		0b11000,
+		0b01000,
+		0b01000,
+		0b01110,
+		0b01001,
+		0b01001,
+		0b01110,
+		0b00000,
+		0b00000
+	),
+
+	/* 295 0x127 U+042B 'Ы' */
+	ATLAS_GLYPH(
+		0b00000,
+		0b10001,
+		0b10001,
+		0b10001,
+		0b11101,
+		0b10101,
+		0b10101,
+		0b11101,
+		0b00000,
+		0b00000
+	),
+
+	/* 296 0x128 U+042C 'Ь' */
+	ATLAS_GLYPH(
+		0b00000,
+		0b10000,
+		0b10000,
+		0b10000,
+		0b11110,
+		0b10001,
+		0b10001,
+		0b11110,
+		0b00000,
+		0b00000
+	),
+
+	/* 297 0x129 U+042D 'Э' */
+	ATLAS_GLYPH(
+		0b00000,
+		0b01110,
+		0b10001,
+		0b00001,
+		0b00111,
+		0b00001,
+		0b10001,
+		0b01110,
+		0b00000,
+		0b00000
+	),
+
+	/* 298 0x12A U+042E 'Ю' */
+	ATLAS_GLYPH(
+		0b00000,
+		0b10010,
+		0b10101,
+		0b10101,
+		0b11101,
+		0b10101,
+		0b10101,
+		0b10010,
+		0b00000,
+		0b00000
+	),
+
+	/* 299 0x12B U+042F 'Я' */
+	ATLAS_GLYPH(
+		0b00000,
+		0b01111,
+		0b10001,
+		0b10001,
+		0b01111,
+		0b00101,
+		0b01001,
+		0b10001,
+		0b00000,
+		0b00000
+	),
+
+	/* 300 0x12C U+0431 'б' */
+	ATLAS_GLYPH(
+		0b00000,
+		0b00110,
+		0b01000,
+		0b10000,
+		0b11110,
+		0b10001,
+		0b10001,
+		0b01110,
+		0b00000,
+		0b00000
+	),
+
+	/* 301 0x12D U+0432 'в' */
+	ATLAS_GLYPH(
+		0b00000,
+		0b00000,
+		0b00000,
+		0b11110,
+		0b10001,
+		0b11110,
+		0b10001,
+		0b11110,
+		0b00000,
+		0b00000
+	),
+
+	/* 302 0x12E U+0433 'г' */
+	ATLAS_GLYPH(
+		0b00000,
+		0b00000,
+		0b00000,
+		0b11111,
+		0b10000,
+		0b10000,
+		0b10000,
+		0b10000,
+		0b00000,
+		0b00000
+	),
+
+	/* 303 0x12F U+0434 'д' */
+	ATLAS_GLYPH(
+		0b00000,
+		0b00000,
+		0b00000,
+		0b01110,
+		0b01010,
+		0b01010,
+		0b01010,
+		0b11111,
+		0b10001,
+		0b00000
+	),
+
+	/* 304 0x130 U+0436 'ж' */
+	ATLAS_GLYPH(
+		0b00000,
+		0b00000,
+		0b00000,
+		0b10101,
+		0b10101,
+		0b01110,
+		0b10101,
+		0b10101,
+		0b00000,
+		0b00000
+	),
+
+	/* 305 0x131 U+0437 'з' */
+	ATLAS_GLYPH(
+		0b00000,
+		0b00000,
+		0b00000,
+		0b01110,
+		0b00001,
+		0b00110,
+		0b00001,
+		0b01110,
+		0b00000,
+		0b00000
+	),
+
+	/* 306 0x132 U+0438 'и' */
+	ATLAS_GLYPH(
+		0b00000,
+		0b00000,
+		0b00000,
+		0b10001,
+		0b10011,
+		0b10101,
+		0b11001,
+		0b10001,
+		0b00000,
+		0b00000
+	),
+
+	/* 307 0x133 U+0439 'й' */
+	ATLAS_GLYPH(
+		0b00000,
+		0b10001,
+		0b01110,
+		0b10001,
+		0b10011,
+		0b10101,
+		0b11001,
+		0b10001,
+		0b00000,
+		0b00000
+	),
+
+	/* 308 0x134 U+043A 'к' */
+	ATLAS_GLYPH(
+		0b00000,
+		0b00000,
+		0b00000,
+		0b10010,
+		0b10100,
+		0b11000,
+		0b10100,
+		0b10010,
+		0b00000,
+		0b00000
+	),
+
+	/* 309 0x135 U+043B 'л' */
+	ATLAS_GLYPH(
+		0b00000,
+		0b00000,
+		0b00000,
+		0b00111,
+		0b01001,
+		0b01001,
+		0b01001,
+		0b10001,
+		0b00000,
+		0b00000
+	),
+
+	/* 310 0x136 U+043C 'м' */
+	ATLAS_GLYPH(
+		0b00000,
+		0b00000,
+		0b00000,
+		0b10001,
+		0b11011,
+		0b10101,
+		0b10001,
+		0b10001,
+		0b00000,
+		0b00000
+	),
+
+	/* 311 0x137 U+043D 'н' */
+	ATLAS_GLYPH(
+		0b00000,
+		0b00000,
+		0b00000,
+		0b10001,
+		0b10001,
+		0b11111,
+		0b10001,
+		0b10001,
+		0b00000,
+		0b00000
+	),
+
+	/* 312 0x138 U+043F 'п' */
+	ATLAS_GLYPH(
+		0b00000,
+		0b00000,
+		0b00000,
+		0b11111,
+		0b10001,
+		0b10001,
+		0b10001,
+		0b10001,
+		0b00000,
+		0b00000
+	),
+
+	/* 313 0x139 U+0442 'т' */
+	ATLAS_GLYPH(
+		0b00000,
+		0b00000,
+		0b00000,
+		0b11111,
+		0b00100,
+		0b00100,
+		0b00100,
+		0b00100,
+		0b00000,
+		0b00000
+	),
+
+	/* 314 0x13A U+0444 'ф' */
+	ATLAS_GLYPH(
+		0b00000,
+		0b00000,
+		0b00100,
+		0b01110,
+		0b10101,
+		0b10101,
+		0b10101,
+		0b01110,
+		0b00100,
+		0b00000
+	),
+
+	/* 315 0x13B U+0446 'ц' */
+	ATLAS_GLYPH(
+		0b00000,
+		0b00000,
+		0b00000,
+		0b10010,
+		0b10010,
+		0b10010,
+		0b10010,
+		0b11111,
+		0b00001,
+		0b00000
+	),
+
+	/* 316 0x13C U+0447 'ч' */
+	ATLAS_GLYPH(
+		0b00000,
+		0b00000,
+		0b00000,
+		0b10001,
+		0b10001,
+		0b01111,
+		0b00001,
+		0b00001,
+		0b00000,
+		0b00000
+	),
+
+	/* 317 0x13D U+0448 'ш' */
+	ATLAS_GLYPH(
+		0b00000,
+		0b00000,
+		0b00000,
+		0b10101,
+		0b10101,
+		0b10101,
+		0b10101,
+		0b11111,
+		0b00000,
+		0b00000
+	),
+
+	/* 318 0x13E U+0449 'щ' */
+	ATLAS_GLYPH(
+		0b00000,
+		0b00000,
+		0b00000,
+		0b10101,
+		0b10101,
+		0b10101,
+		0b10101,
+		0b11111,
+		0b00001,
+		0b00000
+	),
+
+	/* 319 0x13F U+044A 'ъ' */
+	ATLAS_GLYPH(
+		0b00000,
+		0b00000,
+		0b00000,
+		0b11000,
+		0b01000,
+		0b01110,
+		0b01001,
+		0b01110,
+		0b00000,
+		0b00000
+	),
+
+	/* 320 0x140 U+044B 'ы' */
+	ATLAS_GLYPH(
+		0b00000,
+		0b00000,
+		0b00000,
+		0b10001,
+		0b10001,
+		0b11101,
+		0b10101,
+		0b11101,
+		0b00000,
+		0b00000
+	),
+
+	/* 321 0x141 U+044C 'ь' */
+	ATLAS_GLYPH(
+		0b00000,
+		0b00000,
+		0b00000,
+		0b10000,
+		0b10000,
+		0b11110,
+		0b10001,
+		0b11110,
+		0b00000,
+		0b00000
+	),
+
+	/* 322 0x142 U+044D 'э' */
+	ATLAS_GLYPH(
+		0b00000,
+		0b00000,
+		0b00000,
+		0b01110,
+		0b00001,
+		0b01111,
+		0b00001,
+		0b01110,
+		0b00000,
+		0b00000
+	),
+
+	/* 323 0x143 U+044E 'ю' */
+	ATLAS_GLYPH(
+		0b00000,
+		0b00000,
+		0b00000,
+		0b10010,
+		0b10101,
+		0b11101,
+		0b10101,
+		0b10010,
+		0b00000,
+		0b00000
+	),
+
+	/* 324 0x144 U+044F 'я' */
+	ATLAS_GLYPH(
+		0b00000,
+		0b00000,
+		0b00000,
+		0b01111,
+		0b10001,
+		0b01111,
+		0b01001,
+		0b10001,
+		0b00000,
+		0b00000
+	),
+
+	/* 325 0x145 U+0452 'ђ' */
+	ATLAS_GLYPH(
+		0b00000,
+		0b01000,
+		0b11100,
+		0b01000,
+		0b01110,
+		0b01001,
+		0b01001,
+		0b01001,
+		0b00001,
+		0b00110
+	),
+
+	/* 326 0x146 U+0454 'є' */
+	ATLAS_GLYPH(
+		0b00000,
+		0b00000,
+		0b00000,
+		0b01110,
+		0b10000,
+		0b11100,
+		0b10000,
+		0b01110,
+		0b00000,
+		0b00000
+	),
+
+	/* 327 0x147 U+0459 'љ' */
+	ATLAS_GLYPH(
+		0b00000,
+		0b00000,
+		0b00000,
+		0b01100,
+		0b10100,
+		0b10110,
+		0b10101,
+		0b10110,
+		0b00000,
+		0b00000
+	),
+
+	/* 328 0x148 U+045A 'њ' */
+	ATLAS_GLYPH(
+		0b00000,
+		0b00000,
+		0b00000,
+		0b10100,
+		0b10100,
+		0b11110,
+		0b10101,
+		0b10110,
+		0b00000,
+		0b00000
+	),
+
+	/* 329 0x149 U+045B 'ћ' */
+	ATLAS_GLYPH(
+		0b00000,
+		0b01000,
+		0b11100,
+		0b01000,
+		0b01110,
+		0b01001,
+		0b01001,
+		0b01001,
+		0b00000,
+		0b00000
+	),
+
+	/* 330 0x14A U+045E 'ў' */
+	ATLAS_GLYPH(
+		0b00000,
+		0b10001,
+		0b01110,
+		0b10001,
+		0b10001,
+		0b10001,
+		0b10001,
+		0b01111,
+		0b00001,
+		0b01110
+	),
+
+	/* 331 0x14B U+045F 'џ' */
+	ATLAS_GLYPH(
+		0b00000,
+		0b00000,
+		0b00000,
+		0b10001,
+		0b10001,
+		0b10001,
+		0b10001,
+		0b11111,
+		0b00100,
+		0b00000
+	),
+
+	/* 332 0x14C U+0490 'Ґ' */
+	ATLAS_GLYPH(
+		0b00001,
+		0b11111,
+		0b10000,
+		0b10000,
+		0b10000,
+		0b10000,
+		0b10000,
+		0b10000,
+		0b00000,
+		0b00000
+	),
+
+	/* 333 0x14D U+0491 'ґ' */
+	ATLAS_GLYPH(
+		0b00000,
+		0b00000,
+		0b00001,
+		0b11111,
+		0b10000,
+		0b10000,
+		0b10000,
+		0b10000,
+		0b00000,
+		0b00000
+	),
+};
+
+#undef ATLAS_BYTES
+#undef ATLAS_GLYPH
+
+static const u8 unicodePages[256] = {
+	1, 2, 0, 3, 4, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+	0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+	5, 6, 7, 8, 0, 9, 10, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+	0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+	0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+	0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+	0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+	0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+	0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+	0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+	0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+	0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+	0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+	0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+	0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+	0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+};
+
+static const u16 unicodeGlyphs[10][256] = {
+	{ // U+0000
+		0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000,
+		0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000,
+		0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000,
+		0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000,
+		0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000,
+		0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000,
+		0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000,
+		0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000,
+		0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000,
+		0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000,
+		0x0FF, 0x0AD, 0x09B, 0x09C, 0x000, 0x09D, 0x000, 0x015, 0x000, 0x000, 0x0A6, 0x0AE, 0x0AA, 0x000, 0x000, 0x000,
+		0x0F8, 0x0F1, 0x0FD, 0x000, 0x000, 0x0E6, 0x014, 0x0FA, 0x000, 0x000, 0x0A7, 0x0AF, 0x0AC, 0x0AB, 0x000, 0x0A8,
+		0x041, 0x041, 0x041, 0x041, 0x08E, 0x08F, 0x092, 0x080, 0x045, 0x090, 0x045, 0x045, 0x049, 0x049, 0x049, 0x049,
+		0x044, 0x0A5, 0x04F, 0x04F, 0x04F, 0x04F, 0x099, 0x078, 0x04F, 0x055, 0x055, 0x055, 0x09A, 0x059, 0x050, 0x0E1,
+		0x085, 0x0A0, 0x083, 0x061, 0x084, 0x086, 0x091, 0x087, 0x08A, 0x082, 0x088, 0x089, 0x08D, 0x0A1, 0x08C, 0x08B,
+		0x064, 0x0A4, 0x095, 0x0A2, 0x093, 0x06F, 0x094, 0x0F6, 0x06F, 0x097, 0x0A3, 0x096, 0x081, 0x079, 0x070, 0x098,
+	},
+	{ // U+0100
+		0x041, 0x061, 0x041, 0x061, 0x041, 0x061, 0x043, 0x063, 0x043, 0x063, 0x043, 0x063, 0x043, 0x063, 0x044, 0x064,
+		0x044, 0x064, 0x045, 0x065, 0x045, 0x065, 0x045, 0x065, 0x045, 0x065, 0x045, 0x065, 0x047, 0x067, 0x047, 0x067,
+		0x047, 0x067, 0x047, 0x067, 0x048, 0x068, 0x000, 0x000, 0x049, 0x069, 0x049, 0x069, 0x049, 0x069, 0x049, 0x069,
+		0x049, 0x000, 0x000, 0x000, 0x04A, 0x06A, 0x04B, 0x06B, 0x000, 0x04C, 0x06C, 0x04C, 0x06C, 0x04C, 0x06C, 0x000,
+		0x000, 0x04C, 0x06C, 0x04E, 0x06E, 0x04E, 0x06E, 0x04E, 0x06E, 0x000, 0x000, 0x000, 0x04F, 0x06F, 0x04F, 0x06F,
+		0x04F, 0x06F, 0x04F, 0x06F, 0x052, 0x072, 0x052, 0x072, 0x052, 0x072, 0x053, 0x073, 0x053, 0x073, 0x053, 0x073,
+		0x053, 0x073, 0x054, 0x074, 0x054, 0x074, 0x000, 0x000, 0x055, 0x075, 0x055, 0x075, 0x055, 0x075, 0x055, 0x075,
+		0x055, 0x075, 0x055, 0x075, 0x057, 0x077, 0x059, 0x079, 0x059, 0x05A, 0x07A, 0x05A, 0x07A, 0x05A, 0x07A, 0x000,
+		0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000,
+		0x000, 0x000, 0x09F, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000,
+		0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000,
+		0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000,
+		0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000,
+		0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000,
+		0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000,
+		0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000,
+	},
+	{ // U+0300
+		0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000,
+		0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000,
+		0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000,
+		0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000,
+		0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000,
+		0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000,
+		0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000,
+		0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000,
+		0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x041, 0x000, 0x045, 0x048, 0x049, 0x000, 0x04F, 0x000, 0x059, 0x0EA,
+		0x108, 0x041, 0x042, 0x0E2, 0x100, 0x045, 0x05A, 0x048, 0x0E9, 0x049, 0x04B, 0x101, 0x04D, 0x04E, 0x102, 0x04F,
+		0x11F, 0x050, 0x000, 0x0E4, 0x054, 0x059, 0x0E8, 0x058, 0x103, 0x0EA, 0x049, 0x059, 0x0E0, 0x0EE, 0x106, 0x108,
+		0x075, 0x0E0, 0x0E1, 0x104, 0x0EB, 0x0EE, 0x105, 0x106, 0x107, 0x108, 0x134, 0x109, 0x0E6, 0x076, 0x10A, 0x06F,
+		0x0E3, 0x070, 0x10B, 0x0E5, 0x0E7, 0x075, 0x0ED, 0x078, 0x10C, 0x10D, 0x108, 0x075, 0x06F, 0x075, 0x10D, 0x000,
+		0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000,
+		0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000,
+		0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000,
+	},
+	{ // U+0400
+		0x045, 0x10E, 0x10F, 0x118, 0x110, 0x053, 0x049, 0x111, 0x04A, 0x112, 0x113, 0x114, 0x04B, 0x11C, 0x115, 0x116,
+		0x041, 0x117, 0x042, 0x118, 0x119, 0x045, 0x11A, 0x11B, 0x11C, 0x11D, 0x04B, 0x11E, 0x04D, 0x048, 0x04F, 0x11F,
+		0x050, 0x043, 0x054, 0x120, 0x121, 0x058, 0x122, 0x123, 0x124, 0x125, 0x126, 0x127, 0x128, 0x129, 0x12A, 0x12B,
+		0x061, 0x12C, 0x12D, 0x12E, 0x12F, 0x065, 0x130, 0x131, 0x132, 0x133, 0x134, 0x135, 0x136, 0x137, 0x06F, 0x138,
+		0x070, 0x063, 0x139, 0x079, 0x13A, 0x078, 0x13B, 0x13C, 0x13D, 0x13E, 0x13F, 0x140, 0x141, 0x142, 0x143, 0x144,
+		0x08A, 0x089, 0x145, 0x12E, 0x146, 0x073, 0x069, 0x08B, 0x06A, 0x147, 0x148, 0x149, 0x134, 0x132, 0x14A, 0x14B,
+		0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000,
+		0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000,
+		0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000,
+		0x14C, 0x14D, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000,
+		0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000,
+		0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000,
+		0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000,
+		0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000,
+		0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000,
+		0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000,
+	},
+	{ // U+2000
+		0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000,
+		0x000, 0x000, 0x000, 0x02D, 0x02D, 0x000, 0x000, 0x000, 0x027, 0x027, 0x000, 0x000, 0x022, 0x022, 0x000, 0x000,
+		0x000, 0x000, 0x007, 0x000, 0x000, 0x000, 0x02E, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000,
+		0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x013, 0x000, 0x000, 0x000,
+		0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000,
+		0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000,
+		0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000,
+		0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x0FC,
+		0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000,
+		0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000,
+		0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x09E, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000,
+		0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000,
+		0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000,
+		0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000,
+		0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000,
+		0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000,
+	},
+	{ // U+2100
+		0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000,
+		0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000,
+		0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x0EA, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000,
+		0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000,
+		0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000,
+		0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000,
+		0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000,
+		0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000,
+		0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000,
+		0x01B, 0x018, 0x01A, 0x019, 0x01D, 0x012, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000,
+		0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x017, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000,
+		0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000,
+		0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000,
+		0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000,
+		0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000,
+		0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000,
+	},
+	{ // U+2200
+		0x000, 0x000, 0x000, 0x000, 0x000, 0x0ED, 0x000, 0x000, 0x0EE, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000,
+		0x000, 0x0E4, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x0F9, 0x0FB, 0x000, 0x000, 0x000, 0x0EC, 0x01C,
+		0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x0EF, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000,
+		0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000,
+		0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x0F7, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000,
+		0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000,
+		0x000, 0x0F0, 0x000, 0x000, 0x0F3, 0x0F2, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000,
+		0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000,
+		0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000,
+		0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000,
+		0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000,
+		0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000,
+		0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000,
+		0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000,
+		0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000,
+		0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000,
+	},
+	{ // U+2300
+		0x000, 0x000, 0x07F, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000,
+		0x0A9, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000,
+		0x0F4, 0x0F5, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000,
+		0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000,
+		0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000,
+		0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000,
+		0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000,
+		0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000,
+		0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000,
+		0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000,
+		0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000,
+		0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000,
+		0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000,
+		0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000,
+		0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000,
+		0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000,
+	},
+	{ // U+2500
+		0x0C4, 0x000, 0x0B3, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x0DA, 0x000, 0x000, 0x000,
+		0x0BF, 0x000, 0x000, 0x000, 0x0C0, 0x000, 0x000, 0x000, 0x0D9, 0x000, 0x000, 0x000, 0x0C3, 0x000, 0x000, 0x000,
+		0x000, 0x000, 0x000, 0x000, 0x0B4, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x0C2, 0x000, 0x000, 0x000,
+		0x000, 0x000, 0x000, 0x000, 0x0C1, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x0C5, 0x000, 0x000, 0x000,
+		0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000,
+		0x0CD, 0x0BA, 0x0D5, 0x0D6, 0x0C9, 0x0B8, 0x0B7, 0x0BB, 0x0D4, 0x0D3, 0x0C8, 0x0BE, 0x0BD, 0x0BC, 0x0C6, 0x0C7,
+		0x0CC, 0x0B5, 0x0B6, 0x0B9, 0x0D1, 0x0D2, 0x0CB, 0x0CF, 0x0D0, 0x0CA, 0x0D8, 0x0D7, 0x0CE, 0x000, 0x000, 0x000,
+		0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000,
+		0x0DF, 0x000, 0x000, 0x000, 0x0DC, 0x000, 0x000, 0x000, 0x0DB, 0x000, 0x000, 0x000, 0x0DD, 0x000, 0x000, 0x000,
+		0x0DE, 0x0B0, 0x0B1, 0x0B2, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000,
+		0x0FE, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x016, 0x000, 0x000, 0x000,
+		0x000, 0x000, 0x01E, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x010, 0x000, 0x01F, 0x000, 0x000, 0x000,
+		0x000, 0x000, 0x000, 0x000, 0x011, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x009, 0x000, 0x000, 0x000, 0x000,
+		0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x008, 0x00A, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000,
+		0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000,
+		0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000,
+	},
+	{ // U+2600
+		0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000,
+		0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000,
+		0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000,
+		0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x001, 0x002, 0x00F, 0x000, 0x000, 0x000,
+		0x00C, 0x000, 0x00B, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000,
+		0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000,
+		0x006, 0x000, 0x000, 0x005, 0x000, 0x003, 0x004, 0x000, 0x000, 0x000, 0x00D, 0x00E, 0x000, 0x000, 0x000, 0x000,
+		0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000,
+		0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000,
+		0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000,
+		0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000,
+		0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000,
+		0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000,
+		0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000,
+		0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000,
+		0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000,
+	},
+};
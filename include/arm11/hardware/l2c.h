@@ -0,0 +1,64 @@
+#pragma once
+
+/*
+ *   This file is part of fastboot 3DS
+ *   Copyright (C) 2017 derrek, profi200
+ *
+ *   This program is free software: you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License as published by
+ *   the Free Software Foundation, either version 3 of the License, or
+ *   (at your option) any later version.
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "types.h"
+#include "mem_map.h"
+
+
+// L2C-310 outer cache. New 3DS only.
+#define L2C_REGS_BASE         (L2_CACHE_CONTR_BASE)
+#define REG_L2C_CACHE_ID      *((vu32*)(L2C_REGS_BASE + 0x000))
+#define REG_L2C_CACHE_TYPE    *((vu32*)(L2C_REGS_BASE + 0x004))
+#define REG_L2C_CNT           *((vu32*)(L2C_REGS_BASE + 0x100))
+#define REG_L2C_AUX_CNT       *((vu32*)(L2C_REGS_BASE + 0x104))
+#define REG_L2C_SYNC          *((vu32*)(L2C_REGS_BASE + 0x730))
+#define REG_L2C_INV_PA        *((vu32*)(L2C_REGS_BASE + 0x770))
+#define REG_L2C_INV_WAY       *((vu32*)(L2C_REGS_BASE + 0x77C))
+#define REG_L2C_CLEAN_PA      *((vu32*)(L2C_REGS_BASE + 0x7B0))
+#define REG_L2C_CLEAN_WAY     *((vu32*)(L2C_REGS_BASE + 0x7BC))
+#define REG_L2C_CLEAN_INV_PA  *((vu32*)(L2C_REGS_BASE + 0x7F0))
+#define REG_L2C_CLEAN_INV_WAY *((vu32*)(L2C_REGS_BASE + 0x7FC))
+
+#define L2C_LINE_SIZE         (32)
+
+
+
+/**
+ * @brief      Invalidates and enables the L2 cache on New 3DS. Call on core 0 only.
+ */
+void L2C_init(void);
+
+/**
+ * @brief      Cleans, invalidates and disables the L2 cache. Call on core 0 before
+ *             launching firms after all other cores stopped using memory.
+ */
+void L2C_deinit(void);
+
+/**
+ * @brief      Returns true if the L2 cache is enabled.
+ */
+bool L2C_isEnabled(void);
+
+// Range operations by physical address. All memory is identity mapped.
+// The L1 operations in cache.s call these after handling the L1.
+// No-ops with the L2 cache disabled.
+void L2C_flushRange(const void *const base, u32 size);
+void L2C_flushInvalidateRange(const void *const base, u32 size);
+void L2C_invalidateRange(const void *const base, u32 size);
@@ -0,0 +1,81 @@
+#pragma once
+
+/*
+ *   This file is part of fastboot 3DS
+ *   Copyright (C) 2017 derrek, profi200
+ *
+ *   This program is free software: you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License as published by
+ *   the Free Software Foundation, either version 3 of the License, or
+ *   (at your option) any later version.
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "types.h"
+
+
+#define IPC_STATS_MAX_CMDS   (64)
+#define IPC_STATS_BUCKETS    (16) // Bucket n counts latencies below 2^n us. The last one everything above.
+#define IPC_STATS_DUMP_PATH  "sdmc:/3DS/ipcstats.txt"
+
+
+typedef struct
+{
+	u32 calls;
+	u32 maxUs;
+	u64 bytes;
+	u64 totalUs;
+	u32 hist[IPC_STATS_BUCKETS];
+} IpcCmdStats;
+
+
+
+/**
+ * @brief      Starts the cycle counter used for the latency measurements.
+ */
+void IPC_statsInit(void);
+
+/**
+ * @brief      Returns the current cycle counter value for IPC_statsRecord().
+ */
+u32 IPC_statsTimestamp(void);
+
+/**
+ * @brief      Accounts one finished IpcCmd9 round trip.
+ *
+ * @param[in]  cmd    The IPC command.
+ * @param[in]  bytes  The number of bytes moved by the command.
+ * @param[in]  start  IPC_statsTimestamp() from when the command was sent.
+ */
+void IPC_statsRecord(u32 cmd, u32 bytes, u32 start);
+
+/**
+ * @brief      Returns the statistics for a command ID or NULL if out of range.
+ */
+const IpcCmdStats* IPC_statsGet(u8 cmdId);
+
+/**
+ * @brief      Returns a printable name for a command ID.
+ */
+const char* IPC_statsCmdName(u8 cmdId);
+
+/**
+ * @brief      Clears all statistics.
+ */
+void IPC_statsReset(void);
+
+/**
+ * @brief      Writes all statistics including the histograms as text file.
+ *
+ * @param[in]  path  The file path.
+ *
+ * @return     Returns true on success.
+ */
+bool IPC_statsDump(const char *const path);
@@ -22,4 +22,17 @@
 
 
 
+// Trusted data only. Reads and writes past the buffers on corrupted input.
 void lz11Decompress(const void *in, void *out, u32 size);
+
+/**
+ * @brief      Decompresses LZ11 data without ever reading or writing out of bounds.
+ *
+ * @param[in]  in       The compressed data.
+ * @param[in]  inSize   The compressed data size.
+ * @param      out      The output buffer.
+ * @param[in]  outSize  The decompressed size.
+ *
+ * @return     Returns false if the data is corrupted.
+ */
+bool lz11DecompressBounded(const void *in, u32 inSize, void *out, u32 outSize);
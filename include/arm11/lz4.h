@@ -0,0 +1,38 @@
+#pragma once
+
+/*
+ *   This file is part of fastboot 3DS
+ *   Copyright (C) 2017 derrek, profi200
+ *
+ *   This program is free software: you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License as published by
+ *   the Free Software Foundation, either version 3 of the License, or
+ *   (at your option) any later version.
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "types.h"
+
+
+
+// Trusted data only. Reads and writes past the buffers on corrupted input.
+void lz4Decompress(const void *in, void *out, u32 size);
+
+/**
+ * @brief      Decompresses a raw LZ4 block without ever reading or writing out of bounds.
+ *
+ * @param[in]  in       The compressed block.
+ * @param[in]  inSize   The compressed block size. Data after the block is ignored.
+ * @param      out      The output buffer.
+ * @param[in]  outSize  The decompressed size.
+ *
+ * @return     Returns false if the data is corrupted.
+ */
+bool lz4DecompressBounded(const void *in, u32 inSize, void *out, u32 outSize);
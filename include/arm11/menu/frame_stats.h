@@ -0,0 +1,67 @@
+#pragma once
+
+/*
+ *   This file is part of fastboot 3DS
+ *   Copyright (C) 2017 derrek, profi200
+ *
+ *   This program is free software: you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License as published by
+ *   the Free Software Foundation, either version 3 of the License, or
+ *   (at your option) any later version.
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "types.h"
+#include "arm11/console.h"
+
+
+#define FRAME_STATS_WINDOW   (32u) // Frames the min/avg/max are taken over
+#define FRAME_STATS_REFRESH  (16u) // Overlay redraw interval in frames
+
+
+typedef enum
+{
+	FRAME_PHASE_DRAW     = 0u, // Rendering into the render buffers
+	FRAME_PHASE_TRANSFER = 1u, // Queuing the render buffer copy
+	FRAME_PHASE_WAIT     = 2u, // Waiting for VBlank
+	FRAME_PHASES         = 3u
+} FramePhase;
+
+
+
+/**
+ * @brief      Turns the frame time overlay on or off. Only has an effect in dev mode.
+ */
+void frameStatsToggle(void);
+
+/**
+ * @brief      Returns true if the frame time overlay is on.
+ */
+bool frameStatsEnabled(void);
+
+/**
+ * @brief      Starts measuring a new frame.
+ */
+void frameStatsBeginFrame(void);
+
+/**
+ * @brief      Accounts the cycles since the last mark to a phase of the current frame.
+ *
+ * @param[in]  phase  The phase that just ended.
+ */
+void frameStatsMark(FramePhase phase);
+
+/**
+ * @brief      Ends the current frame and draws the overlay on the last row of the console window.
+ *
+ * @param      con     The console to draw the overlay on.
+ * @param[in]  redraw  Draw the overlay even if the refresh interval didn't pass yet.
+ */
+void frameStatsEndFrame(PrintConsole *con, bool redraw);
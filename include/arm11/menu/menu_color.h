@@ -30,6 +30,7 @@
 #define ESC_INVERT			"\x1b[7m"
 #define ESC_FGCOLOR(x)		"\x1b[3" #x "m"
 #define ESC_BGCOLOR(x)		"\x1b[4" #x "m"
+#define ESC_CUR_UP			"\x1b[1A"
 
 // colors for color scheme
 #define ESC_SCHEME_STD		ESC_RESET ESC_FGCOLOR(7) ESC_BGCOLOR(0)
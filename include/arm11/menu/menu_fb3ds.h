@@ -64,10 +64,14 @@
 #define DESC_NAND_BACKUP	"Backup current NAND to a file."
 #define DESC_NAND_RESTORE	"Restore current NAND from a file.\nThis option preserves your fastboot3ds installation."
 #define DESC_NAND_RESTORE_F	"Restore current NAND from a file.\nWARNING: This will overwrite all of your flash memory, also overwriting fastboot3ds."
+#define DESC_PART_TOOLS		"Enter partition backup submenu. Partition backups only contain a single NAND partition and finish much faster than full NAND backups."
+#define DESC_PART_BACKUP(x)	"Backup the " x " partition to a file."
+#define DESC_PART_RESTORE	"Restore a single NAND partition from a file.\nThe backup must match the current NAND partition layout."
 #define DESC_FIRM_FLASH		"Flash firmware from file to firm1:.\nWARNING: This will allow you to flash unsigned firmware, overwriting anything previously installed in firm1:."
 
 #define DESC_UPDATE			"Update fastboot3ds. Only signed updates are allowed."
 #define DESC_CREDITS    	"Show fastboot3ds credits."
+#define DESC_IPC_STATS		"Show call counts, bytes moved and latencies of all ARM9 commands since boot. Statistics can be dumped to the SD card."
 
 // unused definitions below:
 #define LOREM "Lorem ipsum dolor sit amet, consetetur sadipscing elitr, sed diam nonumy eirmod tempor invidunt ut labore et dolore magna aliquyam erat, sed diam voluptua. At vero eos et accusam et justo duo dolores et ea rebum. Stet clita kasd gubergren, no sea takimata"
@@ -125,19 +129,21 @@ MenuInfo menu_fb3ds[] =
 		}
 	},
 	{ // 4
-		"NAND Tools", 4, &menuPresetNandTools, 0,
+		"NAND Tools", 5, &menuPresetNandTools, 0,
 		{
 			{ "Backup NAND",				DESC_NAND_BACKUP,			&menuBackupNand,		0 },
 			{ "Restore NAND",				DESC_NAND_RESTORE,			&menuRestoreNand,		0 },
 			{ "Restore NAND (forced)",		DESC_NAND_RESTORE_F,		&menuRestoreNand,		1 },
-			{ "Flash firmware to FIRM1",	DESC_FIRM_FLASH,			&menuInstallFirm,		1 }
+			{ "Flash firmware to FIRM1",	DESC_FIRM_FLASH,			&menuInstallFirm,		1 },
+			{ "Partition backups...",		DESC_PART_TOOLS,			NULL,					12 }
 		}
 	},
 	{ // 5
-		"Miscellaneous", 2, NULL, 0,
+		"Miscellaneous", 3, &menuPresetMisc, 0,
 		{
 			{ "Update fastboot3DS",			DESC_UPDATE,				&menuUpdateFastboot3ds,	0 },
-			{ "Credits",					DESC_CREDITS,				&menuShowCredits,		0 }
+			{ "Credits",					DESC_CREDITS,				&menuShowCredits,		0 },
+			{ "IPC statistics",				DESC_IPC_STATS,				&menuShowIpcStats,		0 }
 		}
 	},
 	SUBMENU_SLOT_SETUP(1), // 6
@@ -146,7 +152,17 @@ MenuInfo menu_fb3ds[] =
 	SUBMENU_SLOT_SETUP(4), // 9
 	SUBMENU_SLOT_SETUP(5), // 10
 	SUBMENU_SLOT_SETUP(6), // 11
-	/*{ // 12
+	{ // 12
+		"Partition Backups", 5, NULL, 0,
+		{
+			{ "Backup FIRM0",				DESC_PART_BACKUP("FIRM0"),	&menuBackupNandPartition,	0 },
+			{ "Backup FIRM1",				DESC_PART_BACKUP("FIRM1"),	&menuBackupNandPartition,	1 },
+			{ "Backup CTRNAND",				DESC_PART_BACKUP("CTRNAND"),	&menuBackupNandPartition,	2 },
+			{ "Backup TWLN",				DESC_PART_BACKUP("TWLN"),	&menuBackupNandPartition,	3 },
+			{ "Restore partition",			DESC_PART_RESTORE,			&menuRestoreNandPartition,	0 }
+		}
+	},
+	/*{ // 13
 		"Debug", 2, NULL, 0, // this will not show in the release version
 		{
 			{ "View current settings",		LOREM,						&debugSettingsView,		0 },
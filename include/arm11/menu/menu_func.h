@@ -24,12 +24,15 @@
 
 
 #define NAND_BACKUP_PATH	"sdmc:/3DS" // NAND backups standard path
-#define DEVICE_BUFSIZE		(((REG_CFG11_SOCINFO & 2) ? 1024 : 512) * 1024) // 1024 / 512 KiB
+#define DEVICE_BUFSIZE		(((REG_CFG11_SOCINFO & 2) ? 1024 : 512) * 1024) // 1024 / 512 KiB, max for the autotuner
 #define PROGRESS_WIDTH		20
+#define NAND_JOURNAL_STEP	(16 * 1024 * 1024) // checkpoint every 16 MiB
+#define N_NAND_PART_TARGETS	4 // firm0, firm1, CTRNAND, TWLN
 
 
 
 u32 menuPresetNandTools(void);
+u32 menuPresetMisc(void);
 u32 menuPresetBootMenu(void);
 u32 menuPresetBootConfig(void);
 u32 menuPresetSlotConfig1(void);
@@ -50,9 +53,12 @@ u32 menuSetupBootKeys(PrintConsole* term_con, PrintConsole* menu_con, u32 param)
 u32 menuLaunchFirm(PrintConsole* term_con, PrintConsole* menu_con, u32 param);
 u32 menuBackupNand(PrintConsole* term_con, PrintConsole* menu_con, u32 param);
 u32 menuRestoreNand(PrintConsole* term_con, PrintConsole* menu_con, u32 param);
+u32 menuBackupNandPartition(PrintConsole* term_con, PrintConsole* menu_con, u32 param);
+u32 menuRestoreNandPartition(PrintConsole* term_con, PrintConsole* menu_con, u32 param);
 u32 menuInstallFirm(PrintConsole* term_con, PrintConsole* menu_con, u32 param);
 u32 menuUpdateFastboot3ds(PrintConsole* term_con, PrintConsole* menu_con, u32 param);
 u32 menuShowCredits(PrintConsole* term_con, PrintConsole* menu_con, u32 param);
+u32 menuShowIpcStats(PrintConsole* term_con, PrintConsole* menu_con, u32 param);
 
 // everything below has to go
 u32 menuDummyFunc(PrintConsole* term_con, PrintConsole* menu_con, u32 param);
@@ -20,7 +20,7 @@
 
 
 char* mallocpyString(const char* str);
-void truncateString(char* dest, const char* orig, int nsize, int tpos);
+void truncateString(char* dest, const char* orig, int nsize, int tpos); // dest: nsize * 4 + 1 bytes
 void formatBytes(char* str, u64 bytes);
 void keysToString(u32 keys, char* string);
 void stringWordWrap(char* str, int llen);
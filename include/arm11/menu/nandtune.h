@@ -0,0 +1,74 @@
+#pragma once
+
+/*
+ *   This file is part of fastboot 3DS
+ *   Copyright (C) 2017 derrek, profi200, d0k3
+ *
+ *   This program is free software: you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License as published by
+ *   the Free Software Foundation, either version 3 of the License, or
+ *   (at your option) any later version.
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "types.h"
+
+
+#define NAND_TUNE_PATH			"sdmc:/3DS/nandtune.bin" // tuning results per SD card
+#define NAND_TUNE_TRIAL_SIZE	(4 * 1024 * 1024) // bytes transferred per tried chunk size
+#define NAND_TUNE_MAX_CARDS		8
+
+/**
+ * @brief Device buffer autotuner state, used by the NAND backup / restore functions.
+ */
+typedef struct {
+	s32 dbufHandle;			///< Device buffer handle.
+	u32 bufSize;			///< Size of the device buffer, upper bound for chunks.
+	u32 chunkSize;			///< Chunk size to use for the next transfer.
+	bool tuning;			///< True while still trying chunk sizes.
+	u32 trial;				///< Index of the chunk size currently tried.
+	u32 trialBytes;			///< Bytes transferred with the current chunk size.
+	u32 trialTicks;			///< Timer ticks spent on the current chunk size.
+	u32 bestRate;			///< Best rate seen so far in KiB/s.
+	u32 bestChunkSize;		///< Chunk size that achieved bestRate.
+	bool haveCid;			///< True if the SD card CID could be read.
+	u32 cid[4];				///< SD card CID, key for the stored results.
+} NandTuner;
+
+/**
+ * @brief Timing of one transfer stage, used by NandStats.
+ */
+typedef struct {
+	u32 minRate;			///< Slowest chunk in KiB/s.
+	u32 maxRate;			///< Fastest chunk in KiB/s.
+	u64 bytes;				///< Bytes processed by this stage.
+	u64 ticks;				///< Timer ticks spent in this stage.
+} NandStageStats;
+
+/**
+ * @brief Throughput statistics of a NAND backup / restore.
+ */
+typedef struct {
+	NandStageStats read;	///< Filling the device buffer (NAND or SD read incl. IPC).
+	NandStageStats write;	///< Draining the device buffer (SD or NAND write incl. IPC).
+	NandStageStats total;	///< Whole chunk incl. progress display.
+	u32 rate;				///< Smoothed overall rate in KiB/s.
+	u32 chunks;				///< Number of chunks transferred.
+} NandStats;
+
+s32 nandTuneInit(NandTuner* tune);
+void nandTuneChunkStart(void);
+u32 nandTuneTicks(void);
+void nandTuneChunkEnd(NandTuner* tune, u32 bytes, u32 ticks);
+
+void nandStatsInit(NandStats* stats);
+void nandStatsUpdate(NandStats* stats, u32 bytes, u32 readTicks, u32 writeTicks, u32 totalTicks);
+void nandStatsFormat(const NandStats* stats, u32 remaining, char* str, u32 len);
+bool nandStatsWriteLog(const NandStats* stats, const char* path, const char* desc);
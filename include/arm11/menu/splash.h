@@ -24,6 +24,8 @@
 #define FLAG_ROTATED     (1u<<3)
 #define FLAG_COMPRESSED  (1u<<4)
 #define FLAG_SWAPPED     (1u<<5)
+#define FLAG_ANIMATED    (1u<<6)
+#define FLAG_LZ4         (1u<<7) // Compressed data is a raw LZ4 block instead of LZ11
 
 
 enum
@@ -42,7 +44,33 @@ typedef struct
 	u32 flags;
 } SplashHeader;
 
+// Animated splashes (FLAG_ANIMATED) must be compressed and are followed
+// by a SplashAnimHeader instead of the image data. Every frame is compressed
+// separately and covers the full image height. Frame 0 is a key frame
+// covering the full width. Later frames may only contain the changed columns
+// [x, x + width) and are drawn on top of the previous frame.
+typedef struct
+{
+	u32 offset;   // Frame data offset from the start of the splash
+	u16 x;        // First column
+	u16 width;    // Number of columns
+	u16 duration; // In VBlanks
+	u16 reserved;
+} SplashFrame;
+
+typedef struct
+{
+	u16 numFrames;
+	u16 loops;    // Number of times the animation is played. 0 = forever
+	SplashFrame frames[];
+} SplashAnimHeader;
+
 
 
 void getSplashDimensions(const void *const data, u32 *const width, u32 *const height);
-bool drawSplashscreen(const void *const data, s32 startX, s32 startY);
+// trusted selects the faster decoders without bounds checks.
+// Only pass true for the built-in splash.
+bool drawSplashscreen(const void *const data, u32 size, bool trusted, s32 startX, s32 startY);
+bool isSplashAnimating(void);
+void updateSplashscreen(void);
+void endSplashscreen(void);
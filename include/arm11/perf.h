@@ -0,0 +1,60 @@
+#pragma once
+
+/*
+ *   This file is part of fastboot 3DS
+ *   Copyright (C) 2017 derrek, profi200
+ *
+ *   This program is free software: you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License as published by
+ *   the Free Software Foundation, either version 3 of the License, or
+ *   (at your option) any later version.
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "types.h"
+
+
+#define PERF_LOG_DUMP_PATH  "sdmc:/3DS/perflog.txt"
+
+
+
+/**
+ * @brief      Drops the New 3DS CPU clock to the idle setting. Call once on core 0 after init.
+ */
+void perfInit(void);
+
+/**
+ * @brief      Raises the CPU clock for a heavy operation. Calls nest. Only call from core 0.
+ *
+ * @param[in]  reason  Short description for the transition log (debug builds).
+ */
+void perfBoostBegin(const char *const reason);
+
+/**
+ * @brief      Ends a perfBoostBegin(). The clock drops back to idle after the outermost one.
+ */
+void perfBoostEnd(void);
+
+/**
+ * @brief      Returns the current CPU clock as multiple of the 268 MHz base clock.
+ *             The cycle counter runs at this rate.
+ */
+u32 perfGetClockMul(void);
+
+#ifndef NDEBUG
+/**
+ * @brief      Writes the last clock transitions to a text file.
+ *
+ * @param[in]  path  The file path.
+ *
+ * @return     Returns true on success.
+ */
+bool perfDumpLog(const char *const path);
+#endif
@@ -0,0 +1,230 @@
+#pragma once
+
+/*
+ *   This file is part of fastboot 3DS
+ *   Copyright (C) 2017 derrek, profi200
+ *
+ *   This program is free software: you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License as published by
+ *   the Free Software Foundation, either version 3 of the License, or
+ *   (at your option) any later version.
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/*
+ * Bounded lock-free queues of u32 values (pointers, event codes...).
+ * SPSC: exactly one producer and one consumer, for example an IRQ handler
+ * and the main loop or core 0 and one worker core.
+ * MPMC: any number of producers and consumers on any core, for example
+ * the SMP job queue shared by core 0 and all worker cores.
+ * Sizes must be a power of 2. The indices live on their own cache lines
+ * so producer and consumer cores don't fight over them.
+ *
+ * Without ARM11 defined the barriers map to compiler builtins so the
+ * queues can be built and tested on a host (tools/ipcsim).
+ */
+
+#include "types.h"
+#ifdef ARM11
+#include "arm.h"
+#endif
+
+
+#define QUEUE_CACHE_LINE  (32)
+
+#ifdef ARM11
+#define queueDmb()   __dmb()
+#define queueWait()  __wfe()
+// Make the new index visible before waking sleeping cores
+#define queueWake()  do { __dsb(); __sev(); } while(0)
+#else
+#define queueDmb()   __atomic_thread_fence(__ATOMIC_SEQ_CST)
+#define queueWait()  ((void)0)
+#define queueWake()  ((void)0)
+#endif
+
+
+typedef struct
+{
+	vu32 head;                 // Written by the producer only
+	u8 pad0[QUEUE_CACHE_LINE - 4];
+	vu32 tail;                 // Written by the consumer only
+	u8 pad1[QUEUE_CACHE_LINE - 4];
+	u32 mask;
+	u32 *buf;
+} __attribute__((aligned(QUEUE_CACHE_LINE))) SpscQueue;
+
+typedef struct
+{
+	vu32 seq;
+	u32 val;
+} MpmcCell;
+
+typedef struct
+{
+	vu32 head;
+	u8 pad0[QUEUE_CACHE_LINE - 4];
+	vu32 tail;
+	u8 pad1[QUEUE_CACHE_LINE - 4];
+	u32 mask;
+	MpmcCell *cells;
+} __attribute__((aligned(QUEUE_CACHE_LINE))) MpmcQueue;
+
+
+
+// Returns true and stores desired if *ptr == expected
+static inline bool queueCas(vu32 *ptr, u32 expected, u32 desired)
+{
+#ifdef ARM11
+	u32 tmp, fail;
+	__asm__ volatile("1: ldrex %0, [%2]\n"
+	                 "   mov %1, #1\n"
+	                 "   teq %0, %3\n"
+	                 "   bne 2f\n"
+	                 "   strex %1, %4, [%2]\n"
+	                 "   teq %1, #0\n"
+	                 "   bne 1b\n"
+	                 "2: clrex"
+	                 : "=&r" (tmp), "=&r" (fail) : "r" (ptr), "r" (expected), "r" (desired) : "cc", "memory");
+	return !fail;
+#else
+	return __atomic_compare_exchange_n(ptr, &expected, desired, false, __ATOMIC_SEQ_CST, __ATOMIC_SEQ_CST);
+#endif
+}
+
+
+/**
+ * @brief      Initializes a SPSC queue.
+ *
+ * @param      q     The queue.
+ * @param      buf   The storage for size values.
+ * @param[in]  size  The number of values. Must be a power of 2.
+ */
+static inline void spscQueueInit(SpscQueue *q, u32 *buf, u32 size)
+{
+	q->head = 0;
+	q->tail = 0;
+	q->mask = size - 1;
+	q->buf = buf;
+}
+
+// Returns false if full. Wakes a consumer waiting in spscQueuePopWait().
+static inline bool spscQueuePush(SpscQueue *q, u32 val)
+{
+	const u32 head = q->head;
+	if(head - q->tail > q->mask) return false;
+
+	q->buf[head & q->mask] = val;
+	queueDmb(); // Value before index
+	q->head = head + 1;
+	queueWake();
+
+	return true;
+}
+
+// Returns false if empty
+static inline bool spscQueuePop(SpscQueue *q, u32 *val)
+{
+	const u32 tail = q->tail;
+	if(tail == q->head) return false;
+
+	queueDmb(); // Index before value
+	*val = q->buf[tail & q->mask];
+	queueDmb(); // Value read before the slot is handed back
+	q->tail = tail + 1;
+
+	return true;
+}
+
+static inline u32 spscQueuePopWait(SpscQueue *q)
+{
+	u32 val;
+	while(!spscQueuePop(q, &val)) queueWait();
+	return val;
+}
+
+
+/**
+ * @brief      Initializes a MPMC queue.
+ *
+ * @param      q      The queue.
+ * @param      cells  The storage for size values.
+ * @param[in]  size   The number of values. Must be a power of 2.
+ */
+static inline void mpmcQueueInit(MpmcQueue *q, MpmcCell *cells, u32 size)
+{
+	for(u32 i = 0; i < size; i++) cells[i].seq = i;
+	q->head = 0;
+	q->tail = 0;
+	q->mask = size - 1;
+	q->cells = cells;
+	queueDmb();
+}
+
+// Returns false if full. Wakes consumers waiting in mpmcQueuePopWait().
+static inline bool mpmcQueuePush(MpmcQueue *q, u32 val)
+{
+	MpmcCell *cell;
+	u32 pos = q->head;
+	while(1)
+	{
+		cell = &q->cells[pos & q->mask];
+		const s32 diff = (s32)(cell->seq - pos);
+		if(diff == 0)
+		{
+			// Cell is free. Claim it.
+			if(queueCas(&q->head, pos, pos + 1)) break;
+			pos = q->head;
+		}
+		else if(diff < 0) return false;
+		else pos = q->head; // Another producer was faster
+	}
+
+	queueDmb(); // Claim before value
+	cell->val = val;
+	queueDmb(); // Value before sequence
+	cell->seq = pos + 1;
+	queueWake();
+
+	return true;
+}
+
+// Returns false if empty or if the oldest value is still being written
+static inline bool mpmcQueuePop(MpmcQueue *q, u32 *val)
+{
+	MpmcCell *cell;
+	u32 pos = q->tail;
+	while(1)
+	{
+		cell = &q->cells[pos & q->mask];
+		const s32 diff = (s32)(cell->seq - (pos + 1));
+		if(diff == 0)
+		{
+			if(queueCas(&q->tail, pos, pos + 1)) break;
+			pos = q->tail;
+		}
+		else if(diff < 0) return false;
+		else pos = q->tail; // Another consumer was faster
+	}
+
+	queueDmb(); // Sequence before value
+	*val = cell->val;
+	queueDmb(); // Value read before the cell is handed back
+	cell->seq = pos + q->mask + 1;
+
+	return true;
+}
+
+static inline u32 mpmcQueuePopWait(MpmcQueue *q)
+{
+	u32 val;
+	while(!mpmcQueuePop(q, &val)) queueWait();
+	return val;
+}
@@ -0,0 +1,58 @@
+#pragma once
+
+/*
+ *   This file is part of fastboot 3DS
+ *   Copyright (C) 2017 derrek, profi200
+ *
+ *   This program is free software: you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License as published by
+ *   the Free Software Foundation, either version 3 of the License, or
+ *   (at your option) any later version.
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "types.h"
+
+
+// Processes the items [start, end) of a parallel for.
+// Runs on cores 1-3 with small stacks (512 bytes on core 2/3).
+// No printing, malloc or IPC from jobs.
+typedef void (*SmpJobFunc)(void *arg, u32 start, u32 end);
+
+
+
+/**
+ * @brief      Worker loop for cores 1-3. Runs jobs queued by core 0 until SMP_deinit().
+ *             Parks the core in boot11 afterwards.
+ */
+noreturn void SMP_workerLoop(void);
+
+/**
+ * @brief      Sends all workers back to boot11. Call on core 0 before launching firms.
+ */
+void SMP_deinit(void);
+
+/**
+ * @brief      Returns the number of cores available for SMP_parallelFor() including core 0.
+ *             1 if no worker is running.
+ */
+u32 SMP_getNumCores(void);
+
+/**
+ * @brief      Splits [0, count) between core 0 and all running workers and waits for completion.
+ *             Falls back to running everything on the calling core if no worker is
+ *             available or if not called from core 0.
+ *
+ * @param[in]  count     The number of items.
+ * @param[in]  minChunk  Don't split into chunks smaller than this.
+ * @param[in]  func      The job function.
+ * @param      arg       Argument passed to func.
+ */
+void SMP_parallelFor(u32 count, u32 minChunk, SmpJobFunc func, void *arg);
@@ -242,6 +242,23 @@ void SHA_update(const u32 *data, u32 size);
  */
 void SHA_finish(u32 *const hash, u8 endianess);
 
+/**
+ * @brief      Saves the state of an unfinished hash operation.
+ *             Only valid after updates with a multiple of 64 bytes.
+ *
+ * @param      state  Pointer to 9 words. Intermediate hash and block count.
+ */
+void SHA_getState(u32 state[9]);
+
+/**
+ * @brief      Continues a hash operation saved with SHA_getState().
+ *             Replaces SHA_start() for the resumed operation.
+ *
+ * @param[in]  params  Mode and input endianess bitmask.
+ * @param[in]  state   The saved state.
+ */
+void SHA_setState(u8 params, const u32 state[9]);
+
 /**
  * @brief      Hashes a single block of data and outputs the hash.
  *
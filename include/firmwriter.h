@@ -34,5 +34,14 @@ enum
 
 
 
+#ifdef ARM11
+/**
+ * @brief      Queues writing the loaded firm without waiting for it.
+ *             The partition name must stay valid until the command completed.
+ *
+ * @return     A ticket for PXI_pollCmd(), PXI_waitCmd() and PXI_getProgress().
+ */
+u32 writeFirmPartitionAsync(const char *const part, bool replaceSig);
+#endif
 s32 writeFirmPartition(const char *const part, bool replaceSig);
 s32 loadVerifyUpdate(const char *const path, u32 *const version);
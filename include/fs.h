@@ -55,7 +55,77 @@ typedef enum
 	FS_OPEN_APPEND        = FA_OPEN_APPEND
 } FsOpenMode;
 
-typedef FILINFO FsFileInfo;
+// FatFs file info with the name converted to UTF-8. Names which don't
+// fit as UTF-8 are replaced by their short name.
+typedef struct
+{
+	FSIZE_t fsize;
+	WORD    fdate;
+	WORD    ftime;
+	BYTE    fattrib;
+	char    fname[FF_MAX_LFN + 1];
+} FsFileInfo;
+
+// Saved state of a running device buffer hash
+typedef struct
+{
+	u32 state[9];
+} FsHashState;
+
+// NCSD partition FS types (FsNandPartition.type)
+#define NAND_PART_TYPE_NORMAL  (1u)
+#define NAND_PART_TYPE_FIRM    (3u)
+
+typedef struct
+{
+	char name[12];
+	u32 sector;
+	u32 count;
+	u8  type;
+	u8  ncsdIndex;
+	u8  padding[2];
+} FsNandPartition;
+
+// Header in front of single NAND partition images. The raw
+// partition data follows at headerSize.
+#define NAND_PART_IMAGE_MAGIC  (0x49504246u) // "FBPI"
+
+typedef struct
+{
+	u32 magic;
+	u32 headerSize;
+	FsNandPartition part;
+	u8  reserved[0x200 - 8 - sizeof(FsNandPartition)];
+} NandPartImageHeader;
+
+// Operations for fBatch(). Ops taking a handle use arg as handle.
+typedef enum
+{
+	FS_BATCH_MOUNT     = 0, // arg = drive
+	FS_BATCH_STAT      = 1, // path, out = FsFileInfo (may be NULL)
+	FS_BATCH_OPEN      = 2, // path, arg = mode, result = handle
+	FS_BATCH_READ      = 3, // arg = handle, out = data
+	FS_BATCH_CLOSE     = 4, // arg = handle
+	FS_BATCH_OPEN_DIR  = 5, // path, result = handle
+	FS_BATCH_READ_DIR  = 6, // arg = handle, out = FsFileInfo array, result = entries read
+	FS_BATCH_CLOSE_DIR = 7, // arg = handle
+	FS_BATCH_READ_FILE = 8  // path, out = data, result = file size
+} FsBatchOpType;
+
+// Use the result of the previous op (usually a handle) as arg
+#define FS_BATCH_PREV_RESULT  (0xFFFFFFFFu)
+#define FS_BATCH_MAX_OPS      (16)
+
+typedef struct
+{
+	u32 type;
+	const char *path;
+	u32 pathSize;       // Including the terminator
+	void *out;
+	u32 outSize;
+	u32 arg;
+	s32 result;
+} FsBatchOp;
 
 typedef s32 DevHandle;
 typedef s32 DevBufHandle;
@@ -67,12 +137,17 @@ bool fIsDriveMounted(FsDrive drive);
 s32  fGetFree(FsDrive drive, u64 *size);
 u32  fGetDeviceSize(FsDevice dev);
 bool fIsDevActive(FsDevice dev);
+s32  fGetDeviceCid(FsDevice dev, u32 cid[4]);
 s32  fPrepareRawAccess(FsDevice dev);
 s32  fFinalizeRawAccess(DevHandle handle);
 s32  fCreateDeviceBuffer(u32 size);
 s32  fFreeDeviceBuffer(DevBufHandle handle);
 s32  fReadToDeviceBuffer(s32 sourceHandle, u32 sourceOffset, u32 sourceSize, DevBufHandle devBufHandle);
 s32  fsWriteFromDeviceBuffer(s32 destHandle, u32 destOffset, u32 destSize, DevBufHandle devBufHandle);
+s32  fStartDeviceBufferHash(DevBufHandle devBufHandle);
+s32  fGetDeviceBufferHash(DevBufHandle devBufHandle, u32 hash[8]);
+s32  fSaveDeviceBufferHash(DevBufHandle devBufHandle, FsHashState *state);
+s32  fResumeDeviceBufferHash(DevBufHandle devBufHandle, const FsHashState *state);
 s32  fOpen(const char *const path, FsOpenMode mode);
 s32  fRead(s32 handle, void *const buf, u32 size);
 s32  fWrite(s32 handle, const void *const buf, u32 size);
@@ -90,7 +165,10 @@ s32  fMkdir(const char *const path);
 s32  fRename(const char *const old, const char *const new);
 s32  fUnlink(const char *const path);
 s32  fVerifyNandImage(const char *const path);
+s32  fGetNandPartition(const char *const name, FsNandPartition *part);
+s32  fVerifyNandPartImage(const char *const path);
 s32  fSetNandProtection(bool protect);
+s32  fBatch(FsBatchOp *ops, u32 num);
 
 #ifdef ARM9
 void fsDeinit(void);
@@ -19,13 +19,18 @@
  */
 
 #include "types.h"
+#include "fs.h"
 
 
 
 bool fsEnsureMounted(const char *path);
+u32 fsEnsureMountedPaths(const char *const *paths, u32 num);
 void fsUnmountAll();
 u32 fsMountNandFilesystems();
 void fsUnmountNandFilesystems();
 bool fsMountSdmc();
 bool fsCreateFileWithPath(const char *filepath);
 bool fsQuickRead(const char* filepath, void* buff, u32 len, u32 off);
+bool fsQuickWrite(const char* filepath, const void* buff, u32 len);
+s32 fsStatPaths(const char *const *paths, FsFileInfo *fi, s32 *results, u32 num);
+s32 fsReadSmallFile(const char* filepath, void* buff, u32 maxLen);
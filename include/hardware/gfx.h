@@ -65,6 +65,9 @@ void GX_textureCopy(u64 *in, u32 indim, u64 *out, u32 outdim, u32 size);
 void GFX_setBrightness(u32 top, u32 sub);
 void* GFX_getFramebuffer(u8 screen);
 void GFX_swapFramebufs(void);
+void GFX_markDirty(u8 screen, u32 x, u32 width);
+void GFX_queuePresent(void);
+void GFX_waitForPresent(void);
 void GFX_waitForEvent(GfxEvent event, bool discard);
 void GFX_init(bool clearScreens);
 void GFX_enterLowPowerState(void);
@@ -20,6 +20,8 @@
 
 #include "mem_map.h"
 #include "types.h"
+#include "ipc_handler.h"
+#include "hardware/pxi_ring.h"
 
 
 #ifdef ARM9
@@ -57,6 +59,72 @@
 #define PXI_ENABLE_SEND_RECV_FIFO    (1u<<15)
 
 
+// Sync IRQ data value used as doorbell for the request ring
+// instead of the number of words in the FIFO.
+#define PXI_RING_DOORBELL            (0xFFu)
+
+
+// IPC buffers in the ring are uncached and need no cache maintenance
+static inline bool PXI_isRingBuffer(const void *const ptr)
+{
+	return ((u32)ptr - PXI_RING_BASE) < PXI_RING_SIZE;
+}
+
+
 
 void PXI_init(void);
 u32 PXI_sendCmd(u32 cmd, const u32 *const buf, u32 words);
+
+#ifdef ARM9
+/**
+ * @brief      Reports the progress of the request currently being handled.
+ *
+ * @param[in]  done   Units done so far.
+ * @param[in]  total  Total units.
+ */
+void PXI_setProgress(u32 done, u32 total);
+#endif
+
+#ifdef ARM11
+/**
+ * @brief      Queues a command in the request ring without waiting for the result.
+ *             Blocks only if all ring slots are in use.
+ *
+ * @param[in]  cmd    The IPC command.
+ * @param[in]  buf    The command buffer.
+ * @param[in]  words  The number of words in buf.
+ *
+ * @return     Ticket for PXI_pollCmd() and PXI_waitCmd().
+ */
+u32 PXI_submitCmd(u32 cmd, const u32 *const buf, u32 words);
+
+/**
+ * @brief      Checks if a queued command has been processed by the ARM9.
+ *             Every ticket must be collected once with this or PXI_waitCmd()
+ *             before PXI_RING_SLOTS newer commands are submitted.
+ *
+ * @param[in]  ticket  The ticket returned by PXI_submitCmd().
+ * @param      result  The command result is written here once done.
+ *
+ * @return     Returns true if the command is done.
+ */
+bool PXI_pollCmd(u32 ticket, u32 *const result);
+
+/**
+ * @brief      Sleeps until a queued command has been processed by the ARM9.
+ *
+ * @param[in]  ticket  The ticket returned by PXI_submitCmd().
+ *
+ * @return     The command result.
+ */
+u32 PXI_waitCmd(u32 ticket);
+
+/**
+ * @brief      Gets the progress reported by the ARM9 for a queued command.
+ *
+ * @param[in]  ticket  The ticket returned by PXI_submitCmd().
+ * @param      done    Units done so far.
+ * @param      total   Total units. 0 if the command didn't report progress yet.
+ */
+void PXI_getProgress(u32 ticket, u32 *const done, u32 *const total);
+#endif
@@ -0,0 +1,113 @@
+#pragma once
+
+/*
+ *   This file is part of fastboot 3DS
+ *   Copyright (C) 2017 derrek, profi200
+ *
+ *   This program is free software: you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License as published by
+ *   the Free Software Foundation, either version 3 of the License, or
+ *   (at your option) any later version.
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/*
+ * Request ring between ARM11 (producer) and ARM9 (consumer). Only the
+ * index protocol lives here so it can be built on a host (tools/ipcsim).
+ * Both indices count up forever and a request is done when its ticket
+ * is below tail.
+ */
+
+#include "types.h"
+#include "ipc_handler.h"
+#ifdef ARM11
+#include "arm.h"
+#endif
+
+
+#define PXI_RING_SLOTS               (8u)
+// Small buffers are copied into the slot instead of doing cache maintenance
+#define PXI_RING_SLOT_DATA           (432u)
+
+#ifdef ARM11
+#define pxiRingDmb()  __dmb()
+#elif ARM9
+// The ring is uncached and the ARM946 doesn't reorder accesses to it
+#define pxiRingDmb()  __asm__ volatile("" : : : "memory")
+#else
+#define pxiRingDmb()  __atomic_thread_fence(__ATOMIC_SEQ_CST)
+#endif
+
+
+typedef struct
+{
+	u32 cmd;
+	u32 words;
+	u32 result;
+	u32 buf[IPC_MAX_PARAMS];
+	u32 data[PXI_RING_SLOT_DATA / 4]; // Bounce buffers for small IPC buffers
+} PxiRingSlot;
+
+typedef struct
+{
+	vu32 head;                       // Requests submitted. Written by ARM11 only.
+	vu32 tail;                       // Requests completed. Written by ARM9 only.
+	vu32 progressTicket;             // Request the progress below belongs to. Written by ARM9 only.
+	vu32 progressDone;               // Progress of long running requests. Written by ARM9 only.
+	vu32 progressTotal;
+	u32 padding[3];
+	PxiRingSlot slots[PXI_RING_SLOTS];
+} PxiRing;
+
+
+
+static inline PxiRingSlot* pxiRingSlot(PxiRing *ring, u32 ticket)
+{
+	return &ring->slots[ticket % PXI_RING_SLOTS];
+}
+
+// True if the request with this ticket has been processed
+static inline bool pxiRingDone(const PxiRing *ring, u32 ticket)
+{
+	if((s32)(ring->tail - ticket) <= 0) return false;
+	pxiRingDmb(); // Tail before result
+
+	return true;
+}
+
+// Producer: True if the next request would overwrite an unfinished one
+static inline bool pxiRingFull(const PxiRing *ring)
+{
+	return ring->head - ring->tail >= PXI_RING_SLOTS;
+}
+
+// Producer: Makes the slot of ticket visible to the consumer
+static inline void pxiRingPublish(PxiRing *ring, u32 ticket)
+{
+	pxiRingDmb(); // Slot before head
+	ring->head = ticket + 1;
+}
+
+// Consumer: Returns the oldest unprocessed request or NULL
+static inline PxiRingSlot* pxiRingPeek(PxiRing *ring)
+{
+	const u32 tail = ring->tail;
+	if(tail == ring->head) return NULL;
+	pxiRingDmb(); // Head before slot
+
+	return pxiRingSlot(ring, tail);
+}
+
+// Consumer: Hands the result of the oldest request back to the producer
+static inline void pxiRingComplete(PxiRing *ring)
+{
+	pxiRingDmb(); // Result before tail
+	ring->tail = ring->tail + 1;
+}
@@ -72,7 +72,15 @@ typedef enum
 	IPC_CMD9_GET_BOOT_ENV        = CMD_ID(34) | CMD_IN_BUFS(0)  | CMD_OUT_BUFS(0)  | CMD_PARAMS(0),
 	IPC_CMD9_PREPARE_POWER       = CMD_ID(35) | CMD_IN_BUFS(0)  | CMD_OUT_BUFS(0)  | CMD_PARAMS(0),
 	IPC_CMD9_PANIC               = CMD_ID(36) | CMD_IN_BUFS(0)  | CMD_OUT_BUFS(0)  | CMD_PARAMS(0),
-	IPC_CMD9_EXCEPTION           = CMD_ID(37) | CMD_IN_BUFS(0)  | CMD_OUT_BUFS(0)  | CMD_PARAMS(0)
+	IPC_CMD9_EXCEPTION           = CMD_ID(37) | CMD_IN_BUFS(0)  | CMD_OUT_BUFS(0)  | CMD_PARAMS(0),
+	IPC_CMD9_FSTART_DEV_BUF_HASH = CMD_ID(38) | CMD_IN_BUFS(0)  | CMD_OUT_BUFS(0)  | CMD_PARAMS(1),
+	IPC_CMD9_FGET_DEV_BUF_HASH   = CMD_ID(39) | CMD_IN_BUFS(0)  | CMD_OUT_BUFS(1)  | CMD_PARAMS(1),
+	IPC_CMD9_FGET_NAND_PART      = CMD_ID(40) | CMD_IN_BUFS(1)  | CMD_OUT_BUFS(1)  | CMD_PARAMS(0),
+	IPC_CMD9_FVERIFY_NAND_PART   = CMD_ID(41) | CMD_IN_BUFS(1)  | CMD_OUT_BUFS(0)  | CMD_PARAMS(0),
+	IPC_CMD9_FSAVE_DEV_BUF_HASH  = CMD_ID(42) | CMD_IN_BUFS(0)  | CMD_OUT_BUFS(1)  | CMD_PARAMS(1),
+	IPC_CMD9_FRESUME_DEV_BUF_HASH= CMD_ID(43) | CMD_IN_BUFS(1)  | CMD_OUT_BUFS(0)  | CMD_PARAMS(1),
+	IPC_CMD9_FGET_DEV_CID        = CMD_ID(44) | CMD_IN_BUFS(0)  | CMD_OUT_BUFS(1)  | CMD_PARAMS(1),
+	IPC_CMD9_FBATCH              = CMD_ID(45) | CMD_IN_BUFS(1)  | CMD_OUT_BUFS(1)  | CMD_PARAMS(0)
 } IpcCmd9;
 
 typedef enum
@@ -109,6 +109,10 @@
 
 
 /* Custom mappings */
+// PXI request ring shared by ARM9 and ARM11. Mapped uncached on both CPUs.
+#define PXI_RING_BASE        (AXIWRAM_BASE + AXIWRAM_SIZE - 0x2000)
+#define PXI_RING_SIZE        (0x1000)
+
 #ifdef ARM9
 #define A9_VECTORS_START     (A9_RAM_BASE)
 #define A9_VECTORS_SIZE      (0x40)
@@ -143,5 +147,8 @@
 #define A11_FALLBACK_ENTRY   (AXIWRAM_BASE + AXIWRAM_SIZE - 0x4)
 #define A11_STUB_ENTRY       (AXIWRAM_BASE + AXIWRAM_SIZE - 0x200)
 #define	A11_STUB_SIZE        (0x1A0) // Don't overwrite the vectors
-#define A11_HEAP_END         (AXIWRAM_BASE + AXIWRAM_SIZE)
+#define A11_HEAP_END         (PXI_RING_BASE)
+// One word per core at the end of the uncached ring page. Written by
+// cores leaving SMP_workerLoop() with their MMU and caches already off.
+#define A11_SMP_OFFLINE_BASE (PXI_RING_BASE + PXI_RING_SIZE - 0x10)
 #endif
@@ -125,8 +125,7 @@ static const FunctionsEntryType *getKeyFunction(int key)
 /* This loads the config file from SD card or eMMC and parses it */
 bool loadConfigFile()
 {
-	FILINFO fileStat;
-	s32 file;
+	FsFileInfo fileStat;
 	u32 fileSize;
 	bool SdPresent;
 	bool adpotChanges = false;
@@ -144,12 +143,20 @@ bool loadConfigFile()
 	
 	if(SdPresent)
 	{
+		const char *const paths[2] = { SdmcFilepath, NandFilepath };
+		FsFileInfo stats[2];
+		s32 results[2];
+		
 		filepath = SdmcFilepath;
-	
+		
+		// check both locations in one go
+		if(fsStatPaths(paths, stats, results, 2) < 0)
+			return false;
+		
 		// does the config file not exist yet?
-		if(fStat(SdmcFilepath, &fileStat) != FR_OK)
+		if(results[0] != FR_OK)
 		{
-			if(fStat(NandFilepath, &fileStat) == FR_OK)
+			if(results[1] == FR_OK)
 			{
 				/*	no config on SD, but there is one on the NAND,
 					so just load it and save it later on.	*/
@@ -157,7 +164,8 @@ bool loadConfigFile()
 			}
 			
 			createFile = true;
-		}	
+		}
+		else fileStat = stats[0];
 	}
 	else	/* use NAND */
 	{
@@ -204,20 +212,11 @@ bool loadConfigFile()
 	
 	if(fileSize)
 	{
-		if((file = fOpen(filepath, FS_OPEN_READ)) < 0)
+		if(fsReadSmallFile(filepath, filebuf, MAX_FILE_SIZE) != (s32)fileSize)
 		{
-			//ee_printf("Failed to open config-file for reading!\n");
+			//ee_printf("Failed to read config-file!\n");
 			goto fail;
 		}
-		
-		if(fRead(file, filebuf, fileSize) != FR_OK)
-		{
-			//ee_printf("Failed to read from config-file!\n");
-			fClose(file);
-			goto fail;
-		}
-		
-		fClose(file);
 	}
 	
 	// terminate string buf
@@ -624,6 +623,29 @@ static bool removeDefinition(AttributeEntryType *attr)
 	return true;
 }
 
+// returns the length of the UTF-8 sequence at str or 0 if it is invalid
+static u32 utf8SequenceLength(const char *str)
+{
+	const u8 c = *str;
+	u32 len;
+	
+	if(c >= 0xC2 && c <= 0xDF) len = 2;
+	else if((c & 0xF0) == 0xE0) len = 3;
+	else if(c >= 0xF0 && c <= 0xF4) len = 4;
+	else return 0;
+	
+	for(u32 i = 1; i < len; i++)
+		if((str[i] & 0xC0) != 0x80)
+			return 0;
+	
+	// overlong and beyond U+10FFFF
+	if((c == 0xE0 && (u8)str[1] < 0xA0) || (c == 0xF0 && (u8)str[1] < 0x90) ||
+	   (c == 0xF4 && (u8)str[1] > 0x8F))
+		return 0;
+	
+	return len;
+}
+
 static bool isValidPath(const char *path)
 {
 	char c;
@@ -647,9 +669,14 @@ static bool isValidPath(const char *path)
 		if((c == '\\' || c == '/') && path[1] == ' ')
 			return false;
 			
-		// no non ASCII chars
-		if(!((unsigned char)c <= 127))
-			return false;
+		// paths are UTF-8 like the file names from fReadDir()
+		if((unsigned char)c > 127)
+		{
+			const u32 len = utf8SequenceLength(path);
+			if(!len)
+				return false;
+			path += len - 1;
+		}
 	}
 	
 	if(!gotMountpoint)
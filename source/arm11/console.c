@@ -7,10 +7,13 @@
 #include "types.h"
 #include "arm11/fmt.h"
 #include "hardware/gfx.h"
+#include "hardware/cache.h"
 #include "util.h"
 #include "arm11/console.h"
+#include "arm11/smp.h"
 
 #include "arm11/font_6x10.h"
+#include "arm11/font_unicode.h"
 
 //set up the palette for color printing
 static u16 colorTable[] = {
@@ -64,9 +67,31 @@ PrintConsole defaultConsole =
 	0,		// background color
 	0,		// flags
 	0,		//print callback
-	false	//console initialized
+	false,	//console initialized
+	0,		//UTF-8 code point
+	0,		//UTF-8 bytes left
+	0,		//UTF-8 raw length
+	{0}		//UTF-8 raw bytes
 };
 
+// Minimum window width in pixel columns for clearing with the GPU.
+#define GPU_CLEAR_MIN_COLUMNS	(48)
+
+// Pre-rendered glyphs. Each entry holds 6 columns of 10 RGB565 pixels.
+#define GLYPH_CACHE_ENTRIES	(128) // 16 KiB, must be a power of 2
+#define GLYPH_VALID			(1u<<31)
+#define GLYPH_STYLE_MASK	(CONSOLE_UNDERLINE | CONSOLE_CROSSED_OUT)
+
+typedef struct
+{
+	u32 key;            // GLYPH_VALID | style flags<<16 | char
+	u32 colors;         // fg<<16 | bg
+	u32 columns[6 * 5];
+} GlyphCacheEntry;
+
+static GlyphCacheEntry glyphCache[GLYPH_CACHE_ENTRIES];
+static const u8 *glyphCacheFont = NULL;
+
 PrintConsole currentCopy;
 
 PrintConsole* currentConsole = &currentCopy;
@@ -75,6 +100,71 @@ PrintConsole* consoleGetDefault(void){return &defaultConsole;}
 
 void consolePrintChar(int c);
 void consoleDrawChar(int c);
+static void newRow();
+
+//---------------------------------------------------------------------------------
+// returns the RGB565 fg<<16 | bg colors for the current color and style flags
+static u32 currentColors(void) {
+//---------------------------------------------------------------------------------
+	int writingColor = currentConsole->fg;
+	int screenColor = currentConsole->bg;
+
+	if (currentConsole->flags & CONSOLE_COLOR_BOLD) {
+		writingColor += 8;
+	} else if (currentConsole->flags & CONSOLE_COLOR_FAINT) {
+		writingColor += 16;
+	}
+
+	if (currentConsole->flags & CONSOLE_COLOR_REVERSE) {
+		int tmp = writingColor;
+		writingColor = screenColor;
+		screenColor = tmp;
+	}
+
+	return (u32)colorTable[writingColor]<<16 | colorTable[screenColor];
+}
+
+//---------------------------------------------------------------------------------
+// tells the display code which pixel columns of the console framebuffer changed
+static void markColumnsDirty(const PrintConsole *console, int x, int width) {
+//---------------------------------------------------------------------------------
+	if (x < 0) {
+		width += x;
+		x = 0;
+	}
+	if (width <= 0) return;
+
+	GFX_markDirty(console->frameBuffer == (u16*)RENDERBUF_TOP ? SCREEN_TOP : SCREEN_SUB, x, width);
+}
+
+//---------------------------------------------------------------------------------
+// clears the whole console window with the GPU fill engine. Only works if the
+// window covers full pixel columns since the fill engine has no stride.
+static bool gpuClearWindow(void) {
+//---------------------------------------------------------------------------------
+	const PrintConsole *console = currentConsole;
+
+	if (console->windowY != 0 || console->windowHeight * 10 != 240) return false;
+	// not worth the setup and IRQ round trip for tiny windows
+	if (console->windowWidth * 6 < GPU_CLEAR_MIN_COLUMNS) return false;
+	// printing spaces would draw the lines for these
+	if (console->flags & (CONSOLE_UNDERLINE | CONSOLE_CROSSED_OUT)) return false;
+
+	const u32 bg = currentColors() & 0xFFFFu;
+	u16 *const start = &console->frameBuffer[console->windowX * 6 * 240];
+	const u32 size = console->windowWidth * 6 * 240 * 2;
+
+	// Write back pending lines before the fill and drop the stale ones after
+	// it so the CPU sees the cleared window when it draws or scrolls.
+	flushDCacheRange(start, size);
+	GX_memoryFill((u64*)start, 1u<<9, size, bg<<16 | bg, NULL, 0, 0, 0);
+	GFX_waitForEvent(GFX_EVENT_PSC0, true);
+	invalidateDCacheRange(start, size);
+
+	markColumnsDirty(console, console->windowX * 6, console->windowWidth * 6);
+
+	return true;
+}
 
 //---------------------------------------------------------------------------------
 static void consoleCls(char mode) {
@@ -118,8 +208,10 @@ static void consoleCls(char mode) {
 			currentConsole->cursorY  = 0;
 			currentConsole->cursorX  = 0;
 
-			while(i++ < currentConsole->windowHeight * currentConsole->windowWidth)
-				consolePrintChar(' ');
+			if(!gpuClearWindow()) {
+				while(i++ < currentConsole->windowHeight * currentConsole->windowWidth)
+					consolePrintChar(' ');
+			}
 
 			currentConsole->cursorY  = 0;
 			currentConsole->cursorX  = 0;
@@ -182,6 +274,83 @@ static void consoleClearLine(char mode) {
 	}
 }
 
+//---------------------------------------------------------------------------------
+// returns the font glyph for a code point or 0 if the font has none
+static u32 unicodeToGlyph(u32 codepoint) {
+//---------------------------------------------------------------------------------
+	if (codepoint < 0x80) return codepoint;
+	if (codepoint > 0xFFFF) return 0;
+
+	const u32 page = unicodePages[codepoint>>8];
+	if (!page) return 0;
+
+	return unicodeGlyphs[page - 1][codepoint & 0xFF];
+}
+
+//---------------------------------------------------------------------------------
+// prints a glyph without interpreting it as control character
+static void consolePrintGlyph(int c) {
+//---------------------------------------------------------------------------------
+	if(currentConsole->cursorX  >= currentConsole->windowWidth) {
+		currentConsole->cursorX  = 0;
+
+		newRow();
+	}
+
+	consoleDrawChar(c);
+	++currentConsole->cursorX ;
+}
+
+//---------------------------------------------------------------------------------
+// feeds one byte to the UTF-8 decoder of the current console. All console text
+// is UTF-8, file names included (the ARM9 fs code converts them). Bytes which
+// are not valid UTF-8 are printed as raw code page 437 glyphs.
+static void consolePutByte(u8 b) {
+//---------------------------------------------------------------------------------
+	PrintConsole *const con = currentConsole;
+
+	if (con->utf8Left) {
+		if ((b & 0xC0) == 0x80) {
+			con->utf8Raw[con->utf8RawLen++] = b;
+			con->utf8Codepoint = con->utf8Codepoint<<6 | (b & 0x3F);
+			if (--con->utf8Left) return;
+
+			// reject overlong encodings and anything outside of Unicode
+			const u32 minCodepoint[4] = {0, 0x80, 0x800, 0x10000};
+			if (con->utf8Codepoint >= minCodepoint[con->utf8RawLen - 1] && con->utf8Codepoint <= 0x10FFFF) {
+				const u32 glyph = unicodeToGlyph(con->utf8Codepoint);
+				consolePrintGlyph(glyph ? glyph : '?');
+				con->utf8RawLen = 0;
+				return;
+			}
+		}
+
+		for (u32 i = 0; i < con->utf8RawLen; i++) consolePrintGlyph(con->utf8Raw[i]);
+		con->utf8Left = 0;
+		con->utf8RawLen = 0;
+		if ((b & 0xC0) == 0x80) return;
+	}
+
+	if (b >= 0xC2 && b <= 0xDF) {
+		con->utf8Codepoint = b & 0x1F;
+		con->utf8Left = 1;
+	} else if ((b & 0xF0) == 0xE0) {
+		con->utf8Codepoint = b & 0x0F;
+		con->utf8Left = 2;
+	} else if (b >= 0xF0 && b <= 0xF4) {
+		con->utf8Codepoint = b & 0x07;
+		con->utf8Left = 3;
+	} else if (b >= 0x80) {
+		consolePrintGlyph(b);
+		return;
+	} else {
+		consolePrintChar(b);
+		return;
+	}
+
+	con->utf8Raw[con->utf8RawLen++] = b;
+}
+
 //---------------------------------------------------------------------------------
 ssize_t con_write(UNUSED struct _reent *r,UNUSED void *fd,const char *ptr, size_t len) {
 //---------------------------------------------------------------------------------
@@ -458,7 +627,7 @@ ssize_t con_write(UNUSED struct _reent *r,UNUSED void *fd,const char *ptr, size_
 			continue;
 		}
 
-		consolePrintChar(chr);
+		consolePutByte(chr);
 	}
 
 	return count;
@@ -522,6 +691,26 @@ void consoleSetFont(PrintConsole* console, ConsoleFont* font){
 
 }
 
+//---------------------------------------------------------------------------------
+// scrolls the pixel columns [start, end) of the console window up by one row
+static void scrollColumns(void *arg, u32 start, u32 end) {
+//---------------------------------------------------------------------------------
+	const PrintConsole *console = (const PrintConsole*)arg;
+	u16 *dst = &console->frameBuffer[((console->windowX * 6 + start) * 240) + (239 - (console->windowY * 10))];
+	u16 *src = dst - 10;
+
+	u32 i;
+	int j;
+
+	for (i=start; i<end; i++) {
+		u32 *from = (u32*)((int)src & ~3);
+		u32 *to = (u32*)((int)dst & ~3);
+		for (j=0;j<(((console->windowHeight-1)*10)/2);j++) *(to--) = *(from--);
+		dst += 240;
+		src += 240;
+	}
+}
+
 //---------------------------------------------------------------------------------
 static void newRow() {
 //---------------------------------------------------------------------------------
@@ -532,88 +721,108 @@ static void newRow() {
 
 	if(currentConsole->cursorY  >= currentConsole->windowHeight)  {
 		currentConsole->cursorY --;
-		u16 *dst = &currentConsole->frameBuffer[(currentConsole->windowX * 6 * 240) + (239 - (currentConsole->windowY * 10))];
-		u16 *src = dst - 10;
 
-		int i,j;
-
-		for (i=0; i<currentConsole->windowWidth*6; i++) {
-			u32 *from = (u32*)((int)src & ~3);
-			u32 *to = (u32*)((int)dst & ~3);
-			for (j=0;j<(((currentConsole->windowHeight-1)*10)/2);j++) *(to--) = *(from--);
-			dst += 240;
-			src += 240;
-		}
+		// The GPU can't do this. Its engines work in 8 byte units but a text
+		// row is 20 bytes per column. Pixel columns are independent, split them
+		// between cores instead.
+		SMP_parallelFor(currentConsole->windowWidth * 6, 48, scrollColumns, currentConsole);
+		markColumnsDirty(currentConsole, currentConsole->windowX * 6, currentConsole->windowWidth * 6);
 
 		consoleClearLine('2');
 	}
 }
 //---------------------------------------------------------------------------------
-void consoleDrawChar(int c) {
+// expands a glyph into 6 RGB565 pixel columns in framebuffer order
+static void renderGlyph(GlyphCacheEntry *entry, const u8 *fontdata, int flags, u32 colors) {
 //---------------------------------------------------------------------------------
-	c -= currentConsole->font.asciiOffset;
-	if ( c < 0 || c > currentConsole->font.numChars ) return;
+	const u16 fg = colors>>16;
+	const u16 bg = colors;
+	u8 rows[10];
 
-	const u8 *fontdata = currentConsole->font.gfx + (10 * c);
+	memcpy(rows, fontdata, 10);
 
-	int writingColor = currentConsole->fg;
-	int screenColor = currentConsole->bg;
+	if (flags & CONSOLE_UNDERLINE) rows[9] = 0xff;
 
-	if (currentConsole->flags & CONSOLE_COLOR_BOLD) {
-		writingColor += 8;
-	} else if (currentConsole->flags & CONSOLE_COLOR_FAINT) {
-		writingColor += 16;
-	}
+	if (flags & CONSOLE_CROSSED_OUT) rows[4] = 0xff;
 
-	if (currentConsole->flags & CONSOLE_COLOR_REVERSE) {
-		int tmp = writingColor;
-		writingColor = screenColor;
-		screenColor = tmp;
+	u16 *dst = (u16*)entry->columns;
+	u8 mask = 0x80;
+
+	for (int i=0;i<6;i++) {
+		// the framebuffer is rotated, the bottom row comes first
+		for (int j=9;j>=0;j--) *(dst++) = (rows[j] & mask) ? fg : bg;
+		mask >>= 1;
 	}
+}
 
-	u16 bg = colorTable[screenColor];
-	u16 fg = colorTable[writingColor];
+//---------------------------------------------------------------------------------
+// unpacks a glyph from the Unicode atlas into font rows
+static void unpackAtlasGlyph(u32 glyph, u8 rows[10]) {
+//---------------------------------------------------------------------------------
+	const u8 *packed = &unicodeAtlas[(glyph - UNICODE_ATLAS_BASE) * UNICODE_ATLAS_STRIDE];
+	u64 bits = 0;
 
-	u8 b1 = *(fontdata++);
-	u8 b2 = *(fontdata++);
-	u8 b3 = *(fontdata++);
-	u8 b4 = *(fontdata++);
-	u8 b5 = *(fontdata++);
-	u8 b6 = *(fontdata++);
-	u8 b7 = *(fontdata++);
-	u8 b8 = *(fontdata++);
-	u8 b9 = *(fontdata++);
-	u8 b10 = *(fontdata++);
+	for (u32 i = 0; i < UNICODE_ATLAS_STRIDE; i++) bits |= (u64)packed[i]<<(i * 8);
 
-	if (currentConsole->flags & CONSOLE_UNDERLINE) b10 = 0xff;
+	// the atlas only stores font columns 1-5
+	for (u32 i = 0; i < 10; i++) rows[i] = (bits>>(i * 5) & 0x1F)<<2;
+}
 
-	if (currentConsole->flags & CONSOLE_CROSSED_OUT) b5 = 0xff;
+//---------------------------------------------------------------------------------
+void consoleDrawChar(int c) {
+//---------------------------------------------------------------------------------
+	const u8 *fontdata = NULL;
+	u8 atlasRows[10];
 
-	u8 mask = 0x80;
+	if (c >= (int)UNICODE_ATLAS_BASE) {
+		// atlas glyphs don't depend on the font
+		if (c >= (int)(UNICODE_ATLAS_BASE + UNICODE_ATLAS_GLYPHS)) return;
+	} else {
+		c -= currentConsole->font.asciiOffset;
+		if ( c < 0 || c > currentConsole->font.numChars ) return;
 
+		fontdata = currentConsole->font.gfx + (10 * c);
+	}
 
-	int i;
+	const u32 colors = currentColors();
+	const u32 key = GLYPH_VALID | (currentConsole->flags & GLYPH_STYLE_MASK)<<16 | (u32)c;
+
+	// the cache is keyed by RGB565 values so palette changes need no
+	// invalidation but a different font does
+	if (glyphCacheFont != currentConsole->font.gfx) {
+		memset(glyphCache, 0, sizeof(glyphCache));
+		glyphCacheFont = currentConsole->font.gfx;
+	}
+
+	GlyphCacheEntry *entry = &glyphCache[(c ^ colors ^ (colors>>13) ^ (key>>12)) & (GLYPH_CACHE_ENTRIES - 1)];
+	if (entry->key != key || entry->colors != colors) {
+		if (!fontdata) {
+			unpackAtlasGlyph(c, atlasRows);
+			fontdata = atlasRows;
+		}
+		renderGlyph(entry, fontdata, currentConsole->flags, colors);
+		entry->key = key;
+		entry->colors = colors;
+	}
 
 	int x = (currentConsole->cursorX + currentConsole->windowX) * 6;
 	int y = ((currentConsole->cursorY + currentConsole->windowY) * 10);
 
-	u16 *screen = &currentConsole->frameBuffer[(x * 240) + (239 - (y + 9))];
-
-	for (i=0;i<6;i++) {
-		if (b10 & mask) { *(screen++) = fg; }else{ *(screen++) = bg; }
-		if (b9 & mask) { *(screen++) = fg; }else{ *(screen++) = bg; }
-		if (b8 & mask) { *(screen++) = fg; }else{ *(screen++) = bg; }
-		if (b7 & mask) { *(screen++) = fg; }else{ *(screen++) = bg; }
-		if (b6 & mask) { *(screen++) = fg; }else{ *(screen++) = bg; }
-		if (b5 & mask) { *(screen++) = fg; }else{ *(screen++) = bg; }
-		if (b4 & mask) { *(screen++) = fg; }else{ *(screen++) = bg; }
-		if (b3 & mask) { *(screen++) = fg; }else{ *(screen++) = bg; }
-		if (b2 & mask) { *(screen++) = fg; }else{ *(screen++) = bg; }
-		if (b1 & mask) { *(screen++) = fg; }else{ *(screen++) = bg; }
-		mask >>= 1;
-		screen += 240 - 10;
+	// character rows start at multiples of 10 pixels so the columns are always word aligned
+	u32 *screen = (u32*)&currentConsole->frameBuffer[(x * 240) + (239 - (y + 9))];
+	const u32 *src = entry->columns;
+
+	for (int i=0;i<6;i++) {
+		screen[0] = src[0];
+		screen[1] = src[1];
+		screen[2] = src[2];
+		screen[3] = src[3];
+		screen[4] = src[4];
+		src += 5;
+		screen += 240 / 2;
 	}
 
+	markColumnsDirty(currentConsole, x, 6);
 }
 
 //---------------------------------------------------------------------------------
@@ -735,6 +944,8 @@ void drawConsoleWindow(PrintConsole* console, int thickness, u8 colorIndex) {
 			*screen = color;
 		}
 	}
+
+	markColumnsDirty(currentConsole, startx, endx - startx);
 }
 
 void consoleSetCursor(PrintConsole* console, int x, int y) {
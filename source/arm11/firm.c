@@ -51,14 +51,19 @@ void NAKED firmLaunchStub(void)
 	((void (*)(void))entry)();
 }
 
-s32 loadVerifyFirm(const char *const path, bool skipHashCheck)
+u32 loadVerifyFirmAsync(const char *const path, bool skipHashCheck)
 {
 	u32 cmdBuf[3];
 	cmdBuf[0] = (u32)path;
 	cmdBuf[1] = strlen(path) + 1;
 	cmdBuf[2] = skipHashCheck;
 
-	return PXI_sendCmd(IPC_CMD9_LOAD_VERIFY_FIRM, cmdBuf, 3);
+	return PXI_submitCmd(IPC_CMD9_LOAD_VERIFY_FIRM, cmdBuf, 3);
+}
+
+s32 loadVerifyFirm(const char *const path, bool skipHashCheck)
+{
+	return PXI_waitCmd(loadVerifyFirmAsync(path, skipHashCheck));
 }
 
 noreturn void firmLaunch(void)
@@ -23,14 +23,19 @@
 
 
 
-s32 writeFirmPartition(const char *const part, bool replaceSig)
+u32 writeFirmPartitionAsync(const char *const part, bool replaceSig)
 {
 	u32 cmdBuf[3];
 	cmdBuf[0] = (u32)part;
 	cmdBuf[1] = strlen(part) + 1;
 	cmdBuf[2] = replaceSig;
 
-	return PXI_sendCmd(IPC_CMD9_WRITE_FIRM_PART, cmdBuf, 3);
+	return PXI_submitCmd(IPC_CMD9_WRITE_FIRM_PART, cmdBuf, 3);
+}
+
+s32 writeFirmPartition(const char *const part, bool replaceSig)
+{
+	return PXI_waitCmd(writeFirmPartitionAsync(part, replaceSig));
 }
 
 s32 loadVerifyUpdate(const char *const path, u32 *const version)
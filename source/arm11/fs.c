@@ -21,6 +21,7 @@
 #include "fs.h"
 #include "ipc_handler.h"
 #include "hardware/pxi.h"
+#include "hardware/cache.h"
 
 
 
@@ -64,6 +65,16 @@ bool fIsDevActive(FsDevice dev)
 	return PXI_sendCmd(IPC_CMD9_FIS_DEV_ACTIVE, &cmdBuf, 1);
 }
 
+s32 fGetDeviceCid(FsDevice dev, u32 cid[4])
+{
+	u32 cmdBuf[3];
+	cmdBuf[0] = (u32)cid;
+	cmdBuf[1] = 16;
+	cmdBuf[2] = dev;
+
+	return PXI_sendCmd(IPC_CMD9_FGET_DEV_CID, cmdBuf, 3);
+}
+
 s32 fPrepareRawAccess(FsDevice dev)
 {
 	const u32 cmdBuf = dev;
@@ -110,6 +121,42 @@ s32 fsWriteFromDeviceBuffer(s32 destHandle, u32 destOffset, u32 destSize, DevBuf
 	return PXI_sendCmd(IPC_CMD9_FWRITE_FROM_DEV_BUF, cmdBuf, 4);
 }
 
+s32 fStartDeviceBufferHash(DevBufHandle devBufHandle)
+{
+	const u32 cmdBuf = devBufHandle;
+	return PXI_sendCmd(IPC_CMD9_FSTART_DEV_BUF_HASH, &cmdBuf, 1);
+}
+
+s32 fGetDeviceBufferHash(DevBufHandle devBufHandle, u32 hash[8])
+{
+	u32 cmdBuf[3];
+	cmdBuf[0] = (u32)hash;
+	cmdBuf[1] = 32;
+	cmdBuf[2] = devBufHandle;
+
+	return PXI_sendCmd(IPC_CMD9_FGET_DEV_BUF_HASH, cmdBuf, 3);
+}
+
+s32 fSaveDeviceBufferHash(DevBufHandle devBufHandle, FsHashState *state)
+{
+	u32 cmdBuf[3];
+	cmdBuf[0] = (u32)state;
+	cmdBuf[1] = sizeof(FsHashState);
+	cmdBuf[2] = devBufHandle;
+
+	return PXI_sendCmd(IPC_CMD9_FSAVE_DEV_BUF_HASH, cmdBuf, 3);
+}
+
+s32 fResumeDeviceBufferHash(DevBufHandle devBufHandle, const FsHashState *state)
+{
+	u32 cmdBuf[3];
+	cmdBuf[0] = (u32)state;
+	cmdBuf[1] = sizeof(FsHashState);
+	cmdBuf[2] = devBufHandle;
+
+	return PXI_sendCmd(IPC_CMD9_FRESUME_DEV_BUF_HASH, cmdBuf, 3);
+}
+
 s32 fOpen(const char *const path, FsOpenMode mode)
 {
 	u32 cmdBuf[3];
@@ -262,3 +309,50 @@ s32 fSetNandProtection(bool protect)
 	const u32 cmdBuf = protect;
 	return PXI_sendCmd(IPC_CMD9_FSET_NAND_PROT, &cmdBuf, 1);
 }
+
+s32 fGetNandPartition(const char *const name, FsNandPartition *part)
+{
+	u32 cmdBuf[4];
+	cmdBuf[0] = (u32)name;
+	cmdBuf[1] = strlen(name) + 1;
+	cmdBuf[2] = (u32)part;
+	cmdBuf[3] = sizeof(FsNandPartition);
+
+	return PXI_sendCmd(IPC_CMD9_FGET_NAND_PART, cmdBuf, 4);
+}
+
+s32 fVerifyNandPartImage(const char *const path)
+{
+	u32 cmdBuf[2];
+	cmdBuf[0] = (u32)path;
+	cmdBuf[1] = strlen(path) + 1;
+
+	return PXI_sendCmd(IPC_CMD9_FVERIFY_NAND_PART, cmdBuf, 2);
+}
+
+s32 fBatch(FsBatchOp *ops, u32 num)
+{
+	if(!num || num > FS_BATCH_MAX_OPS) return -30;
+
+	// The generic IPC code only takes care of the op array itself
+	for(u32 i = 0; i < num; i++)
+	{
+		if(ops[i].path) flushDCacheRange(ops[i].path, ops[i].pathSize);
+		if(ops[i].out && ops[i].outSize) invalidateDCacheRange(ops[i].out, ops[i].outSize);
+	}
+
+	u32 cmdBuf[4];
+	cmdBuf[0] = (u32)ops;
+	cmdBuf[1] = sizeof(FsBatchOp) * num;
+	cmdBuf[2] = (u32)ops;
+	cmdBuf[3] = sizeof(FsBatchOp) * num;
+
+	const s32 res = PXI_sendCmd(IPC_CMD9_FBATCH, cmdBuf, 4);
+
+	for(u32 i = 0; i < num; i++)
+	{
+		if(ops[i].out && ops[i].outSize) invalidateDCacheRange(ops[i].out, ops[i].outSize);
+	}
+
+	return res;
+}
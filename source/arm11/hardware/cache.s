@@ -26,6 +26,14 @@
 #define CACHE_LINE_SIZE	(32)
 
 
+@ The whole cache operations only handle the L1 caches. L2C_deinit()
+@ takes care of the L2 before firm launch. The range operations also
+@ maintain the L2 (New 3DS) so buffers are coherent with DMA and ARM9.
+.extern L2C_flushRange
+.extern L2C_flushInvalidateRange
+.extern L2C_invalidateRange
+
+
 
 ASM_FUNC invalidateICache
 	mov r0, #0
@@ -68,6 +76,7 @@ ASM_FUNC flushInvalidateDCache
 ASM_FUNC flushDCacheRange
 	add r1, r1, r0
 	bic r0, r0, #(CACHE_LINE_SIZE - 1)
+	mov r3, r0
 	mov r2, #0
 	flushDCacheRange_lp:
 		mcr p15, 0, r0, c7, c10, 1  @ "Clean Data Cache Line (using MVA)"
@@ -75,12 +84,15 @@ ASM_FUNC flushDCacheRange
 		cmp r0, r1
 		blt flushDCacheRange_lp
 	mcr p15, 0, r2, c7, c10, 4      @ Data Synchronization Barrier
-	bx lr
+	mov r0, r3
+	sub r1, r1, r3
+	b L2C_flushRange                @ L1 first, then the L2 behind it
 
 
 ASM_FUNC flushInvalidateDCacheRange
 	add r1, r1, r0
 	bic r0, r0, #(CACHE_LINE_SIZE - 1)
+	mov r3, r0
 	mov r2, #0
 	flushInvalidateDCacheRange_lp:
 		mcr p15, 0, r0, c7, c14, 1  @ "Clean and Invalidate Data Cache Line (using MVA)"
@@ -88,7 +100,9 @@ ASM_FUNC flushInvalidateDCacheRange
 		cmp r0, r1
 		blt flushInvalidateDCacheRange_lp
 	mcr p15, 0, r2, c7, c10, 4      @ Data Synchronization Barrier
-	bx lr
+	mov r0, r3
+	sub r1, r1, r3
+	b L2C_flushInvalidateRange
 
 
 ASM_FUNC invalidateDCache
@@ -104,6 +118,14 @@ ASM_FUNC invalidateDCacheRange
 	mcrne p15, 0, r0, c7, c10, 1    @ "Clean Data Cache Line (using MVA)"
 	tst r1, #(CACHE_LINE_SIZE - 1)
 	mcrne p15, 0, r1, c7, c10, 1    @ "Clean Data Cache Line (using MVA)"
+	mov r2, #0
+	mcr p15, 0, r2, c7, c10, 4      @ Data Synchronization Barrier
+	@ The L2 goes first so the L1 can't refill stale lines from it.
+	@ The cleaned partial lines are written back by the L2 edge handling.
+	stmfd sp!, {r0, r1, r4, lr}
+	sub r1, r1, r0
+	bl L2C_invalidateRange
+	ldmfd sp!, {r0, r1, r4, lr}
 	bic r0, r0, #(CACHE_LINE_SIZE - 1)
 	mov r2, #0
 	invalidateDCacheRange_lp:
@@ -53,9 +53,22 @@
 
 #define REGs_TRANS_ENGINE        ((vu32*)(GPU_EXT_REGS_BASE + 0x0C00))
 
+// Top and sub render buffers are contiguous and rotated so
+// we can treat them as one buffer of 240 pixel high columns.
+#define RENDERBUF_COLUMNS        (SCREEN_WIDTH_TOP + SCREEN_WIDTH_SUB)
+#define COLUMN_SIZE              (SCREEN_HEIGHT_TOP * 2)
+
 
 static u32 activeFb = 0;
 static volatile bool eventTable[6] = {0};
+// Dirty render buffer columns [start, end) per framebuffer set.
+// Start >= end means the framebuffer set is up to date.
+static u16 dirtyStart[2] = {0, 0};
+static u16 dirtyEnd[2] = {RENDERBUF_COLUMNS, RENDERBUF_COLUMNS};
+// Presentation queue. The render buffer is copied into the back framebuffer set
+// which is then swapped in by the VBlank IRQ once the copy finished.
+static volatile bool copyBusy = false;
+static volatile bool swapPending = false;
 
 
 
@@ -87,7 +100,7 @@ static void gfxSetupLcdTop(void)
 	*((vu32*)(0x10400400+0x6C)) = FRAMEBUF_TOP_A_2;                             // Framebuffer A second address
 	*((vu32*)(0x10400400+0x70)) = 0x00080042;                                   // Format GL_RGB565_OES
 	*((vu32*)(0x10400400+0x74)) = 0x00010501;
-	*((vu32*)(0x10400400+0x78)) = 0x00000000;                                   // Framebuffer select 0
+	*((vu32*)(0x10400400+0x78)) = activeFb;                                     // Framebuffer select
 	*((vu32*)(0x10400400+0x90)) = SCREEN_HEIGHT_TOP * 2;                        // Stride 0
 	*((vu32*)(0x10400400+0x94)) = FRAMEBUF_TOP_A_1;                             // Framebuffer B first address
 	*((vu32*)(0x10400400+0x98)) = FRAMEBUF_TOP_A_2;                             // Framebuffer B second address
@@ -129,7 +142,7 @@ static void gfxSetupLcdSub(void)
 	*((vu32*)(0x10400500+0x6C)) = FRAMEBUF_SUB_A_2;                             // Framebuffer second address
 	*((vu32*)(0x10400500+0x70)) = 0x00080002;                                   // Format GL_RGB565_OES
 	*((vu32*)(0x10400500+0x74)) = 0x00010501;
-	*((vu32*)(0x10400500+0x78)) = 0x00000000;                                   // Framebuffer select 0
+	*((vu32*)(0x10400500+0x78)) = activeFb;                                     // Framebuffer select
 	*((vu32*)(0x10400500+0x90)) = SCREEN_HEIGHT_SUB * 2;                        // Stride 0
 	*((vu32*)(0x10400500+0x9C)) = 0x00000000;
 
@@ -148,7 +161,7 @@ static void gfxSetupFramebuffers(void)
 	*((vu32*)(0x10400400+0x68)) = FRAMEBUF_TOP_A_1;                             // Framebuffer A first address
 	*((vu32*)(0x10400400+0x6C)) = FRAMEBUF_TOP_A_2;                             // Framebuffer A second address
 	*((vu32*)(0x10400400+0x70)) = 0x00080042;                                   // Format GL_RGB565_OES
-	*((vu32*)(0x10400400+0x78)) = 0x00000000;                                   // Framebuffer select 0
+	*((vu32*)(0x10400400+0x78)) = activeFb;                                     // Framebuffer select
 	*((vu32*)(0x10400400+0x90)) = SCREEN_HEIGHT_TOP * 2;                        // Stride 0
 	*((vu32*)(0x10400400+0x94)) = FRAMEBUF_TOP_A_1;                             // Framebuffer B first address
 	*((vu32*)(0x10400400+0x98)) = FRAMEBUF_TOP_A_2;                             // Framebuffer B second address
@@ -158,7 +171,7 @@ static void gfxSetupFramebuffers(void)
 	*((vu32*)(0x10400500+0x68)) = FRAMEBUF_SUB_A_1;                             // Framebuffer first address
 	*((vu32*)(0x10400500+0x6C)) = FRAMEBUF_SUB_A_2;                             // Framebuffer second address
 	*((vu32*)(0x10400500+0x70)) = 0x00080002;                                   // Format GL_RGB565_OES
-	*((vu32*)(0x10400500+0x78)) = 0x00000000;                                   // Framebuffer select 0
+	*((vu32*)(0x10400500+0x78)) = activeFb;                                     // Framebuffer select
 	*((vu32*)(0x10400500+0x90)) = SCREEN_HEIGHT_SUB * 2;                        // Stride 0
 }
 
@@ -234,8 +247,64 @@ void GFX_swapFramebufs(void)
 	*((vu32*)(0x10400500+0x78)) = activeFb;
 }
 
+void GFX_markDirty(u8 screen, u32 x, u32 width)
+{
+	const u32 screenWidth = (screen == SCREEN_TOP ? SCREEN_WIDTH_TOP : SCREEN_WIDTH_SUB);
+	if(x >= screenWidth || !width) return;
+	if(width > screenWidth - x) width = screenWidth - x;
+	if(screen != SCREEN_TOP) x += SCREEN_WIDTH_TOP;
+
+	// Both framebuffer sets need the new data.
+	for(u32 i = 0; i < 2; i++)
+	{
+		if(x < dirtyStart[i]) dirtyStart[i] = x;
+		if(x + width > dirtyEnd[i]) dirtyEnd[i] = x + width;
+	}
+}
+
+void GFX_queuePresent(void)
+{
+	// The VBlank IRQ must not swap while we pick the back buffer.
+	const u32 oldState = enterCriticalSection();
+
+	const u32 backFb = activeFb;
+	const u32 start = dirtyStart[backFb];
+	const u32 end = dirtyEnd[backFb];
+	if(start < end)
+	{
+		const u32 offset = start * COLUMN_SIZE;
+		copyBusy = true;
+		GX_textureCopy((u64*)(RENDERBUF_TOP + offset), 0,
+		               (u64*)((u32)GFX_getFramebuffer(SCREEN_TOP) + offset), 0, (end - start) * COLUMN_SIZE);
+
+		dirtyStart[backFb] = RENDERBUF_COLUMNS;
+		dirtyEnd[backFb] = 0;
+
+		// If the previous frame is still pending it just gets replaced.
+		swapPending = true;
+	}
+
+	leaveCriticalSection(oldState);
+
+	// The transfer engine reads the render buffer. Callers may draw
+	// into it right after we return so wait until the copy is done.
+	while(copyBusy) __wfe();
+}
+
+void GFX_waitForPresent(void)
+{
+	while(swapPending) __wfe();
+}
+
 static void gfxIrqHandler(u32 intSource)
 {
+	if(intSource == IRQ_PPF) copyBusy = false;
+	else if(intSource == IRQ_PDC0 && swapPending && !copyBusy)
+	{
+		GFX_swapFramebufs();
+		swapPending = false;
+	}
+
 	eventTable[intSource - IRQ_PSC0] = true;
 }
 
@@ -315,6 +384,8 @@ void GFX_returnFromLowPowerState(void)
 
 void GFX_deinit(bool keepLcdsOn)
 {
+	GFX_waitForPresent();
+
 	IRQ_disable(IRQ_PSC0);
 	IRQ_disable(IRQ_PSC1);
 	IRQ_disable(IRQ_PDC0);
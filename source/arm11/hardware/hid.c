@@ -26,10 +26,21 @@
 #include "arm11/hardware/i2c.h"
 #include "arm11/hardware/interrupt.h"
 #include "arm11/hardware/gpio.h"
+#include "arm11/queue.h"
+
+
+#define HID_EVENT_QUEUE_SIZE  (16)
 
 
 static u32 kHeld = 0, kDown = 0, kUp = 0;
-static vu32 homeShellState = 0, powerWifiState = 0;
+static u32 homeShellState = 0;
+static vu32 powerWifiState = 0;
+// HOME/shell events from the IRQ handler. Each one is handled
+// in hidScanInput() so short presses between 2 scans are not lost.
+static SpscQueue hidEventQueue;
+static u32 hidEventBuf[HID_EVENT_QUEUE_SIZE];
+// Events merged on queue overflow. Newer than everything in the queue.
+static vu32 hidPendingEvents = 0;
 
 
 
@@ -43,6 +54,7 @@ void hidInit(void)
 	//const u32 mcuInterruptMask = 0xFFFF1800u; // Standard bitmask at cold boot
 	//I2C_writeRegBuf(I2C_DEV_MCU, 0x18, (const u8*)&mcuInterruptMask, 4);
 
+	spscQueueInit(&hidEventQueue, hidEventBuf, HID_EVENT_QUEUE_SIZE);
 	IRQ_registerHandler(IRQ_MCU_HID, 14, 0, true, hidIrqHandler);
 	GPIO_setBit(19, 9); // This enables the MCU HID IRQ
 }
@@ -56,13 +68,13 @@ static void hidIrqHandler(UNUSED u32 intSource)
 	tmp |= state>>2 & 4;
 	powerWifiState = tmp;
 
-	tmp = homeShellState;
-	tmp |= (state & 4)<<19;
-	tmp |= (state & 0x20)<<17;
-
-	if(tmp & KEY_HOME) tmp ^= (state & 8)<<18;
-	if(tmp & KEY_SHELL) tmp ^= (state & 0x40)<<16;
-	homeShellState = tmp;
+	// On overflow merge the event instead of dropping it so no release
+	// gets lost. Once merging, keep merging to preserve the order.
+	if(state & 0x6C)
+	{
+		if(hidPendingEvents || !spscQueuePush(&hidEventQueue, state))
+			hidPendingEvents |= state;
+	}
 }
 
 u32 hidGetPowerButton(bool resetState)
@@ -88,12 +100,42 @@ bool hidIsHomeButtonHeldRaw(void)
 	return !(buf[18] & 1u<<1);
 }
 
+// Presses released again before the scan still count as down
+static u32 applyEvent(u32 tmp, u32 state, u32 *const pressed, u32 *const released)
+{
+	const u32 old = tmp;
+	tmp |= (state & 4)<<19;
+	tmp |= (state & 0x20)<<17;
+
+	if(tmp & KEY_HOME) tmp ^= (state & 8)<<18;
+	if(tmp & KEY_SHELL) tmp ^= (state & 0x40)<<16;
+
+	*pressed |= (tmp | (state & 4)<<19 | (state & 0x20)<<17) & ~old;
+	*released |= old & ~tmp;
+
+	return tmp;
+}
+
 void hidScanInput(void)
 {
 	u32 kOld = kHeld;
-	kHeld = homeShellState | REG_HID_PAD;;
-	kDown = (~kOld) & kHeld;
-	kUp = kOld & (~kHeld);
+
+	u32 pressed = 0, released = 0;
+	u32 state;
+	u32 tmp = homeShellState;
+	while(spscQueuePop(&hidEventQueue, &state))
+		tmp = applyEvent(tmp, state, &pressed, &released);
+
+	const u32 oldState = enterCriticalSection();
+	state = hidPendingEvents;
+	hidPendingEvents = 0;
+	leaveCriticalSection(oldState);
+	if(state) tmp = applyEvent(tmp, state, &pressed, &released);
+	homeShellState = tmp;
+
+	kHeld = homeShellState | REG_HID_PAD;
+	kDown = ((~kOld) & kHeld) | (pressed & ~kOld);
+	kUp = (kOld & (~kHeld)) | (released & kOld);
 }
 
 u32 hidKeysHeld(void)
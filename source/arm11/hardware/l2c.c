@@ -0,0 +1,148 @@
+/*
+ *   This file is part of fastboot 3DS
+ *   Copyright (C) 2018 derrek, profi200
+ *
+ *   This program is free software: you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License as published by
+ *   the Free Software Foundation, either version 3 of the License, or
+ *   (at your option) any later version.
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "types.h"
+#include "arm11/hardware/l2c.h"
+#include "arm11/hardware/cfg11.h"
+#include "arm11/hardware/interrupt.h"
+#include "arm11/spinlock.h"
+#include "fb_assert.h"
+#include "arm.h"
+
+
+static bool l2Enabled;
+static u32 l2Lock; // The L2C-310 doesn't allow overlapping maintenance operations
+
+
+
+static u32 lockL2(void)
+{
+	// Cache operations may be used in IRQ handlers
+	const u32 oldState = enterCriticalSection();
+	spinlockLock(&l2Lock);
+	return oldState;
+}
+
+static void unlockL2(u32 oldState)
+{
+	spinlockUnlock(&l2Lock);
+	leaveCriticalSection(oldState);
+}
+
+static void syncL2(void)
+{
+	REG_L2C_SYNC = 0;
+	while(REG_L2C_SYNC & 1);
+}
+
+// Waits for a background operation by way to finish
+static void wayOp(vu32 *const reg)
+{
+	// Bit 16 in the aux control register is set for 16 ways
+	const u32 ways = (REG_L2C_AUX_CNT & 1u<<16 ? 0xFFFFu : 0xFFu);
+	*reg = ways;
+	while(*reg & ways);
+	syncL2();
+}
+
+void L2C_init(void)
+{
+	fb_assert(__getCpuId() == 0);
+
+	// core123Init() sets up the clock for it
+#ifdef CORE123_INIT
+	if(!(REG_CFG11_SOCINFO & 2)) return;
+#else
+	return;
+#endif
+
+	if(!(REG_L2C_CNT & 1))
+	{
+		// Everything in the L2 is garbage after reset
+		wayOp(&REG_L2C_INV_WAY);
+		REG_L2C_CNT = 1;
+		__dsb();
+	}
+	l2Enabled = true;
+}
+
+void L2C_deinit(void)
+{
+	if(!l2Enabled) return;
+
+	const u32 oldState = lockL2();
+	wayOp(&REG_L2C_CLEAN_INV_WAY);
+	REG_L2C_CNT = 0;
+	__dsb();
+	l2Enabled = false;
+	unlockL2(oldState);
+}
+
+bool L2C_isEnabled(void)
+{
+	return l2Enabled;
+}
+
+static void rangeOp(vu32 *const reg, u32 start, u32 end)
+{
+	for(u32 addr = start & ~(L2C_LINE_SIZE - 1); addr < end; addr += L2C_LINE_SIZE) *reg = addr;
+}
+
+void L2C_flushRange(const void *const base, u32 size)
+{
+	if(!l2Enabled || !size) return;
+
+	const u32 oldState = lockL2();
+	rangeOp(&REG_L2C_CLEAN_PA, (u32)base, (u32)base + size);
+	syncL2();
+	unlockL2(oldState);
+}
+
+void L2C_flushInvalidateRange(const void *const base, u32 size)
+{
+	if(!l2Enabled || !size) return;
+
+	const u32 oldState = lockL2();
+	rangeOp(&REG_L2C_CLEAN_INV_PA, (u32)base, (u32)base + size);
+	syncL2();
+	unlockL2(oldState);
+}
+
+void L2C_invalidateRange(const void *const base, u32 size)
+{
+	if(!l2Enabled || !size) return;
+
+	u32 start = (u32)base;
+	u32 end = start + size;
+
+	const u32 oldState = lockL2();
+	// Partial lines at the edges may hold data outside of the range
+	if(start & (L2C_LINE_SIZE - 1))
+	{
+		REG_L2C_CLEAN_INV_PA = start & ~(L2C_LINE_SIZE - 1);
+		start = (start + L2C_LINE_SIZE) & ~(L2C_LINE_SIZE - 1);
+	}
+	if(end & (L2C_LINE_SIZE - 1) && end > start)
+	{
+		end &= ~(L2C_LINE_SIZE - 1);
+		REG_L2C_CLEAN_INV_PA = end;
+	}
+	rangeOp(&REG_L2C_INV_PA, start, end);
+	syncL2();
+	unlockL2(oldState);
+}
@@ -164,8 +164,14 @@ void setupMmu(void)
 		            (u32*)(A11_MMU_TABLES_BASE + 0x4000), false, PERM_PRIV_RW_USR_NA,
 		            0, true, L1_TO_L2(ATTR_NONSHARED_DEVICE));
 
-		// VRAM mapping
-		mmuMapSections(VRAM_BASE, VRAM_BASE, 6, true, PERM_PRIV_RW_USR_NA, 0, true, ATTR_NORM_WRITE_TROUGH_NO_ALLOC);
+		// L2C-310 mapping. Only accessed on New 3DS.
+		mmuMapPages(L2_CACHE_CONTR_BASE, L2_CACHE_CONTR_BASE, 1,
+		            (u32*)(A11_MMU_TABLES_BASE + 0x4000), false, PERM_PRIV_RW_USR_NA,
+		            0, true, L1_TO_L2(ATTR_NONSHARED_DEVICE));
+
+		// VRAM mapping. Kept out of the L2 because the GPU writes to it behind our back.
+		mmuMapSections(VRAM_BASE, VRAM_BASE, 6, true, PERM_PRIV_RW_USR_NA, 0, true,
+		               CUSTOM_ATTR(POLI_NONCACHABLE_UNBUFFERED, POLI_WRITE_THROUGH_NO_ALLOC_BUFFERED));
 
 		// AXIWRAM core 0/1 stack mapping
 		mmuMapPages(A11_C0_STACK_START, A11_C0_STACK_START, 4, (u32*)(A11_MMU_TABLES_BASE + 0x4400),
@@ -181,7 +187,7 @@ void setupMmu(void)
 		extern const u32 __rodata_start__[];
 		extern const u32 __rodata_pages__[];
 		extern const u32 __data_start__[];
-		const u32 dataPages = (AXIWRAM_BASE + AXIWRAM_SIZE - (u32)__data_start__) / 0x1000;
+		const u32 dataPages = (PXI_RING_BASE - (u32)__data_start__) / 0x1000;
 
 		// text
 		mmuMapPages((u32)__start__, (u32)__start__, (u32)__text_pages__,
@@ -195,6 +201,15 @@ void setupMmu(void)
 		mmuMapPages((u32)__data_start__, (u32)__data_start__, dataPages,
 		            (u32*)(A11_MMU_TABLES_BASE + 0x4400u), true, PERM_PRIV_RW_USR_NA, 0, true,
 		            L1_TO_L2(CUSTOM_ATTR(POLI_WRITE_BACK_ALLOC_BUFFERED, POLI_WRITE_BACK_ALLOC_BUFFERED)));
+		// PXI request ring
+		mmuMapPages(PXI_RING_BASE, PXI_RING_BASE, PXI_RING_SIZE / 0x1000,
+		            (u32*)(A11_MMU_TABLES_BASE + 0x4400u), true, PERM_PRIV_RW_USR_NA, 0, true,
+		            L1_TO_L2(ATTR_NORM_NONCACHABLE));
+		// stub and exception vectors
+		mmuMapPages(PXI_RING_BASE + PXI_RING_SIZE, PXI_RING_BASE + PXI_RING_SIZE,
+		            (AXIWRAM_BASE + AXIWRAM_SIZE - PXI_RING_BASE - PXI_RING_SIZE) / 0x1000,
+		            (u32*)(A11_MMU_TABLES_BASE + 0x4400u), true, PERM_PRIV_RW_USR_NA, 0, true,
+		            L1_TO_L2(CUSTOM_ATTR(POLI_WRITE_BACK_ALLOC_BUFFERED, POLI_WRITE_BACK_ALLOC_BUFFERED)));
 
 		// FCRAM with New 3DS extension
 		//mmuMapSupersections(FCRAM_BASE, FCRAM_BASE, 16, PERM_PRIV_RW_USR_NA, true,
@@ -0,0 +1,133 @@
+/*
+ *   This file is part of fastboot 3DS
+ *   Copyright (C) 2017 derrek, profi200
+ *
+ *   This program is free software: you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License as published by
+ *   the Free Software Foundation, either version 3 of the License, or
+ *   (at your option) any later version.
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <string.h>
+#include "types.h"
+#include "ipc_handler.h"
+#include "fs.h"
+#include "arm11/ipc_stats.h"
+#include "arm11/perf.h"
+#include "arm11/fmt.h"
+#include "arm11/hardware/timer.h"
+#include "arm11/hardware/performance_monitor.h"
+
+
+// The cycle counter runs with the /64 divider so it wraps after ~17 minutes
+#define CCNT_DIV        (64u)
+#define CYCLES_PER_US   ((u32)(TIMER_BASE_FREQ / 1000000))
+
+
+static IpcCmdStats ipcStats[IPC_STATS_MAX_CMDS];
+
+// Must match the IpcCmd9 IDs
+static const char *const cmdNames[] =
+{
+	"FMOUNT", "FUNMOUNT", "FIS_DRIVE_MOUNTED", "FGETFREE", "FGET_DEV_SIZE",
+	"FIS_DEV_ACTIVE", "FPREP_RAW_ACCESS", "FFINAL_RAW_ACCESS", "FCREATE_DEV_BUF",
+	"FFREE_DEV_BUF", "FREAD_TO_DEV_BUF", "FWRITE_FROM_DEV_BUF", "FOPEN", "FREAD",
+	"FWRITE", "FSYNC", "FLSEEK", "FTELL", "FSIZE", "FCLOSE", "FEXPAND", "FSTAT",
+	"FOPEN_DIR", "FREAD_DIR", "FCLOSE_DIR", "FMKDIR", "FRENAME", "FUNLINK",
+	"FVERIFY_NAND_IMG", "FSET_NAND_PROT", "WRITE_FIRM_PART", "LOAD_VERIFY_FIRM",
+	"FIRM_LAUNCH", "LOAD_VERIFY_UPDATE", "GET_BOOT_ENV", "PREPARE_POWER", "PANIC",
+	"EXCEPTION", "FSTART_DEV_BUF_HASH", "FGET_DEV_BUF_HASH", "FGET_NAND_PART",
+	"FVERIFY_NAND_PART", "FSAVE_DEV_BUF_HASH", "FRESUME_DEV_BUF_HASH",
+	"FGET_DEV_CID", "FBATCH"
+};
+
+
+
+void IPC_statsInit(void)
+{
+	// Cycle counter with /64 divider. Event counters are unused.
+	startProfiling(0, 0, true, 0b11);
+}
+
+u32 IPC_statsTimestamp(void)
+{
+	return getCcnt();
+}
+
+void IPC_statsRecord(u32 cmd, u32 bytes, u32 start)
+{
+	const u8 cmdId = IPC_CMD_ID_MASK(cmd);
+	if(cmdId >= IPC_STATS_MAX_CMDS) return;
+
+	// The cycle counter runs at CPU clock. Commands overlapping a clock
+	// change are accounted with the clock at completion.
+	const u32 us = (u32)(((u64)(getCcnt() - start) * CCNT_DIV) / (CYCLES_PER_US * perfGetClockMul()));
+	IpcCmdStats *const stats = &ipcStats[cmdId];
+
+	u32 bucket = 0;
+	while(bucket < IPC_STATS_BUCKETS - 1 && us >= (1u<<bucket)) bucket++;
+
+	stats->calls++;
+	stats->bytes += bytes;
+	stats->totalUs += us;
+	if(us > stats->maxUs) stats->maxUs = us;
+	stats->hist[bucket]++;
+}
+
+const IpcCmdStats* IPC_statsGet(u8 cmdId)
+{
+	if(cmdId >= IPC_STATS_MAX_CMDS) return NULL;
+	return &ipcStats[cmdId];
+}
+
+const char* IPC_statsCmdName(u8 cmdId)
+{
+	if(cmdId >= sizeof(cmdNames) / sizeof(const char*)) return "UNKNOWN";
+	return cmdNames[cmdId];
+}
+
+void IPC_statsReset(void)
+{
+	memset(ipcStats, 0, sizeof(ipcStats));
+}
+
+bool IPC_statsDump(const char *const path)
+{
+	// Take a copy first. Writing the dump issues IPC commands itself.
+	static IpcCmdStats snapshot[IPC_STATS_MAX_CMDS];
+	memcpy(snapshot, ipcStats, sizeof(snapshot));
+
+	const s32 fHandle = fOpen(path, FS_CREATE_ALWAYS | FS_OPEN_WRITE);
+	if(fHandle < 0) return false;
+
+	char line[256];
+	u32 len = ee_snprintf(line, sizeof(line), "cmd                   calls        bytes   avg us   max us  "
+	                      "histogram (<1us, <2us, <4us ... >=16ms)\n");
+	bool res = (fWrite(fHandle, line, len) == 0);
+
+	for(u32 i = 0; i < IPC_STATS_MAX_CMDS && res; i++)
+	{
+		const IpcCmdStats *const stats = &snapshot[i];
+		if(!stats->calls) continue;
+
+		len = ee_snprintf(line, sizeof(line), "%-20s %6lu %12llu %8llu %8lu ", IPC_statsCmdName(i),
+		                  stats->calls, stats->bytes, stats->totalUs / stats->calls, stats->maxUs);
+		for(u32 b = 0; b < IPC_STATS_BUCKETS; b++)
+			len += ee_snprintf(line + len, sizeof(line) - len, " %lu", stats->hist[b]);
+		len += ee_snprintf(line + len, sizeof(line) - len, "\n");
+
+		res = (fWrite(fHandle, line, len) == 0);
+	}
+
+	fClose(fHandle);
+
+	return res;
+}
@@ -8,17 +8,35 @@
 
 
 
+@ Word copies rely on unaligned data access being enabled (see mmu.c).
 ASM_FUNC lz11Decompress
-	push   {r4-r6}
+	push   {r4-r7}
 	ldr    r3, =(0x01010101)
 
 .Lloop:
 	cmp    r2, #0              @ if(size <= 0)
-	pople  {r4-r6}             @   pop stack
+	pople  {r4-r7}             @   pop stack
 	bxle   lr                  @   return
 
 	rors   r3, r3, #1          @ r3 = (r3<<31) | (r3>>1)
-	ldrcsb r12, [r0], #1       @ if(r3 & (1<<31)) flags = *in++
+	bcc    .Lflag              @ if(!(r3 & (1<<31))) goto flag
+	ldrb   r12, [r0], #1       @ flags = *in++
+	pld    [r0, #32]           @ prefetch the next input cache line
+	cmp    r12, #0             @ if(flags != 0)
+	bne    .Lflag              @   goto flag
+	cmp    r2, #8              @ if(size < 8)
+	blt    .Lflag              @   goto flag
+
+@ 8 uncompressed bytes
+	ldr    r4, [r0], #4        @ r4 = *(u32*)in++
+	ldr    r5, [r0], #4        @ r5 = *(u32*)in++
+	str    r4, [r1], #4        @ *(u32*)out++ = r4
+	str    r5, [r1], #4        @ *(u32*)out++ = r5
+	sub    r2, r2, #8          @ size -= 8
+	ror    r3, r3, #31         @ r3 = (r3<<1) | (r3>>31) // all flags used
+	b      .Lloop              @ goto loop
+
+.Lflag:
 	tst    r12, r3             @ if(flags & r3 == 0)
 	beq    .Lcopy_uncompressed @   goto copy_uncompressed
 
@@ -56,6 +74,8 @@ ASM_FUNC lz11Decompress
 	orr    r4, r4, r5, lsl #8  @ disp = r4 | (disp<<8) note: disp changes to r4
 	add    r4, r4, #1          @ disp++
 	sub    r2, r2, r6          @ size -= len
+	cmp    r4, #4              @ if(disp >= 4) // source never overlaps a word
+	bhs    .Lcopy_words        @   goto copy_words
 	tst    r4, #1              @ if(r4 & 1 == 0) // aligned displacement
 	beq    .Lcopy_aligned      @   goto copy_aligned
 
@@ -66,6 +86,15 @@ ASM_FUNC lz11Decompress
 	bne    .Lcopy_compressed   @ goto copy_compressed
 	b      .Lloop              @   goto loop
 
+.Lcopy_words:
+	subs   r6, r6, #4          @ len -= 4
+	ldrge  r7, [r1, -r4]       @ if(len >= 0) r7 = *(u32*)(out - disp)
+	strge  r7, [r1], #4        @ if(len >= 0) *(u32*)out++ = r7
+	bgt    .Lcopy_words        @ if(len > 0) goto copy_words
+	beq    .Lloop              @ if(len == 0) goto loop
+	add    r6, r6, #4          @ len += 4 // 1-3 bytes left
+	b      .Lcopy_compressed   @ goto copy_compressed
+
 .Lcopy_aligned:
 	tst    r1, #0x1            @ if(r1 & 0x1 == 0) // src/dst is aligned
 	beq    .Lcopy_hwords       @   goto copy_hwords
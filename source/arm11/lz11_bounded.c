@@ -0,0 +1,96 @@
+/*
+ *   This file is part of fastboot 3DS
+ *   Copyright (C) 2017 derrek, profi200
+ *
+ *   This program is free software: you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License as published by
+ *   the Free Software Foundation, either version 3 of the License, or
+ *   (at your option) any later version.
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <string.h>
+#include "types.h"
+#include "arm11/lz11.h"
+
+
+
+bool lz11DecompressBounded(const void *in, u32 inSize, void *out, u32 outSize)
+{
+	const u8 *src = (const u8*)in;
+	const u8 *const srcEnd = src + inSize;
+	u8 *dst = (u8*)out;
+	u8 *const dstEnd = dst + outSize;
+
+	while(dst < dstEnd)
+	{
+		if(src >= srcEnd) return false;
+		const u32 flags = *src++;
+
+		// 8 uncompressed bytes
+		if(!flags && srcEnd - src >= 8 && dstEnd - dst >= 8)
+		{
+			memcpy(dst, src, 8);
+			src += 8;
+			dst += 8;
+			continue;
+		}
+
+		for(u32 mask = 0x80; mask && dst < dstEnd; mask >>= 1)
+		{
+			if(!(flags & mask))
+			{
+				if(src >= srcEnd) return false;
+				*dst++ = *src++;
+				continue;
+			}
+
+			if(srcEnd - src < 2) return false;
+
+			u32 len, disp;
+			switch(*src>>4)
+			{
+				case 0:
+					if(srcEnd - src < 3) return false;
+					len = ((src[0] & 0xFu)<<4 | src[1]>>4) + 0x11;
+					disp = (src[1] & 0xFu)<<8 | src[2];
+					src += 3;
+					break;
+				case 1:
+					if(srcEnd - src < 4) return false;
+					len = ((src[0] & 0xFu)<<12 | (u32)src[1]<<4 | src[2]>>4) + 0x111;
+					disp = (src[2] & 0xFu)<<8 | src[3];
+					src += 4;
+					break;
+				default:
+					len = (src[0]>>4) + 1;
+					disp = (src[0] & 0xFu)<<8 | src[1];
+					src += 2;
+			}
+			disp++;
+
+			if(disp > (u32)(dst - (u8*)out) || len > (u32)(dstEnd - dst)) return false;
+
+			const u8 *from = dst - disp;
+			if(disp >= 4) // source never overlaps a word
+			{
+				for(; len >= 4; len -= 4)
+				{
+					memcpy(dst, from, 4);
+					dst += 4;
+					from += 4;
+				}
+			}
+			while(len--) *dst++ = *from++;
+		}
+	}
+
+	return true;
+}
@@ -0,0 +1,85 @@
+/*
+ *   This file is part of fastboot 3DS
+ *   Copyright (C) 2017 derrek, profi200
+ *
+ *   This program is free software: you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License as published by
+ *   the Free Software Foundation, either version 3 of the License, or
+ *   (at your option) any later version.
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <string.h>
+#include "types.h"
+#include "arm11/lz4.h"
+
+
+
+// Reads an LZ4 length extension. Returns false on truncated input.
+static bool readLength(const u8 **src, const u8 *const srcEnd, u32 *const len)
+{
+	u32 b;
+	do
+	{
+		if(*src >= srcEnd) return false;
+		b = *(*src)++;
+		*len += b;
+	} while(b == 255);
+
+	return true;
+}
+
+bool lz4DecompressBounded(const void *in, u32 inSize, void *out, u32 outSize)
+{
+	const u8 *src = (const u8*)in;
+	const u8 *const srcEnd = src + inSize;
+	u8 *dst = (u8*)out;
+	u8 *const dstEnd = dst + outSize;
+
+	while(src < srcEnd)
+	{
+		const u32 token = *src++;
+
+		u32 len = token>>4;
+		if(len == 15 && !readLength(&src, srcEnd, &len)) return false;
+		if(len > (u32)(srcEnd - src) || len > (u32)(dstEnd - dst)) return false;
+		memcpy(dst, src, len);
+		src += len;
+		dst += len;
+
+		// The last sequence only has literals. Data after it is ignored
+		// like the LZ11 decoder does (animated splash frames follow each other).
+		if(src == srcEnd || dst == dstEnd) break;
+
+		if(srcEnd - src < 2) return false;
+		const u32 offset = src[0] | (u32)src[1]<<8;
+		src += 2;
+
+		len = token & 0xFu;
+		if(len == 15 && !readLength(&src, srcEnd, &len)) return false;
+		len += 4;
+
+		if(!offset || offset > (u32)(dst - (u8*)out) || len > (u32)(dstEnd - dst)) return false;
+
+		const u8 *from = dst - offset;
+		if(offset >= 4) // source never overlaps a word
+		{
+			for(; len >= 4; len -= 4)
+			{
+				memcpy(dst, from, 4);
+				dst += 4;
+				from += 4;
+			}
+		}
+		while(len--) *dst++ = *from++;
+	}
+
+	return dst == dstEnd;
+}
@@ -0,0 +1,75 @@
+#include "asmfunc.h"
+
+.arm
+.cpu mpcore
+.fpu vfpv2
+
+
+
+@ Trusted data only. Decodes a raw LZ4 block until size bytes are written.
+@ Word copies rely on unaligned data access being enabled (see mmu.c).
+ASM_FUNC lz4Decompress
+	push   {r4-r7}
+	add    r2, r1, r2          @ end = out + size
+
+.Lloop:
+	ldrb   r3, [r0], #1        @ token = *in++
+	lsrs   r4, r3, #4          @ len = token>>4
+	beq    .Lmatch             @ if(len == 0) goto match
+	cmp    r4, #15             @ if(len == 15)
+	bne    .Lcopy_literals
+.Lliteral_length:
+	ldrb   r5, [r0], #1        @   do { r5 = *in++
+	add    r4, r4, r5          @        len += r5
+	cmp    r5, #255            @   } while(r5 == 255)
+	beq    .Lliteral_length
+
+.Lcopy_literals:
+	cmp    r4, #4              @ if(len < 4)
+	blo    .Lliteral_bytes     @   goto literal_bytes
+.Lliteral_words:
+	ldr    r5, [r0], #4        @ r5 = *(u32*)in++
+	sub    r4, r4, #4          @ len -= 4
+	str    r5, [r1], #4        @ *(u32*)out++ = r5
+	cmp    r4, #4              @ if(len >= 4)
+	bhs    .Lliteral_words     @   goto literal_words
+.Lliteral_bytes:
+	subs   r4, r4, #1          @ if(len-- > 0)
+	ldrhsb r5, [r0], #1        @   *out++ = *in++
+	strhsb r5, [r1], #1
+	bhi    .Lliteral_bytes     @ if(len > 0) goto literal_bytes
+
+	cmp    r1, r2              @ if(out >= end) // The last sequence only has literals
+	pophs  {r4-r7}             @   pop stack
+	bxhs   lr                  @   return
+
+.Lmatch:
+	ldrb   r5, [r0], #1        @ offset = *in++
+	ldrb   r6, [r0], #1        @ r6 = *in++
+	orr    r5, r5, r6, lsl #8  @ offset |= r6<<8
+	and    r4, r3, #0xF        @ len = token & 0xF
+	cmp    r4, #15             @ if(len == 15)
+	bne    .Lmatch_length
+.Lmatch_extended:
+	ldrb   r6, [r0], #1        @   do { r6 = *in++
+	add    r4, r4, r6          @        len += r6
+	cmp    r6, #255            @   } while(r6 == 255)
+	beq    .Lmatch_extended
+
+.Lmatch_length:
+	add    r4, r4, #4          @ len += 4
+	sub    r6, r1, r5          @ from = out - offset
+	cmp    r5, #4              @ if(offset < 4) // source overlaps a word
+	blo    .Lmatch_bytes       @   goto match_bytes
+.Lmatch_words:
+	ldr    r7, [r6], #4        @ r7 = *(u32*)from++
+	sub    r4, r4, #4          @ len -= 4
+	str    r7, [r1], #4        @ *(u32*)out++ = r7
+	cmp    r4, #4              @ if(len >= 4)
+	bhs    .Lmatch_words       @   goto match_words
+.Lmatch_bytes:
+	subs   r4, r4, #1          @ if(len-- > 0)
+	ldrhsb r7, [r6], #1        @   *out++ = *from++
+	strhsb r7, [r1], #1
+	bhi    .Lmatch_bytes       @ if(len > 0) goto match_bytes
+	b      .Lloop              @ goto loop
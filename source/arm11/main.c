@@ -31,11 +31,30 @@
 #include "arm11/fmt.h"
 #include "arm11/power.h"
 #include "hardware/gfx.h"
+#include "hardware/pxi.h"
 #include "banner_spla.h"
 #include "fsutils.h"
 
 
 
+// loads a firm while an animated splash keeps playing
+static s32 loadFirmSplash(const char *const path)
+{
+	if(!isSplashAnimating()) return loadVerifyFirm(path, false);
+	
+	const u32 ticket = loadVerifyFirmAsync(path, false);
+	u32 res;
+	bool done;
+	while(!(done = PXI_pollCmd(ticket, &res)) && isSplashAnimating())
+	{
+		GFX_waitForEvent(GFX_EVENT_PDC0, true); // VBlank
+		updateSplashscreen();
+	}
+	if(!done) res = PXI_waitCmd(ticket);
+	
+	return (s32) res;
+}
+
 int main(void)
 {
 	bool startFirmLaunch = false;
@@ -68,7 +87,7 @@ int main(void)
 	{
 		if (!gfx_initialized) GFX_init(true);
 		gfx_initialized = true;
-		splash_wait = drawSplashscreen(banner_spla, -1, -1);
+		splash_wait = drawSplashscreen(banner_spla, banner_spla_size, true, -1, -1);
 	}
 	
 	
@@ -99,7 +118,7 @@ int main(void)
 				char* path = (char*) configGetData(KBootOption1 + i);
 				err_ptr += ee_sprintf(err_ptr, "Keys match boot slot #%lu.\nBoot path is %s\n", (i+1), path);
 				
-				firm_err = loadVerifyFirm(path, false);
+				firm_err = loadFirmSplash(path);
 				if (firm_err >= 0)
 				{
 					startFirmLaunch = true;
@@ -124,6 +143,7 @@ int main(void)
 		for (u32 i = 0; i < 64; i++) // VBlank * 64
 		{
 			GFX_waitForEvent(GFX_EVENT_PDC0, true); 
+			updateSplashscreen();
 			hidScanInput();
 			if (hidKeysDown() & KEY_HOME)
 			{
@@ -141,6 +161,7 @@ int main(void)
 		// init screens / console (if we'll need them below)
 		if(show_menu || err_string)
 		{
+			endSplashscreen();
 			if (!gfx_initialized) GFX_init(true);
 			gfx_initialized = true;
 			// init and select terminal console
@@ -225,7 +246,7 @@ int main(void)
 					char* path = (char*) configGetData(KBootOption1 + i);
 					err_ptr += ee_sprintf(err_ptr, "Trying boot slot #%lu.\nBoot path is %s\n", (i+1), path);
 					
-					firm_err = loadVerifyFirm(path, false);
+					firm_err = loadFirmSplash(path);
 					if (firm_err >= 0)
 					{
 						startFirmLaunch = true;
@@ -249,7 +270,7 @@ int main(void)
 					char* path = (char*) configGetData(KBootOption1 + (nextBootSlot-1));
 					err_ptr += ee_sprintf(err_ptr, "Boot path is %s\n", path);
 					
-					firm_err = loadVerifyFirm(path, false);
+					firm_err = loadFirmSplash(path);
 					startFirmLaunch = (firm_err >= 0);
 					// no need to store the bootslot here as it stays as is
 					
@@ -271,6 +292,7 @@ int main(void)
 	
 	
 	// deinit GFX if it was initialized
+	endSplashscreen();
 	if(gfx_initialized) GFX_deinit(firm_err == 1);
 		
 	// deinit filesystem
@@ -0,0 +1,155 @@
+/*
+ *   This file is part of fastboot 3DS
+ *   Copyright (C) 2017 derrek, profi200
+ *
+ *   This program is free software: you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License as published by
+ *   the Free Software Foundation, either version 3 of the License, or
+ *   (at your option) any later version.
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "types.h"
+#include "arm11/menu/frame_stats.h"
+#include "arm11/menu/menu_color.h"
+#include "arm11/menu/menu_util.h"
+#include "arm11/config.h"
+#include "arm11/console.h"
+#include "arm11/fmt.h"
+#include "arm11/perf.h"
+#include "arm11/hardware/timer.h"
+#include "arm11/hardware/performance_monitor.h"
+
+
+// Same cycle counter setup as the IPC stats. See IPC_statsInit().
+#define CCNT_DIV              (64u)
+#define CYCLES_PER_US         ((u32)(TIMER_BASE_FREQ / 1000000))
+#define PMN_EVT_DCACHE_MISS   (0x0Bu)
+#define STAT_DCACHE_MISS      (FRAME_PHASES)
+#define STATS                 (FRAME_PHASES + 1)
+
+
+typedef struct
+{
+	u32 samples[STATS][FRAME_STATS_WINDOW];
+	u32 cur[FRAME_PHASES];
+	u32 lastCcnt;
+	u32 startPmn0;
+	u32 pos;
+	u32 count;
+	u32 frames;
+	bool enabled;
+} FrameStats;
+
+static FrameStats stats = {0};
+
+
+
+void frameStatsToggle(void)
+{
+	if(!configDataExist(KDevMode) || !(*(bool*)configGetData(KDevMode)))
+	{
+		stats.enabled = false;
+		return;
+	}
+
+	if(!stats.enabled)
+	{
+		// Count data cache misses in PMN0. Don't reset the cycle counter,
+		// the IPC stats take timestamps from it.
+		startProfiling(PMN_EVT_DCACHE_MISS<<8, 0, true, 0);
+		stats.pos = 0;
+		stats.count = 0;
+		stats.frames = 0;
+	}
+	stats.enabled = !stats.enabled;
+}
+
+bool frameStatsEnabled(void)
+{
+	return stats.enabled;
+}
+
+void frameStatsBeginFrame(void)
+{
+	if(!stats.enabled) return;
+
+	for(u32 i = 0; i < FRAME_PHASES; i++) stats.cur[i] = 0;
+	stats.startPmn0 = getPmn0();
+	stats.lastCcnt = getCcnt();
+}
+
+void frameStatsMark(FramePhase phase)
+{
+	if(!stats.enabled) return;
+
+	const u32 now = getCcnt();
+	stats.cur[phase] += now - stats.lastCcnt;
+	stats.lastCcnt = now;
+}
+
+static u32 cyclesToUs(u32 cycles)
+{
+	return (u32)(((u64)cycles * CCNT_DIV) / (CYCLES_PER_US * perfGetClockMul()));
+}
+
+static void drawOverlay(PrintConsole *con)
+{
+	u32 min[STATS], avg[STATS], max[STATS];
+	for(u32 s = 0; s < STATS; s++)
+	{
+		u32 lo = 0xFFFFFFFFu, hi = 0;
+		u64 sum = 0;
+		for(u32 i = 0; i < stats.count; i++)
+		{
+			const u32 val = stats.samples[s][i];
+			if(val < lo) lo = val;
+			if(val > hi) hi = val;
+			sum += val;
+		}
+		min[s] = lo;
+		avg[s] = (u32)(sum / stats.count);
+		max[s] = hi;
+	}
+
+	char line[96];
+	ee_snprintf(line, sizeof(line), "D %lu/%lu/%lu X %lu/%lu/%lu W %lu/%lu/%lu us M %lu/%lu/%lu",
+	            min[FRAME_PHASE_DRAW], avg[FRAME_PHASE_DRAW], max[FRAME_PHASE_DRAW],
+	            min[FRAME_PHASE_TRANSFER], avg[FRAME_PHASE_TRANSFER], max[FRAME_PHASE_TRANSFER],
+	            min[FRAME_PHASE_WAIT], avg[FRAME_PHASE_WAIT], max[FRAME_PHASE_WAIT],
+	            min[STAT_DCACHE_MISS], avg[STAT_DCACHE_MISS], max[STAT_DCACHE_MISS]);
+
+	// The last window row is kept free by menuShowDesc(). Stay off the
+	// last column so the console doesn't wrap and scroll.
+	PrintConsole *const prev = consoleSelect(con);
+	consoleSetCursor(con, 0, con->windowHeight - 1);
+	ee_printf(ESC_SCHEME_WEAK "%-*.*s" ESC_RESET, con->windowWidth - 1, con->windowWidth - 1, line);
+	consoleSelect(prev);
+
+	updateScreens();
+}
+
+void frameStatsEndFrame(PrintConsole *con, bool redraw)
+{
+	if(!stats.enabled) return;
+
+	const u32 pos = stats.pos;
+	for(u32 i = 0; i < FRAME_PHASES; i++) stats.samples[i][pos] = cyclesToUs(stats.cur[i]);
+	stats.samples[STAT_DCACHE_MISS][pos] = getPmn0() - stats.startPmn0;
+	stats.pos = (pos + 1 < FRAME_STATS_WINDOW ? pos + 1 : 0);
+	if(stats.count < FRAME_STATS_WINDOW) stats.count++;
+
+	// The overlay itself is drawn outside of the measured phases
+	if(redraw || ++stats.frames >= FRAME_STATS_REFRESH)
+	{
+		stats.frames = 0;
+		drawOverlay(con);
+	}
+}
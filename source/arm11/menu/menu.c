@@ -26,6 +26,7 @@
 #include "arm11/menu/battery.h"
 #include "arm11/menu/bootinfo.h"
 #include "arm11/menu/bootslot.h"
+#include "arm11/menu/frame_stats.h"
 #include "arm11/menu/menu.h"
 #include "arm11/menu/menu_util.h"
 #include "arm11/menu/menu_color.h"
@@ -73,7 +74,7 @@ void menuBuildDescString(char* desc, u32 flags, u32 index, const char* desc_raw)
 	else if (slot < N_BOOTSLOTS)
 	{
 		// get strings for path and keycombo
-		char slot_path_store[24+1];
+		char slot_path_store[24*4+1];
 		char* slot_path = NULL;
 		char* keycombo = NULL;
 		
@@ -264,17 +265,17 @@ void menuDraw(MenuInfo* curr_menu, PrintConsole* menu_con, u32 index)
 		char* name = entry->name;
 		bool is_selected = (i == index);
 		
-		char symbol = ' ';
+		const char* symbol;
 		if (curr_menu->flags & MENU_FLAG_CONFIG)
-			symbol = ((menu_preset >> i) & 0x1) ? '\xFB' : ' ';
+			symbol = ((menu_preset >> i) & 0x1) ? "\u221A" : " "; // square root as check mark
 		else
-			symbol = ((menu_preset >> i) & 0x1) ? '+' : '-';
+			symbol = ((menu_preset >> i) & 0x1) ? "+" : "-";
 		
 		consoleSetCursor(menu_con, menu_x, menu_y++);
 		// ee_printf(((menu_preset >> i) & 0x1) ? ESC_SCHEME_STD : ESC_SCHEME_WEAK);
 		ee_printf(ESC_SCHEME_STD);
 		if (is_selected) ee_printf(ESC_INVERT);
-		ee_printf("[%c] %-*.*s", symbol, MENU_WIDTH-4, MENU_WIDTH-4, name);
+		ee_printf("[%s] %-*.*s", symbol, MENU_WIDTH-4, MENU_WIDTH-4, name);
 		ee_printf(ESC_RESET);
 	}
 	
@@ -316,22 +317,36 @@ u32 menuProcess(PrintConsole* menu_con, PrintConsole* desc_con, MenuInfo* info)
 			getBatteryState(&battery);
 		
 		// update menu and description (on demand)
+		frameStatsBeginFrame();
+		bool redraw = false;
 		if ((index != last_index) || (curr_menu != last_menu) || (n_vblanks % 250 == 0)) {
 			menuDraw(curr_menu, menu_con, index);
 			menuShowDesc(curr_menu, desc_con, index);
 			last_index = index;
 			last_menu = curr_menu;
-			updateScreens(); // update screens (VBlank included)
-		} else GFX_waitForEvent(GFX_EVENT_PDC0, true); // VBlank
+			frameStatsMark(FRAME_PHASE_DRAW);
+			updateScreens();
+			frameStatsMark(FRAME_PHASE_TRANSFER);
+			redraw = true;
+		}
+		GFX_waitForEvent(GFX_EVENT_PDC0, true); // VBlank
+		frameStatsMark(FRAME_PHASE_WAIT);
+		frameStatsEndFrame(desc_con, redraw);
 		
 		hidScanInput();
 		const u32 kDown = hidKeysDown();
-		// const u32 kHeld = hidKeysHeld();
+		const u32 kHeld = hidKeysHeld();
 		
 		if (kDown & KEY_SHELL)
 		{
 			sleepmode();
 		}
+		else if ((kDown & KEY_Y) && (kHeld & KEY_SELECT))
+		{
+			// frame time overlay (dev mode only)
+			frameStatsToggle();
+			last_menu = NULL;
+		}
 		else if ((kDown & KEY_A) && (curr_menu->entries[index].function == NULL))
 		{
 			u32 next_menu_idx = curr_menu->entries[index].param;
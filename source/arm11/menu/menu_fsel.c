@@ -33,6 +33,8 @@
 #include "arm11/console.h"
 #include "arm11/debug.h"
 #include "arm11/fmt.h"
+#include "arm11/smp.h"
+#include "arm11/perf.h"
 
 #define MAX_DIR_ENTRIES	0x100 // 256 -> worst case approx 64kiB (yes, this is limited)
 #define N_DIR_READ		0x10  // 16 at a time
@@ -105,36 +107,87 @@ static void freeDirBufferContent(DirBufferEntry* dir_buffer, s32 n_entries)
 }
 
 
-static void sortDirBuffer(DirBufferEntry* dir_buffer, s32 n_entries)
+// dirs first, then case insensitive by name
+static bool dirEntryLess(const DirBufferEntry* a, const DirBufferEntry* b)
 {
-	for(s32 s = 0; s < n_entries; s++)
+	if(a->is_dir != b->is_dir)
+		return a->is_dir;
+	return strnicmp(a->fname, b->fname, FF_MAX_LFN + 1) < 0;
+}
+
+typedef struct {
+	DirBufferEntry* entries;
+	u32 n_entries;
+	u32 n_ranges;
+} DirSortJob;
+
+#define SORT_RANGE_START(job, r)	(((job)->n_entries * (r)) / (job)->n_ranges)
+
+// selection sorts each of the ranges [start, end), SMP job
+static void sortDirRanges(void* arg, u32 start, u32 end)
+{
+	const DirSortJob* job = (const DirSortJob*) arg;
+	
+	for(u32 r = start; r < end; r++)
 	{
-		DirBufferEntry* cmp0 = &(dir_buffer[s]);
-		DirBufferEntry* min0 = cmp0;
-		
-		for(s32 c = s + 1; c < n_entries; c++)
+		const u32 r_end = SORT_RANGE_START(job, r + 1);
+		for(u32 s = SORT_RANGE_START(job, r); s < r_end; s++)
 		{
-			DirBufferEntry* cmp1 = &(dir_buffer[c]);
-			if(min0->is_dir != cmp1->is_dir)
+			DirBufferEntry* cmp0 = &(job->entries[s]);
+			DirBufferEntry* min0 = cmp0;
+			
+			for(u32 c = s + 1; c < r_end; c++)
 			{
-				if (cmp1->is_dir)
+				DirBufferEntry* cmp1 = &(job->entries[c]);
+				if(dirEntryLess(cmp1, min0))
 					min0 = cmp1;
-				continue;
 			}
-			if(strnicmp(min0->fname, cmp1->fname, FF_MAX_LFN + 1) > 0)
+			
+			if(min0 != cmp0)
 			{
-				min0 = cmp1;
+				DirBufferEntry swap = *cmp0; // swap entries
+				*cmp0 = *min0;
+				*min0 = swap;
 			}
 		}
-		
-		if(min0 != cmp0)
+	}
+}
+
+// selection sort is O(n^2), so with more than one core the buffer is split
+// into one range per core, sorted in parallel and merged afterwards
+static void sortDirBuffer(DirBufferEntry* dir_buffer, s32 n_entries)
+{
+	DirSortJob job = { dir_buffer, n_entries, SMP_getNumCores() };
+	DirBufferEntry* merged = NULL;
+	
+	if((job.n_ranges > 1) && (n_entries >= 32))
+		merged = (DirBufferEntry*) malloc(n_entries * sizeof(DirBufferEntry));
+	if(!merged)
+		job.n_ranges = 1;
+	
+	SMP_parallelFor(job.n_ranges, 1, sortDirRanges, &job);
+	if(!merged)
+		return;
+	
+	u32 pos[job.n_ranges];
+	for(u32 r = 0; r < job.n_ranges; r++)
+		pos[r] = SORT_RANGE_START(&job, r);
+	
+	for(s32 n = 0; n < n_entries; n++)
+	{
+		u32 best = job.n_ranges;
+		for(u32 r = 0; r < job.n_ranges; r++)
 		{
-			DirBufferEntry swap; // swap entries
-			memcpy(&swap, cmp0, sizeof(DirBufferEntry));
-			memcpy(cmp0, min0, sizeof(DirBufferEntry));
-			memcpy(min0, &swap, sizeof(DirBufferEntry));
+			if(pos[r] == SORT_RANGE_START(&job, r + 1))
+				continue;
+			if((best == job.n_ranges) || dirEntryLess(&(dir_buffer[pos[r]]), &(dir_buffer[pos[best]])))
+				best = r;
 		}
+		merged[n] = dir_buffer[pos[best]++];
 	}
+	
+	memcpy(dir_buffer, merged, n_entries * sizeof(DirBufferEntry));
+	free(merged);
 }
 
 
@@ -152,10 +205,11 @@ static s32 readDirToBuffer(DirBufferEntry* dir_buffer, const char* path, const c
 		const char* firm_paths[] = { "firm1:" };
 		const u32 firm_size = 0x400000; // 4MB
 		bool devmode = configDataExist(KDevMode) && (*(bool*) configGetData(KDevMode));
+		u32 mounted = fsEnsureMountedPaths(root_paths, sizeof(root_paths) / sizeof(const char*));
 		
 		for(u32 i = 0; i < sizeof(root_paths) / sizeof(const char*); i++)
 		{
-			if (!fsEnsureMounted(root_paths[i]))
+			if (!(mounted & (1u<<i)))
 			 	continue;
 			
 			dir_buffer[n_entries].fsize = 0;
@@ -181,19 +235,29 @@ static s32 readDirToBuffer(DirBufferEntry* dir_buffer, const char* path, const c
 		return n_entries;
 	}
 
-	// open directory
-	s32 dhandle = fOpenDir(path);
-	if(dhandle < 0) return -1;
-    
 	FsFileInfo* finfo = (FsFileInfo*) malloc(N_DIR_READ * sizeof(FsFileInfo));
 	if (!finfo) // out of memory
+		return -1;
+	
+	// open directory and read the first entries in a single round trip
+	FsBatchOp ops[2];
+	memset(ops, 0, sizeof(ops));
+	ops[0].type = FS_BATCH_OPEN_DIR;
+	ops[0].path = path;
+	ops[0].pathSize = strlen(path) + 1;
+	ops[1].type = FS_BATCH_READ_DIR;
+	ops[1].arg = FS_BATCH_PREV_RESULT;
+	ops[1].out = finfo;
+	ops[1].outSize = N_DIR_READ * sizeof(FsFileInfo);
+	
+	if ((fBatch(ops, 2) < 0) || (ops[0].result < 0))
 	{
-		fCloseDir(dhandle);
-		return -1; 
+		free(finfo);
+		return -1;
 	}
-        
-	s32 n_read = 0;
-	while((n_read = fReadDir(dhandle, finfo, N_DIR_READ)) != 0)
+	
+	s32 dhandle = ops[0].result;
+	for(s32 n_read = ops[1].result; n_read != 0; n_read = fReadDir(dhandle, finfo, N_DIR_READ))
 	{
 		if (n_read < 0) // error reading dir
 			goto fail;
@@ -226,7 +290,11 @@ static s32 readDirToBuffer(DirBufferEntry* dir_buffer, const char* path, const c
 	free(finfo);
 	
 	if (n_entries > 0)
+	{
+		perfBoostBegin("dir sort");
 		sortDirBuffer(dir_buffer, n_entries);
+		perfBoostEnd();
+	}
 	
 	return n_entries;
 	
@@ -252,7 +320,7 @@ void browserDraw(const char* curr_path, DirBufferEntry* dir_buffer, s32 n_entrie
 {
 	int brws_x = (menu_con->windowWidth - BRWS_WIDTH) >> 1;
 	int brws_y = BRWS_OFFSET_TITLE;
-	char temp_str[BRWS_WIDTH + 1];
+	char temp_str[BRWS_WIDTH * 4 + 1];
 	char byte_str[32];
 	
 	// fix scroll (if required)
@@ -271,7 +339,7 @@ void browserDraw(const char* curr_path, DirBufferEntry* dir_buffer, s32 n_entrie
 	// browser title
 	consoleSetCursor(menu_con, brws_x, brws_y++);
 	truncateString(temp_str, *curr_path ? curr_path : "root", BRWS_WIDTH, 8);
-	ee_printf(ESC_SCHEME_ACCENT1 "%-*s" ESC_RESET, BRWS_WIDTH, temp_str);
+	ee_printf(ESC_SCHEME_ACCENT1 "%s%*s" ESC_RESET, temp_str, BRWS_WIDTH - (int) stringGetWidth(temp_str), "");
 	brws_y++;
 	
 	// menu entries
@@ -295,7 +363,7 @@ void browserDraw(const char* curr_path, DirBufferEntry* dir_buffer, s32 n_entrie
 		truncateString(temp_str, entry->fname, BRWS_WIDTH-13, 8);
 		ee_printf(entry->is_dir ? ESC_SCHEME_WEAK : ESC_SCHEME_STD);
 		if (is_selected)ee_printf(ESC_INVERT);
-		ee_printf(" %-*.*s %10.10s ", BRWS_WIDTH-13, BRWS_WIDTH-13, temp_str, byte_str);
+		ee_printf(" %s%*s %10.10s ", temp_str, BRWS_WIDTH-13 - (int) stringGetWidth(temp_str), "", byte_str);
 		ee_printf(ESC_RESET);
 	}
 	
@@ -401,8 +469,9 @@ bool menuFileSelector(char* res_path, PrintConsole* menu_con, const char* start,
 			if (index != last_index) {
 				browserDraw(res_path, dir_buffer, n_entries, menu_con, index, &scroll);
 				last_index = index;
-				updateScreens(); // update screens (VBlank included)
-			} else GFX_waitForEvent(GFX_EVENT_PDC0, true); // VBlank
+				updateScreens();
+			}
+			GFX_waitForEvent(GFX_EVENT_PDC0, true); // VBlank
 			
 			// directional button cooldown
 			for (u32 i = dbutton_cooldown; i > 0; i--)
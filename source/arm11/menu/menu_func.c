@@ -32,6 +32,7 @@
 #include "arm11/menu/menu_fsel.h"
 #include "arm11/menu/menu_func.h"
 #include "arm11/menu/menu_util.h"
+#include "arm11/menu/nandtune.h"
 #include "arm11/hardware/hid.h"
 #include "arm11/hardware/mcu.h"
 #include "arm11/console.h"
@@ -39,15 +40,50 @@
 #include "arm11/debug.h"
 #include "arm11/fmt.h"
 #include "arm11/firm.h"
+#include "arm11/ipc_stats.h"
+#include "arm11/perf.h"
+#include "hardware/pxi.h"
 
 
 
+// partitions selectable for partition backups, see menu_fb3ds.h
+static const char* const nandPartTargets[N_NAND_PART_TARGETS] = { "firm0", "firm1", "nand", "twln" };
+static const char* const nandPartNames[N_NAND_PART_TARGETS] = { "FIRM0", "FIRM1", "CTRNAND", "TWLN" };
+
+
 #define PRESET_SLOT_CONFIG_FUNC(x) \
 u32 menuPresetSlotConfig##x(void) \
 { \
 	return menuPresetSlotConfig((x-1)); \
 }
 
+// waits for a queued firm load / write, showing its progress on the next line
+// the ARM9 can't be interrupted, so cancel is forbidden(!) here and a force
+// poweroff is only handled once the command is done
+// returns true on force poweroff, the command result is stored in res
+static bool waitFirmCmd(const char* desc, u32 ticket, s32* res)
+{
+	bool poweroff = false;
+	u32 cmdRes;
+	
+	ee_printf("\x1b[s\n"); // save cursor
+	while (!PXI_pollCmd(ticket, &cmdRes))
+	{
+		u32 done, total;
+		PXI_getProgress(ticket, &done, &total);
+		ee_printf_progress(desc, PROGRESS_WIDTH, done, total);
+		updateScreens();
+		GFX_waitForEvent(GFX_EVENT_PDC0, true); // VBlank
+		
+		if (userCancelHandler(false))
+			poweroff = true;
+	}
+	ee_printf("\r%60.60s\r\x1b[u", ""); // delete progress line, restore cursor
+	
+	*res = (s32) cmdRes;
+	return poweroff;
+}
+
 u32 menuPresetNandTools(void)
 {
 	u32 res = 0xFF;
@@ -58,6 +94,16 @@ u32 menuPresetNandTools(void)
 	return res;
 }
 
+u32 menuPresetMisc(void)
+{
+	u32 res = 0xFF;
+	
+	if (!configDataExist(KDevMode) || !(*(bool*) configGetData(KDevMode)))
+		res &= ~(1 << 2); // disable IPC statistics
+	
+	return res;
+}
+
 u32 menuPresetBootMenu(void)
 {
 	u32 res = 0xFF;
@@ -303,7 +349,10 @@ u32 menuLaunchFirm(PrintConsole* term_con, PrintConsole* menu_con, u32 param)
 	
 	// try load and verify
 	ee_printf("\nLoading %s...\n", path);
-	s32 res = loadVerifyFirm(path, false);
+	updateScreens();
+	s32 res;
+	if (waitFirmCmd("Loading", loadVerifyFirmAsync(path, false), &res))
+		return MENU_FAIL; // force poweroff
 	if (res < 0)
 	{
 		ee_printf("Firm %s error code %li!\n", (res > -8) ? "load" : "verify", res);
@@ -327,12 +376,224 @@ u32 menuLaunchFirm(PrintConsole* term_con, PrintConsole* menu_con, u32 param)
 	return MENU_FAIL;
 }
 
+// checkpoint journals for resuming NAND backups / restores
+#define NAND_BACKUP_JOURNAL		NAND_BACKUP_PATH "/backup.jnl"
+#define NAND_RESTORE_JOURNAL	NAND_BACKUP_PATH "/restore.jnl"
+#define NAND_JOURNAL_MAGIC		0x4C4A4246 // "FBJL"
+#define NAND_JOURNAL_FORCED		(1u<<0)
+#define NAND_JOURNAL_HASHED		(1u<<1) // hash is valid
+
+typedef struct {
+	u32 magic;
+	u32 size;					// total size of the transfer
+	u32 done;					// bytes safely transferred
+	u32 flags;
+	u32 cid[4];					// CID of the NAND the journal belongs to
+	FsHashState hash;			// image hash state at done
+	char fpath[FF_MAX_LFN + 1];	// NAND image on SD
+} NandJournal;
+
+// journals only apply to the NAND they were written for, cid is NULL if unknown
+static bool readNandJournal(const char* jpath, NandJournal* jnl, const u32* cid)
+{
+	if (!cid || !fsQuickRead(jpath, jnl, sizeof(NandJournal), 0) ||
+		(jnl->magic != NAND_JOURNAL_MAGIC) || (jnl->done > jnl->size) ||
+		(jnl->done % 0x200) || (memcmp(jnl->cid, cid, sizeof(jnl->cid)) != 0))
+		return false;
+	
+	jnl->fpath[FF_MAX_LFN] = '\0';
+	return true;
+}
+
+// transfer directions for nandTransfer()
+#define NAND_TRANSFER_BACKUP	0 // NAND -> file
+#define NAND_TRANSFER_RESTORE	1 // file -> NAND
+#define NAND_TRANSFER_VERIFY	2 // file -> device buffer only
+
+// draws the throughput line above and the progress bar on the current line
+static void printTransferProgress(const char* desc, u32 curr, u32 size, const NandStats* stats)
+{
+	char str[64];
+	
+	nandStatsFormat(stats, size - curr, str, sizeof(str));
+	ee_printf(ESC_CUR_UP "\r%-60.60s\n", str);
+	ee_printf_progress(desc, PROGRESS_WIDTH, curr, size);
+}
+
+// streams size bytes through the device buffer, starting at jnl->done
+// and checkpointing to the journal every NAND_JOURNAL_STEP if jnl is set
+// (verify only starts at jnl->done, it has nothing to checkpoint)
+// per stage timings are appended to <fpath>.log on success if fpath is set
+// returns 0 on success, 1 if canceled by the user and < 0 on error
+static s32 nandTransferLoop(const char* desc, u32 mode, s32 fHandle, u32 fOffset,
+	s32 devHandle, u32 devOffset, u32 size, NandTuner* tune, NandJournal* jnl,
+	const char* fpath)
+{
+	const s32 dbufHandle = tune->dbufHandle;
+	const bool toNand = (mode == NAND_TRANSFER_RESTORE);
+	const s32 srcHandle = (mode == NAND_TRANSFER_BACKUP) ? devHandle : fHandle;
+	const u32 srcOffset = (mode == NAND_TRANSFER_BACKUP) ? devOffset : fOffset;
+	const s32 dstHandle = toNand ? devHandle : fHandle;
+	const u32 dstOffset = toNand ? devOffset : fOffset;
+	
+	const char* jpath = toNand ? NAND_RESTORE_JOURNAL : NAND_BACKUP_JOURNAL;
+	u32 checkpoint = jnl ? jnl->done + NAND_JOURNAL_STEP : 0;
+	
+	NandStats stats;
+	u32 readBytes;
+	
+	nandStatsInit(&stats);
+	ee_printf("\n\n");
+	for (u32 p = jnl ? jnl->done : 0; p < size; p += readBytes)
+	{
+		readBytes = (size - p > tune->chunkSize) ? tune->chunkSize : size - p;
+		s32 errcode = 0;
+		nandTuneChunkStart();
+		printTransferProgress(desc, p, size, &stats);
+		updateScreens();
+		
+		const u32 readStart = nandTuneTicks();
+		if ((errcode = fReadToDeviceBuffer(srcHandle, srcOffset + p, readBytes, dbufHandle)) != 0)
+		{
+			ee_printf("\nError: Cannot read from %s (%li)!\n", toNand || (mode == NAND_TRANSFER_VERIFY) ? "file" : "NAND", errcode);
+			return errcode;
+		}
+		
+		const u32 writeStart = nandTuneTicks();
+		if ((mode != NAND_TRANSFER_VERIFY) &&
+			((errcode = fsWriteFromDeviceBuffer(dstHandle, dstOffset + p, readBytes, dbufHandle)) != 0))
+		{
+			ee_printf("\nError: Cannot write to %s (%li)!\n", toNand ? "NAND" : "file", errcode);
+			return errcode;
+		}
+		
+		const u32 chunkEnd = nandTuneTicks();
+		nandTuneChunkEnd(tune, readBytes, chunkEnd);
+		nandStatsUpdate(&stats, readBytes, writeStart - readStart,
+			(mode != NAND_TRANSFER_VERIFY) ? chunkEnd - writeStart : 0, chunkEnd);
+		
+		// everything up to here is safe, write a checkpoint
+		if (jnl && (mode != NAND_TRANSFER_VERIFY) && (p + readBytes >= checkpoint) && (p + readBytes < size))
+		{
+			if (toNand || (fSync(fHandle) == 0))
+			{
+				if ((jnl->flags & NAND_JOURNAL_HASHED) &&
+					(fSaveDeviceBufferHash(dbufHandle, &jnl->hash) != 0))
+					jnl->flags &= ~NAND_JOURNAL_HASHED;
+				jnl->done = p + readBytes;
+				fsQuickWrite(jpath, jnl, sizeof(NandJournal));
+			}
+			checkpoint = p + readBytes + NAND_JOURNAL_STEP;
+		}
+		
+		// check for user cancel request
+		// cancel is forbidden(!) while writing NAND, but we need to handle force poweroff
+		if (userCancelHandler(!toNand))
+			return 1;
+	}
+	
+	printTransferProgress(desc, size, size, &stats);
+	
+	if (fpath)
+	{
+		char lpath[FF_MAX_LFN + 1];
+		ee_snprintf(lpath, sizeof(lpath), "%s.log", fpath);
+		nandStatsWriteLog(&stats, lpath, desc);
+	}
+	
+	return 0;
+}
+
+// runs nandTransferLoop() with the CPU clock boosted
+static s32 nandTransfer(const char* desc, u32 mode, s32 fHandle, u32 fOffset,
+	s32 devHandle, u32 devOffset, u32 size, NandTuner* tune, NandJournal* jnl,
+	const char* fpath)
+{
+	perfBoostBegin(desc);
+	const s32 res = nandTransferLoop(desc, mode, fHandle, fOffset, devHandle, devOffset,
+		size, tune, jnl, fpath);
+	perfBoostEnd();
+	
+	return res;
+}
+
+static void printTuneInfo(const NandTuner* tune)
+{
+	if (tune->tuning)
+		ee_printf("Buffer size: %lu kiB (autotuning)\n", tune->bufSize / 0x400);
+	else ee_printf("Buffer size: %lu kiB (%lu kiB chunks)\n", tune->bufSize / 0x400, tune->chunkSize / 0x400);
+	updateScreens();
+}
+
+// writes a sha256sum compatible sidecar next to the image
+static bool writeHashSidecar(const char* fpath, const u8* hash)
+{
+	char shaPath[FF_MAX_LFN + 5];
+	char line[64 + 2 + FF_MAX_LFN + 2];
+	const char* fname = strrchr(fpath, '/');
+	
+	fname = fname ? fname + 1 : fpath;
+	ee_snprintf(shaPath, sizeof(shaPath), "%s.sha", fpath);
+	for (u32 i = 0; i < 32; i++)
+		ee_snprintf(line + (i * 2), 3, "%02x", hash[i]);
+	u32 len = 64 + ee_snprintf(line + 64, sizeof(line) - 64, "  %s\n", fname);
+	
+	return fsQuickWrite(shaPath, line, len);
+}
+
+// reads the hash from an image sidecar, false if there is none
+static bool readHashSidecar(const char* fpath, u8* hash)
+{
+	char shaPath[FF_MAX_LFN + 5];
+	char hex[64];
+	
+	ee_snprintf(shaPath, sizeof(shaPath), "%s.sha", fpath);
+	if (!fsQuickRead(shaPath, hex, 64, 0))
+		return false;
+	
+	for (u32 i = 0; i < 64; i++)
+	{
+		char c = hex[i];
+		u8 nibble;
+		if ((c >= '0') && (c <= '9')) nibble = c - '0';
+		else if ((c >= 'a') && (c <= 'f')) nibble = c - 'a' + 10;
+		else if ((c >= 'A') && (c <= 'F')) nibble = c - 'A' + 10;
+		else return false;
+		
+		if (i & 1) hash[i >> 1] |= nibble;
+		else hash[i >> 1] = nibble << 4;
+	}
+	
+	return true;
+}
+
+// builds a backup filename from the RTC and the console serial
+static void makeBackupPath(char* fpath, u32 len, const char* suffix)
+{
+	// console serial number
+	char serial[0x10] = { 0 }; // serial from SecureInfo_?
+	if (!fsQuickRead("nand:/rw/sys/SecureInfo_A", serial, 0xF, 0x102) && 
+		!fsQuickRead("nand:/rw/sys/SecureInfo_B", serial, 0xF, 0x102))
+		ee_snprintf(serial, 0x10, "UNKNOWN");
+	
+	// current state of the RTC
+	u8 rtc[8] = { 0 };
+	MCU_readRTC(rtc);
+	
+	ee_snprintf(fpath, len, NAND_BACKUP_PATH "/%02X%02X%02X%02X%02X%02X_%s_%s",
+		rtc[6], rtc[5], rtc[4], rtc[2], rtc[1], rtc[0], serial, suffix);
+}
+
 u32 menuBackupNand(PrintConsole* term_con, PrintConsole* menu_con, u32 param)
 {
 	(void) menu_con;
 	(void) param;
 	s32 error = 0;
 	u32 result = MENU_FAIL;
+	NandJournal jnl;
+	bool resume = false;
+	
+	memset(&jnl, 0, sizeof(jnl));
 	
 	// select & clear console
 	consoleSelect(term_con);
@@ -350,43 +611,53 @@ u32 menuBackupNand(PrintConsole* term_con, PrintConsole* menu_con, u32 param)
 	const s64 nand_size = fGetDeviceSize(FS_DEVICE_NAND) * 0x200;
 	if (!nand_size) panicMsg("NAND size is zero");
 	
+	// identifies this console's NAND in the journal
+	u32 nand_cid[4];
+	const bool have_cid = (fGetDeviceCid(FS_DEVICE_NAND, nand_cid) == 0);
 	
-	// console serial number
-	char serial[0x10] = { 0 }; // serial from SecureInfo_?
-	if (!fsQuickRead("nand:/rw/sys/SecureInfo_A", serial, 0xF, 0x102) && 
-		!fsQuickRead("nand:/rw/sys/SecureInfo_B", serial, 0xF, 0x102))
-		ee_snprintf(serial, 0x10, "UNKNOWN");
 	
-	// current state of the RTC
-	u8 rtc[8] = { 0 };
-	MCU_readRTC(rtc);
+	// check for an interrupted backup of this NAND
+	if (readNandJournal(NAND_BACKUP_JOURNAL, &jnl, have_cid ? nand_cid : NULL) &&
+		(jnl.size == nand_size))
+	{
+		resume = askConfirmation("Found an interrupted NAND backup:\n%s\n \n%lu of %lu MiB are done.\nResume this backup?",
+			jnl.fpath, jnl.done / 0x100000, jnl.size / 0x100000);
+		consoleClear();
+		if (!resume) fUnlink(jnl.fpath);
+	}
+	if (!resume) fUnlink(NAND_BACKUP_JOURNAL);
 	
 	// create NAND backup filename
-	char fpath[64];
-	ee_snprintf(fpath, 64, NAND_BACKUP_PATH "/%02X%02X%02X%02X%02X%02X_%s_nand.bin",
-		rtc[6], rtc[5], rtc[4], rtc[2], rtc[1], rtc[0], serial);
+	if (!resume)
+	{
+		memset(&jnl, 0, sizeof(jnl));
+		jnl.magic = NAND_JOURNAL_MAGIC;
+		jnl.size = nand_size;
+		if (have_cid) memcpy(jnl.cid, nand_cid, sizeof(jnl.cid));
+		makeBackupPath(jnl.fpath, 64, "nand.bin");
+	}
+	const char* fpath = jnl.fpath;
 	
-	ee_printf(ESC_SCHEME_ACCENT1 "Creating NAND backup:\n%s\n" ESC_RESET "\nPreparing NAND backup...\n", fpath);
+	ee_printf(ESC_SCHEME_ACCENT1 "%s NAND backup:\n%s\n" ESC_RESET "\nPreparing NAND backup...\n",
+		resume ? "Resuming" : "Creating", fpath);
 	updateScreens();
 	
 	
 	// open file handle
 	s32 fHandle;
-	if (!fsCreateFileWithPath(fpath) ||
-		((fHandle = fOpen(fpath, FS_OPEN_EXISTING | FS_OPEN_WRITE)) < 0))
+	if ((!resume && !fsCreateFileWithPath(fpath)) ||
+		((fHandle = fOpen(fpath, FS_OPEN_EXISTING | FS_OPEN_READ | FS_OPEN_WRITE)) < 0))
 	{
-		ee_printf("Cannot create file!\n");
+		ee_printf("Cannot %s file!\n", resume ? "open" : "create");
 		goto fail;
 	}
 	
 	// reserve space for NAND backup
-	ee_printf("NAND size: %lli MiB\nBuffer size: %lu kiB\nReserving space...\n",
-		nand_size / 0x0100000, (u32) DEVICE_BUFSIZE / 0x400);
+	ee_printf("NAND size: %lli MiB\nReserving space...\n", nand_size / 0x0100000);
 	updateScreens();
 	if ((fLseek(fHandle, nand_size) != 0) || (fTell(fHandle) != nand_size))
 	{
 		fClose(fHandle);
-		fUnlink(fpath);
 		ee_printf("Not enough space!\n");
 		goto fail;
 	}
@@ -397,51 +668,57 @@ u32 menuBackupNand(PrintConsole* term_con, PrintConsole* menu_con, u32 param)
 	if (devHandle < 0)
 	{
 		fClose(fHandle);
-		fUnlink(fpath);
 		ee_printf("Cannot open NAND device (error %li)!\n", devHandle);
 		goto fail;
 	}
 	
 	// setup device buffer
-	s32 dbufHandle = fCreateDeviceBuffer(DEVICE_BUFSIZE);
+	NandTuner tune;
+	s32 dbufHandle = nandTuneInit(&tune);
 	if (dbufHandle < 0)
 		panicMsg("Out of memory");
+	printTuneInfo(&tune);
+	
+	// hash everything we read from NAND, when resuming continue
+	// the hash from the journal or hash the part on SD again
+	s32 res = 0;
+	if (!resume || !(jnl.flags & NAND_JOURNAL_HASHED) ||
+		(fResumeDeviceBufferHash(dbufHandle, &jnl.hash) != 0))
+	{
+		if (fStartDeviceBufferHash(dbufHandle) != 0)
+			panicMsg("Cannot start NAND hash");
+		if (resume)
+			res = nandTransfer("Rehashing", NAND_TRANSFER_VERIFY, fHandle, 0, devHandle, 0, jnl.done, &tune, NULL, NULL);
+	}
+	jnl.flags |= NAND_JOURNAL_HASHED;
 	
 	
 	// all done, ready to do the NAND backup
-	ee_printf("\n");
-	for (s64 p = 0; p < nand_size; p += DEVICE_BUFSIZE)
+	if (!res)
+		res = nandTransfer("NAND backup", NAND_TRANSFER_BACKUP, fHandle, 0, devHandle, 0, nand_size, &tune, &jnl, fpath);
+	if (res < 0) goto fail_close_handles;
+	else if (res > 0) // canceled by user
 	{
-		s64 readBytes = (nand_size - p > DEVICE_BUFSIZE) ? DEVICE_BUFSIZE : nand_size - p;
-		s32 errcode = 0;
-		ee_printf_progress("NAND backup", PROGRESS_WIDTH, p, nand_size);
-		updateScreens();
-		
-		if ((errcode = fReadToDeviceBuffer(devHandle, p, readBytes, dbufHandle)) != 0)
-		{
-			ee_printf("\nError: Cannot read from NAND (%li)!\n", errcode);
-			goto fail_close_handles;
-		}
-		
-		if ((errcode = fsWriteFromDeviceBuffer(fHandle, p, readBytes, dbufHandle)) != 0)
-		{
-			ee_printf("\nError: Cannot write to file (%li)!\n", errcode);
-			goto fail_close_handles;
-		}
-		
-		// check for user cancel request
-		if (userCancelHandler(true))
+		fFinalizeRawAccess(devHandle);
+		fFreeDeviceBuffer(dbufHandle);
+		fClose(fHandle);
+		if (!jnl.done)
 		{
-			fFinalizeRawAccess(devHandle);
-			fFreeDeviceBuffer(dbufHandle);
-			fClose(fHandle);
+			fUnlink(NAND_BACKUP_JOURNAL);
 			fUnlink(fpath);
-			return MENU_FAIL;
 		}
+		return MENU_FAIL;
+	}
+	
+	// store the image hash in a sidecar file
+	u32 hash[8];
+	if ((fGetDeviceBufferHash(dbufHandle, hash) != 0) ||
+		!writeHashSidecar(fpath, (u8*) hash))
+	{
+		ee_printf("\nError: Cannot write hash file!\n");
+		goto fail_close_handles;
 	}
 	
-	// NAND access finalized
-	ee_printf_progress("NAND backup", PROGRESS_WIDTH, nand_size, nand_size);
 	ee_printf("\n" ESC_SCHEME_GOOD "NAND backup finished.\n" ESC_RESET);
 	result = MENU_OK;
 	
@@ -456,12 +733,21 @@ u32 menuBackupNand(PrintConsole* term_con, PrintConsole* menu_con, u32 param)
 	
 	fail:
 	
+	// keep partial backups with a checkpoint around for resuming
+	if ((result != MENU_OK) && jnl.done)
+		ee_printf("\nBackup can be resumed from %lu MiB.\n", jnl.done / 0x100000);
+	
 	ee_printf("\nPress B or HOME to return.");
 	updateScreens();
 	outputEndWait();
 
 	
-	if (result != MENU_OK) fUnlink(fpath);
+	if (result == MENU_OK) fUnlink(NAND_BACKUP_JOURNAL);
+	else if (!jnl.done && *jnl.fpath)
+	{
+		fUnlink(NAND_BACKUP_JOURNAL);
+		fUnlink(jnl.fpath);
+	}
 	hidScanInput(); // throw away any input from impatient users
 	return result;
 }
@@ -471,6 +757,8 @@ u32 menuRestoreNand(PrintConsole* term_con, PrintConsole* menu_con, u32 param)
 	bool forced = param; // if param != 0 -> forced restore
 	s32 error = 0;
 	u32 result = MENU_FAIL;
+	NandJournal jnl;
+	bool resume = false;
 	
 	
 	// select & clear console
@@ -502,37 +790,60 @@ u32 menuRestoreNand(PrintConsole* term_con, PrintConsole* menu_con, u32 param)
 	const s64 nand_size = fGetDeviceSize(FS_DEVICE_NAND) * 0x200;
 	if (!nand_size) panicMsg("NAND size is zero");
 	
+	// identifies this console's NAND in the journal
+	u32 nand_cid[4];
+	const bool have_cid = (fGetDeviceCid(FS_DEVICE_NAND, nand_cid) == 0);
 	
-	ee_printf_screen_center("Select a NAND backup for restore.\nPress [HOME] to cancel.");
-	updateScreens();
-	
-	char fpath[FF_MAX_LFN + 1];
-	if (!menuFileSelector(fpath, menu_con, NAND_BACKUP_PATH, "*.bin", false))
-		return MENU_FAIL; // canceled by user
-	
-	// select & clear console
-	consoleSelect(term_con);
-	consoleClear();
 	
-	// ask the user for confirmation
-	if (forced)
+	// an interrupted restore leaves NAND half written, offer to finish it
+	// (only on the same console and in the same mode it was started in)
+	if (readNandJournal(NAND_RESTORE_JOURNAL, &jnl, have_cid ? nand_cid : NULL) && (jnl.size <= nand_size) &&
+		((jnl.flags & NAND_JOURNAL_FORCED) == (forced ? NAND_JOURNAL_FORCED : 0)))
 	{
-		if (!askConfirmation(ESC_SCHEME_BAD "WARNING:" ESC_RESET "\nYou're about to force-restore a NAND image to\nyour system. Doing this with an incompatible\nNAND image will **BRICK** your console! Make\nsure you backed up your important data!")) return MENU_FAIL;
+		resume = askConfirmation(ESC_SCHEME_BAD "WARNING:" ESC_RESET "\nA NAND restore was interrupted:\n%s\n \n%lu of %lu MiB are done.\nResume this restore?",
+			jnl.fpath, jnl.done / 0x100000, jnl.size / 0x100000);
+		consoleClear();
+		if (!resume) fUnlink(NAND_RESTORE_JOURNAL);
 	}
-	else
+	
+	char fpath[FF_MAX_LFN + 1];
+	if (resume)
 	{
-		if (!askConfirmation(ESC_SCHEME_BAD "WARNING:" ESC_RESET "\nYou're about to restore a NAND image to\nyour system. Make sure you have backups of\nyour important data!")) return MENU_FAIL; 
+		strncpy(fpath, jnl.fpath, FF_MAX_LFN + 1);
 	}
-	consoleClear();
-	
-	// check NAND backup (when not forced)
-	if (!forced && (fVerifyNandImage(fpath) != 0))
+	else
 	{
-		ee_printf("%s\nNot a valid NAND backup for this 3DS!\n", fpath);
-		goto fail;
+		ee_printf_screen_center("Select a NAND backup for restore.\nPress [HOME] to cancel.");
+		updateScreens();
+		
+		if (!menuFileSelector(fpath, menu_con, NAND_BACKUP_PATH, "*.bin", false))
+			return MENU_FAIL; // canceled by user
+		
+		// select & clear console
+		consoleSelect(term_con);
+		consoleClear();
+		
+		// ask the user for confirmation
+		if (forced)
+		{
+			if (!askConfirmation(ESC_SCHEME_BAD "WARNING:" ESC_RESET "\nYou're about to force-restore a NAND image to\nyour system. Doing this with an incompatible\nNAND image will **BRICK** your console! Make\nsure you backed up your important data!")) return MENU_FAIL;
+		}
+		else
+		{
+			if (!askConfirmation(ESC_SCHEME_BAD "WARNING:" ESC_RESET "\nYou're about to restore a NAND image to\nyour system. Make sure you have backups of\nyour important data!")) return MENU_FAIL; 
+		}
+		consoleClear();
+		
+		// check NAND backup (when not forced)
+		if (!forced && (fVerifyNandImage(fpath) != 0))
+		{
+			ee_printf("%s\nNot a valid NAND backup for this 3DS!\n", fpath);
+			goto fail;
+		}
 	}
 	
-	ee_printf(ESC_SCHEME_ACCENT1 "Restoring NAND backup:\n%s\n" ESC_RESET "\nPreparing NAND restore...\n", fpath);
+	ee_printf(ESC_SCHEME_ACCENT1 "%s NAND backup:\n%s\n" ESC_RESET "\nPreparing NAND restore...\n",
+		resume ? "Resuming restore of" : "Restoring", fpath);
 	updateScreens();
 	
 	
@@ -549,28 +860,73 @@ u32 menuRestoreNand(PrintConsole* term_con, PrintConsole* menu_con, u32 param)
 	if (devHandle < 0)
 	{
 		fClose(fHandle);
-		fUnlink(fpath);
 		ee_printf("Cannot open NAND device (error %li)!\n", devHandle);
 		goto fail;
 	}
 	
 	// setup device buffer
-	s32 dbufHandle = fCreateDeviceBuffer(DEVICE_BUFSIZE);
+	NandTuner tune;
+	s32 dbufHandle = nandTuneInit(&tune);
 	if (dbufHandle < 0)
 		panicMsg("Out of memory");
+	printTuneInfo(&tune);
 	
 	
 	// check file size
 	const s64 file_size = fSize(fHandle);
 	ee_printf("File size: %lli MiB\n", file_size / 0x100000);
 	ee_printf("NAND size: %lli MiB\n", nand_size / 0x100000);
-	ee_printf("Buffer size: %lu kiB\n", (u32) DEVICE_BUFSIZE / 0x400);
 	updateScreens();
 	if (file_size > nand_size)
 	{
 		ee_printf("Size exceeds available space!\n");
 		goto fail_close_handles;
 	}
+	if (resume && (file_size != jnl.size))
+	{
+		ee_printf("NAND backup changed since the restore was started!\n");
+		goto fail_close_handles;
+	}
+	
+	
+	// verify the image against its hash before writing anything
+	// a resumed restore continues the hash of the part already on NAND
+	// from the journal and only needs to read the rest of the image
+	u8 expectedHash[32];
+	const bool have_hash = readHashSidecar(fpath, expectedHash);
+	s32 res;
+	if (resume)
+		ee_printf("Continuing at %lu MiB.\n", jnl.done / 0x100000);
+	if (have_hash)
+	{
+		u32 hash[8];
+		
+		const bool cont = resume && (jnl.flags & NAND_JOURNAL_HASHED) &&
+			(fResumeDeviceBufferHash(dbufHandle, &jnl.hash) == 0);
+		if (!cont && (fStartDeviceBufferHash(dbufHandle) != 0))
+		{
+			ee_printf("Cannot start NAND backup hash!\n");
+			goto fail_close_handles;
+		}
+		res = nandTransfer("Verifying", NAND_TRANSFER_VERIFY, fHandle, 0, devHandle, 0, file_size, &tune, cont ? &jnl : NULL, fpath);
+		if (res < 0) goto fail_close_handles;
+		else if (res > 0) // canceled by user, nothing written yet
+		{
+			fFinalizeRawAccess(devHandle);
+			fFreeDeviceBuffer(dbufHandle);
+			fClose(fHandle);
+			return MENU_FAIL;
+		}
+		
+		if ((fGetDeviceBufferHash(dbufHandle, hash) != 0) ||
+			(memcmp(hash, expectedHash, 32) != 0))
+		{
+			ee_printf("\nError: NAND backup hash mismatch!\nThe image is corrupted or truncated.\n");
+			goto fail_close_handles;
+		}
+		ee_printf("\nNAND backup hash verified.\n");
+	}
+	else ee_printf("No hash file found, skipping verification.\n");
 	
 	
 	// setup NAND protection
@@ -580,41 +936,369 @@ u32 menuRestoreNand(PrintConsole* term_con, PrintConsole* menu_con, u32 param)
 	ee_printf("NAND protection: %s\n", protected ? "enabled" : "disabled");
 	
 	
-	// all done, ready to do the NAND backup
-	ee_printf("\n");
-	for (s64 p = 0; p < file_size; p += DEVICE_BUFSIZE)
+	// from here on the restore can be resumed
+	if (!resume)
 	{
-		s64 readBytes = (file_size - p > DEVICE_BUFSIZE) ? DEVICE_BUFSIZE : file_size - p;
-		s32 errcode = 0;
-		ee_printf_progress("NAND restore", PROGRESS_WIDTH, p, file_size);
-		updateScreens();
+		memset(&jnl, 0, sizeof(jnl));
+		jnl.magic = NAND_JOURNAL_MAGIC;
+		jnl.size = file_size;
+		jnl.flags = forced ? NAND_JOURNAL_FORCED : 0;
+		if (have_cid) memcpy(jnl.cid, nand_cid, sizeof(jnl.cid));
+		strncpy(jnl.fpath, fpath, FF_MAX_LFN + 1);
+		if (!fsQuickWrite(NAND_RESTORE_JOURNAL, &jnl, sizeof(jnl)))
+			ee_printf("Cannot write journal, restore can't be resumed!\n");
+	}
+	
+	// hash what we write so the checkpoints can store the hash state
+	// for verifying the image when the restore gets resumed
+	bool hashing = false;
+	if (have_hash)
+	{
+		if (resume)
+			hashing = (jnl.flags & NAND_JOURNAL_HASHED) &&
+				(fResumeDeviceBufferHash(dbufHandle, &jnl.hash) == 0);
+		else hashing = (fStartDeviceBufferHash(dbufHandle) == 0);
+	}
+	if (hashing) jnl.flags |= NAND_JOURNAL_HASHED;
+	else jnl.flags &= ~NAND_JOURNAL_HASHED;
+	
+	
+	// all done, ready to do the NAND restore
+	res = nandTransfer("NAND restore", NAND_TRANSFER_RESTORE, fHandle, 0, devHandle, 0, file_size, &tune, &jnl, fpath);
+	if (res < 0) goto fail_close_handles;
+	else if (res > 0) // force poweroff
+	{
+		fFinalizeRawAccess(devHandle);
+		fFreeDeviceBuffer(dbufHandle);
+		fClose(fHandle);
+		return MENU_FAIL;
+	}
+	
+	fUnlink(NAND_RESTORE_JOURNAL);
+	
+	// the image must not have changed since it was verified
+	if (hashing)
+	{
+		u32 hash[8];
 		
-		if ((errcode = fReadToDeviceBuffer(fHandle, p, readBytes, dbufHandle)) != 0)
+		if ((fGetDeviceBufferHash(dbufHandle, hash) != 0) ||
+			(memcmp(hash, expectedHash, 32) != 0))
 		{
-			ee_printf("\nError: Cannot read from file (%li)!\n", errcode);
+			ee_printf("\nError: NAND backup changed during the restore!\n");
 			goto fail_close_handles;
 		}
+	}
+	
+	ee_printf("\n" ESC_SCHEME_GOOD "NAND restore finished.\n" ESC_RESET);
+	result = MENU_OK;
+	
+	
+	fail_close_handles:
+
+	if ((error = fFinalizeRawAccess(devHandle)))
+		ee_printf("Failed closing NAND handle (error %li)!\n", error);
+	fFreeDeviceBuffer(dbufHandle);
+	fClose(fHandle);
+	
+	
+	fail:
+	
+	ee_printf("\nPress B or HOME to return.");
+	updateScreens();
+	outputEndWait();
+
+	
+	return result;
+}
+
+u32 menuBackupNandPartition(PrintConsole* term_con, PrintConsole* menu_con, u32 param)
+{
+	(void) menu_con;
+	s32 error = 0;
+	u32 result = MENU_FAIL;
+	char fpath[64] = { 0 };
+	
+	// select & clear console
+	consoleSelect(term_con);
+	consoleClear();
+	
+	
+	// ensure SD mounted
+	if (!fsEnsureMounted("sdmc:"))
+	{
+		ee_printf("SD not inserted or corrupt!\n");
+		goto fail;
+	}
+	
+	// look up the partition in the current NAND layout
+	NandPartImageHeader header;
+	memset(&header, 0, sizeof(header));
+	if ((param >= N_NAND_PART_TARGETS) ||
+		(fGetNandPartition(nandPartTargets[param], &header.part) != 0))
+	{
+		ee_printf("Partition not found in NAND layout!\n");
+		goto fail;
+	}
+	header.magic = NAND_PART_IMAGE_MAGIC;
+	header.headerSize = sizeof(header);
+	const u32 part_size = header.part.count * 0x200;
+	
+	// create partition backup filename
+	char suffix[24];
+	ee_snprintf(suffix, 24, "%s_part.img", header.part.name);
+	makeBackupPath(fpath, 64, suffix);
+	
+	ee_printf(ESC_SCHEME_ACCENT1 "Creating %s backup:\n%s\n" ESC_RESET "\nPreparing partition backup...\n",
+		nandPartNames[param], fpath);
+	updateScreens();
+	
+	
+	// open file handle
+	s32 fHandle;
+	if (!fsCreateFileWithPath(fpath) ||
+		((fHandle = fOpen(fpath, FS_OPEN_EXISTING | FS_OPEN_WRITE | FS_OPEN_READ)) < 0))
+	{
+		ee_printf("Cannot create file!\n");
+		goto fail;
+	}
+	
+	// reserve space and write the image header
+	ee_printf("Partition: %s (NCSD #%u)\nOffset: 0x%08lX\nSize: %lu kiB\n",
+		header.part.name, header.part.ncsdIndex, header.part.sector * 0x200, part_size / 0x400);
+	updateScreens();
+	if ((fLseek(fHandle, sizeof(header) + part_size) != 0) || (fTell(fHandle) != sizeof(header) + part_size) ||
+		(fLseek(fHandle, 0) != 0) || (fWrite(fHandle, &header, sizeof(header)) != 0))
+	{
+		fClose(fHandle);
+		ee_printf("Not enough space!\n");
+		goto fail;
+	}
+	
+	
+	// setup device read
+	s32 devHandle = fPrepareRawAccess(FS_DEVICE_NAND);
+	if (devHandle < 0)
+	{
+		fClose(fHandle);
+		ee_printf("Cannot open NAND device (error %li)!\n", devHandle);
+		goto fail;
+	}
+	
+	// setup device buffer
+	NandTuner tune;
+	s32 dbufHandle = nandTuneInit(&tune);
+	if (dbufHandle < 0)
+		panicMsg("Out of memory");
+	printTuneInfo(&tune);
+	
+	// hash the header we just wrote, then everything read from NAND
+	if ((fStartDeviceBufferHash(dbufHandle) != 0) ||
+		(fReadToDeviceBuffer(fHandle, 0, sizeof(header), dbufHandle) != 0))
+	{
+		ee_printf("Cannot hash image header!\n");
+		goto fail_close_handles;
+	}
+	
+	
+	// all done, ready to do the partition backup
+	s32 res = nandTransfer("Backup", NAND_TRANSFER_BACKUP, fHandle, sizeof(header),
+		devHandle, header.part.sector * 0x200, part_size, &tune, NULL, fpath);
+	if (res < 0) goto fail_close_handles;
+	else if (res > 0) // canceled by user
+	{
+		fFinalizeRawAccess(devHandle);
+		fFreeDeviceBuffer(dbufHandle);
+		fClose(fHandle);
+		fUnlink(fpath);
+		return MENU_FAIL;
+	}
+	
+	// store the image hash in a sidecar file
+	u32 hash[8];
+	if ((fGetDeviceBufferHash(dbufHandle, hash) != 0) ||
+		!writeHashSidecar(fpath, (u8*) hash))
+	{
+		ee_printf("\nError: Cannot write hash file!\n");
+		goto fail_close_handles;
+	}
+	
+	ee_printf("\n" ESC_SCHEME_GOOD "%s backup finished.\n" ESC_RESET, nandPartNames[param]);
+	result = MENU_OK;
+	
+	
+	fail_close_handles:
+	
+	if ((error = fFinalizeRawAccess(devHandle)))
+		ee_printf("Failed closing NAND handle (error %li)!\n", error);
+	fFreeDeviceBuffer(dbufHandle);
+	fClose(fHandle);
+	
+	
+	fail:
+	
+	ee_printf("\nPress B or HOME to return.");
+	updateScreens();
+	outputEndWait();
+
+	
+	if ((result != MENU_OK) && *fpath) fUnlink(fpath);
+	hidScanInput(); // throw away any input from impatient users
+	return result;
+}
+
+u32 menuRestoreNandPartition(PrintConsole* term_con, PrintConsole* menu_con, u32 param)
+{
+	(void) param;
+	s32 error = 0;
+	u32 result = MENU_FAIL;
+	
+	
+	// select & clear console
+	consoleSelect(term_con);
+	consoleClear();
+	
+	// check battery
+	BatteryState battery;
+	getBatteryState(&battery);
+	if ((battery.percent <= 20) && !battery.charging) {
+		ee_printf("Battery below 20%% and not charging.\nPlug in the charger and retry.\n");
+		goto fail;
+	}
+	
+	// ensure SD mounted
+	if (!fsEnsureMounted("sdmc:"))
+	{
+		ee_printf("SD not inserted or corrupt!\n");
+		goto fail;
+	}
+	
+	
+	ee_printf_screen_center("Select a partition backup for restore.\nPress [HOME] to cancel.");
+	updateScreens();
+	
+	char fpath[FF_MAX_LFN + 1];
+	if (!menuFileSelector(fpath, menu_con, NAND_BACKUP_PATH, "*_part.img", false))
+		return MENU_FAIL; // canceled by user
+	
+	// select & clear console
+	consoleSelect(term_con);
+	consoleClear();
+	
+	// check the image against the current partition layout
+	NandPartImageHeader header;
+	if ((fVerifyNandPartImage(fpath) != 0) ||
+		!fsQuickRead(fpath, &header, sizeof(header), 0))
+	{
+		ee_printf("%s\nNot a valid partition backup for this 3DS!\n", fpath);
+		goto fail;
+	}
+	
+	// firmware partitions contain fastboot3DS itself
+	const bool isFirm = (header.part.type == NAND_PART_TYPE_FIRM);
+	if (isFirm && (!configDataExist(KDevMode) || !(*(bool*) configGetData(KDevMode)))) {
+		ee_printf("Restoring %s is not available!\nEnable dev mode to get access.\n", header.part.name);
+		goto fail;
+	}
+	
+	// ask the user for confirmation
+	if (isFirm)
+	{
+		if (!askConfirmation(ESC_SCHEME_BAD "WARNING:" ESC_RESET "\nYou're about to restore %s. This will\noverwrite the fastboot3ds installation in\nthis partition!", header.part.name)) return MENU_FAIL;
+	}
+	else
+	{
+		if (!askConfirmation(ESC_SCHEME_BAD "WARNING:" ESC_RESET "\nYou're about to restore %s. Make sure\nyou have backups of your important data!", header.part.name)) return MENU_FAIL;
+	}
+	consoleClear();
+	
+	ee_printf(ESC_SCHEME_ACCENT1 "Restoring partition backup:\n%s\n" ESC_RESET "\nPreparing partition restore...\n", fpath);
+	updateScreens();
+	
+	
+	// open file handle
+	s32 fHandle;
+	if ((fHandle = fOpen(fpath, FS_OPEN_EXISTING | FS_OPEN_READ)) < 0)
+	{
+		ee_printf("Cannot open file (error %li)!\n", fHandle);
+		goto fail;
+	}
+	
+	// setup device write
+	s32 devHandle = fPrepareRawAccess(FS_DEVICE_NAND);
+	if (devHandle < 0)
+	{
+		fClose(fHandle);
+		ee_printf("Cannot open NAND device (error %li)!\n", devHandle);
+		goto fail;
+	}
+	
+	// setup device buffer
+	NandTuner tune;
+	s32 dbufHandle = nandTuneInit(&tune);
+	if (dbufHandle < 0)
+		panicMsg("Out of memory");
+	printTuneInfo(&tune);
+	
+	const u32 part_size = header.part.count * 0x200;
+	ee_printf("Partition: %s (NCSD #%u)\nOffset: 0x%08lX\nSize: %lu kiB\n",
+		header.part.name, header.part.ncsdIndex, header.part.sector * 0x200, part_size / 0x400);
+	updateScreens();
+	
+	
+	// verify the whole image file against its hash before writing anything
+	u8 expectedHash[32];
+	s32 res;
+	if (readHashSidecar(fpath, expectedHash))
+	{
+		u32 hash[8];
 		
-		if ((errcode = fsWriteFromDeviceBuffer(devHandle, p, readBytes, dbufHandle)) != 0)
+		if (fStartDeviceBufferHash(dbufHandle) != 0)
 		{
-			ee_printf("\nError: Cannot write to NAND (%li)!\n", errcode);
+			ee_printf("Cannot start partition backup hash!\n");
 			goto fail_close_handles;
 		}
-		
-		// check for user cancel request
-		// cancel is forbidden(!) here, but we need to handle force poweroff
-		if (userCancelHandler(false))
+		res = nandTransfer("Verifying", NAND_TRANSFER_VERIFY, fHandle, 0, devHandle, 0,
+			header.headerSize + part_size, &tune, NULL, fpath);
+		if (res < 0) goto fail_close_handles;
+		else if (res > 0) // canceled by user, nothing written yet
 		{
 			fFinalizeRawAccess(devHandle);
 			fFreeDeviceBuffer(dbufHandle);
 			fClose(fHandle);
 			return MENU_FAIL;
 		}
+		
+		if ((fGetDeviceBufferHash(dbufHandle, hash) != 0) ||
+			(memcmp(hash, expectedHash, 32) != 0))
+		{
+			ee_printf("\nError: Partition backup hash mismatch!\nThe image is corrupted or truncated.\n");
+			goto fail_close_handles;
+		}
+		ee_printf("\nPartition backup hash verified.\n");
 	}
+	else ee_printf("No hash file found, skipping verification.\n");
 	
-	// NAND access finalized
-	ee_printf_progress("NAND restore", PROGRESS_WIDTH, file_size, file_size);
-	ee_printf("\n" ESC_SCHEME_GOOD "NAND restore finished.\n" ESC_RESET);
+	
+	// firm partitions are inside the protected regions
+	bool protected = !isFirm;
+	if (fSetNandProtection(protected) != 0)
+		panicMsg("Set NAND protection failed.");
+	ee_printf("NAND protection: %s\n", protected ? "enabled" : "disabled");
+	
+	
+	// all done, ready to do the partition restore
+	res = nandTransfer("Restore", NAND_TRANSFER_RESTORE, fHandle, header.headerSize,
+		devHandle, header.part.sector * 0x200, part_size, &tune, NULL, fpath);
+	if (res < 0) goto fail_close_handles;
+	else if (res > 0) // force poweroff
+	{
+		fFinalizeRawAccess(devHandle);
+		fFreeDeviceBuffer(dbufHandle);
+		fClose(fHandle);
+		return MENU_FAIL;
+	}
+	
+	ee_printf("\n" ESC_SCHEME_GOOD "%s restore finished.\n" ESC_RESET, header.part.name);
 	result = MENU_OK;
 	
 	
@@ -668,10 +1352,13 @@ u32 menuInstallFirm(PrintConsole* term_con, PrintConsole* menu_con, u32 param)
 	if (!askConfirmation(ESC_SCHEME_BAD "WARNING:" ESC_RESET "\nYou're about to install a firmware to %s.\nFlashing incompatible firmwares may lead to\nunexpected results.", firm_drv)) return MENU_FAIL;
 	consoleClear();
 	
-	ee_printf(ESC_SCHEME_ACCENT1 "Flashing firmware to %s:\n%s\n" ESC_RESET "\nLoading firmware... ", firm_drv, firm_path);
-	updateScreens();
+	ee_printf(ESC_SCHEME_ACCENT1 "Flashing firmware to %s:\n%s\n" ESC_RESET "\n", firm_drv, firm_path);
 	
-	s32 res = loadVerifyFirm(firm_path, false);
+	ee_printf("Loading firmware... ");
+	updateScreens();
+	s32 res;
+	if (waitFirmCmd("Loading", loadVerifyFirmAsync(firm_path, false), &res))
+		return MENU_FAIL; // force poweroff
 	if (res < 0)
 	{
 		ee_printf(ESC_SCHEME_BAD "failed!\n" ESC_RESET);
@@ -679,10 +1366,12 @@ u32 menuInstallFirm(PrintConsole* term_con, PrintConsole* menu_con, u32 param)
 		goto fail;
 	}
 	
-	ee_printf(ESC_SCHEME_GOOD "OK\n" ESC_RESET "Flashing firmware... ");
-	updateScreens();
+	ee_printf(ESC_SCHEME_GOOD "OK\n" ESC_RESET);
 	
-	res = writeFirmPartition(firm_drv, true);
+	ee_printf("Flashing firmware... ");
+	updateScreens();
+	if (waitFirmCmd("Flashing", writeFirmPartitionAsync(firm_drv, true), &res))
+		return MENU_FAIL; // force poweroff
 	if (res != 0)
 	{
 		ee_printf(ESC_SCHEME_BAD "failed!\n" ESC_RESET);
@@ -776,10 +1465,12 @@ u32 menuUpdateFastboot3ds(PrintConsole* term_con, PrintConsole* menu_con, u32 pa
 		goto fail;
 	}
 	
-	ee_printf(ESC_SCHEME_GOOD "v%lu.%lu\n" ESC_RESET "Flashing firmware... ", (version >> 16) & 0xFFFF, version & 0xFFFF);
-	updateScreens();
+	ee_printf(ESC_SCHEME_GOOD "v%lu.%lu\n" ESC_RESET, (version >> 16) & 0xFFFF, version & 0xFFFF);
 	
-	res = writeFirmPartition("firm0:", true);
+	ee_printf("Flashing firmware... ");
+	updateScreens();
+	if (waitFirmCmd("Flashing", writeFirmPartitionAsync("firm0:", true), &res))
+		return MENU_FAIL; // force poweroff
 	if (res != 0)
 	{
 		ee_printf(ESC_SCHEME_BAD "failed!\n" ESC_RESET);
@@ -888,6 +1579,79 @@ u32 menuShowCredits(PrintConsole* term_con, PrintConsole* menu_con, u32 param)
 	return MENU_OK;
 }
 
+u32 menuShowIpcStats(PrintConsole* term_con, PrintConsole* menu_con, u32 param)
+{
+	(void) menu_con;
+	(void) param;
+	
+	const u32 rows = term_con->windowHeight - 7;
+	u32 scroll = 0;
+	u32 kDown = 0;
+	
+	do
+	{
+		// only list commands that were used
+		u8 cmd_ids[IPC_STATS_MAX_CMDS];
+		u32 n_cmds = 0;
+		for (u32 i = 0; i < IPC_STATS_MAX_CMDS; i++)
+			if (IPC_statsGet(i)->calls) cmd_ids[n_cmds++] = i;
+		if (scroll + rows > n_cmds)
+			scroll = (n_cmds > rows) ? n_cmds - rows : 0;
+		
+		consoleSelect(term_con);
+		consoleClear();
+		
+		ee_printf(ESC_SCHEME_ACCENT0 "IPC statistics\n\n" ESC_SCHEME_STD);
+		ee_printf("%-20.20s %7s %9s %8s %8s\n", "command", "calls", "KiB", "avg us", "max us");
+		for (u32 i = scroll; (i < n_cmds) && (i < scroll + rows); i++)
+		{
+			const IpcCmdStats* stats = IPC_statsGet(cmd_ids[i]);
+			ee_printf("%-20.20s %7lu %9llu %8llu %8lu\n", IPC_statsCmdName(cmd_ids[i]),
+				stats->calls, stats->bytes / 1024, stats->totalUs / stats->calls, stats->maxUs);
+		}
+		
+		term_con->cursorY = term_con->windowHeight - 2;
+		ee_printf(ESC_SCHEME_WEAK "Y: dump to SD, X: reset, B: return" ESC_SCHEME_STD);
+		updateScreens();
+		
+		// handle user input
+		do
+		{
+			GFX_waitForEvent(GFX_EVENT_PDC0, true);
+			
+			if(hidGetPowerButton(false)) // handle power button
+				return MENU_OK;
+			
+			hidScanInput();
+			kDown = hidKeysDown();
+			if (kDown & KEY_SHELL) sleepmode();
+		}
+		while (!(kDown & (KEY_B|KEY_HOME|KEY_X|KEY_Y|KEY_DUP|KEY_DDOWN)));
+		
+		if ((kDown & KEY_DUP) && scroll) scroll--;
+		else if (kDown & KEY_DDOWN) scroll++;
+		else if (kDown & KEY_X) IPC_statsReset();
+		else if (kDown & KEY_Y)
+		{
+			const bool dumped = fsEnsureMounted(IPC_STATS_DUMP_PATH) &&
+				IPC_statsDump(IPC_STATS_DUMP_PATH);
+			
+			term_con->cursorY = term_con->windowHeight - 2;
+			ee_printf("\r%60.60s\r", "");
+			ee_printf(dumped ? ESC_SCHEME_GOOD "Dumped to " IPC_STATS_DUMP_PATH ESC_SCHEME_STD :
+				ESC_SCHEME_BAD "Cannot write " IPC_STATS_DUMP_PATH ESC_SCHEME_STD);
+#ifndef NDEBUG
+			if (dumped) perfDumpLog(PERF_LOG_DUMP_PATH); // clock transitions
+#endif
+			updateScreens();
+			outputEndWait();
+		}
+	}
+	while (!(kDown & (KEY_B|KEY_HOME)));
+	
+	return MENU_OK;
+}
+
 /*
 u32 menuDummyFunc(PrintConsole* term_con, PrintConsole* menu_con, u32 param)
 {
@@ -31,6 +31,24 @@
 #define BORDER_WIDTH	2 // in pixel
 
 
+// Console text is UTF-8, so widths count characters instead of bytes.
+// returns the number of characters in the first n bytes of str
+static u32 utf8Chars(const char* str, u32 n)
+{
+	u32 chars = 0;
+	for (u32 i = 0; (i < n) && str[i]; i++)
+		if ((str[i] & 0xC0) != 0x80) chars++;
+	return chars;
+}
+
+// returns a pointer to character n of str or to the terminator
+static const char* utf8Skip(const char* str, int n)
+{
+	for (; *str; str++)
+		if (((*str & 0xC0) != 0x80) && (n-- <= 0)) break;
+	return str;
+}
+
 char* mallocpyString(const char* str)
 {
 	u32 strsize = strlen(str) + 1;
@@ -40,23 +58,25 @@ char* mallocpyString(const char* str)
 	return astr;
 }
 
+// nsize and tpos are in characters, dest must hold nsize * 4 + 1 bytes
 void truncateString(char* dest, const char* orig, int nsize, int tpos)
 {
-	int osize = strlen(orig);
+	int osize = utf8Chars(orig, strlen(orig));
 	
 	if (nsize < 0)
 	{
 		return;
 	} else if (nsize <= 3)
 	{
-		ee_snprintf(dest, nsize, orig);
+		if (nsize > 0) ee_snprintf(dest, (u32) (utf8Skip(orig, nsize - 1) - orig) + 1, "%s", orig);
 	} else if (nsize >= osize)
 	{
-		ee_snprintf(dest, nsize + 1, orig);
+		strcpy(dest, orig);
 	} else
 	{
 		if (tpos + 3 > nsize) tpos = nsize - 3;
-		ee_snprintf(dest, nsize + 1, "%-.*s...%-.*s", tpos, orig, nsize - (3 + tpos), orig + osize - (nsize - (3 + tpos)));
+		const char* tail = utf8Skip(orig, osize - (nsize - (3 + tpos)));
+		ee_sprintf(dest, "%-.*s...%s", (int) (utf8Skip(orig, tpos) - orig), orig, tail);
 	}
 }
 
@@ -113,11 +133,12 @@ u32 stringGetWidth(const char* str)
 	char* old_lf = (char*) str;
 	char* str_end = (char*) str + strlen(str);
 	for (char* lf = strchr(str, '\n'); lf != NULL; lf = strchr(lf + 1, '\n')) {
-		if ((u32) (lf - old_lf) > width) width = lf - old_lf;
+		u32 line = utf8Chars(old_lf, lf - old_lf);
+		if (line > width) width = line;
 		old_lf = lf;
 	}
-	if ((u32) (str_end - old_lf) > width)
-		width = str_end - old_lf;
+	u32 line = utf8Chars(old_lf, str_end - old_lf);
+	if (line > width) width = line;
 	return width;
 }
 
@@ -127,7 +148,7 @@ void stringWordWrap(char* str, int llen)
 	char* last_spc = str - 1;
 	for (char* str_ptr = str;; str_ptr++) {
 		if (!*str_ptr || (*str_ptr == ' ')) { // on space or string_end
-			if (str_ptr - last_brk > llen) { // if maximum line lenght is exceeded
+			if ((int) utf8Chars(last_brk + 1, str_ptr - (last_brk + 1)) >= llen) { // if maximum line lenght is exceeded
 				if (last_spc > last_brk) { // put a line_brk at the last space
 					*last_spc = '\n';
 					last_brk = last_spc;
@@ -151,7 +172,7 @@ u32 ee_printf_line_center(const char *const fmt, ...)
 	va_end(args);
 	
 	PrintConsole* con = consoleGet();
-	int pad = (con->windowWidth - strlen(buf)) / 2;
+	int pad = (con->windowWidth - (int) stringGetWidth(buf)) / 2;
 	if (pad < 0) pad = 0;
 	con->cursorX = 0;
 	
@@ -195,8 +216,8 @@ u32 ee_printf_progress(const char *const fmt, u32 w, u64 curr, u64 max)
 	
 	u32 i = 0;
 	ee_printf(ESC_SCHEME_WEAK);
-	for (; i < prog_w; i++) res += ee_printf("\xDB");
-	for (; i < w; i++) res += ee_printf("\xB1");
+	for (; i < prog_w; i++) res += ee_printf("\u2588"); // full block
+	for (; i < w; i++) res += ee_printf("\u2592"); // medium shade
 	ee_printf(ESC_RESET);
 	
 	res += ee_printf(" | %s%lu%%%s | %s%llu / %llu MiB%s\r",
@@ -211,6 +232,7 @@ void clearTop(void)
 {
 	GX_memoryFill((u64*)RENDERBUF_TOP, 1u<<9, SCREEN_SIZE_TOP, 0, NULL, 0, 0, 0);
 	GFX_waitForEvent(GFX_EVENT_PSC0, true);
+	GFX_markDirty(SCREEN_TOP, 0, SCREEN_WIDTH_TOP);
 }
 
 void drawTopBorder(void)
@@ -236,6 +258,7 @@ void drawTopBorder(void)
 			fb++;
 		}
 	}
+	GFX_markDirty(SCREEN_TOP, 0, SCREEN_WIDTH_TOP);
 }
 
 // only intended to be ran when the shell is closed
@@ -252,10 +275,8 @@ void sleepmode(void)
 
 void updateScreens(void)
 {
-	GX_textureCopy((u64*)RENDERBUF_TOP, 0, (u64*)GFX_getFramebuffer(SCREEN_TOP),
-				   0, SCREEN_SIZE_TOP + SCREEN_SIZE_SUB);
-	GFX_swapFramebufs();
-	GFX_waitForEvent(GFX_EVENT_PDC0, true); // VBlank
+	// copies changed render buffer columns, swapped in on the next VBlank
+	GFX_queuePresent();
 }
 
 bool askConfirmation(const char *const fmt, ...)
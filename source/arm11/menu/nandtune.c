@@ -0,0 +1,249 @@
+/*
+ *   This file is part of fastboot 3DS
+ *   Copyright (C) 2017 derrek, profi200, d0k3
+ *
+ *   This program is free software: you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License as published by
+ *   the Free Software Foundation, either version 3 of the License, or
+ *   (at your option) any later version.
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <string.h>
+#include "types.h"
+#include "fs.h"
+#include "fsutils.h"
+#include "arm11/hardware/timer.h"
+#include "arm11/perf.h"
+#include "arm11/console.h"
+#include "arm11/fmt.h"
+#include "arm11/menu/menu_func.h"
+#include "arm11/menu/nandtune.h"
+
+#define TIMER_TICK_RATE		(TIMER_BASE_FREQ / 2) // ticks per second at prescaler 1 and the base clock
+
+// chunk sizes tried by the autotuner, sizes above DEVICE_BUFSIZE are skipped
+static const u32 chunkSizes[] = { 0x10000, 0x20000, 0x40000, 0x80000, 0x100000 };
+
+typedef struct {
+	u32 cid[4];
+	u32 chunkSize;
+	u32 rate;		// KiB/s
+} NandTuneEntry;
+
+
+
+// KiB/s for bytes transferred in ticks
+static u32 calcRate(u64 bytes, u64 ticks)
+{
+	if (!ticks) return 0;
+	return (u32) ((bytes * (u64) TIMER_TICK_RATE) / ticks / 1024);
+}
+
+static bool loadTuneTable(NandTuneEntry* table)
+{
+	memset(table, 0, sizeof(NandTuneEntry) * NAND_TUNE_MAX_CARDS);
+	return fsQuickRead(NAND_TUNE_PATH, table, sizeof(NandTuneEntry) * NAND_TUNE_MAX_CARDS, 0);
+}
+
+static void saveTuneResult(const NandTuner* tune)
+{
+	NandTuneEntry table[NAND_TUNE_MAX_CARDS];
+	u32 i;
+	
+	if (!tune->haveCid) return;
+	loadTuneTable(table);
+	
+	// replace the entry for this card or drop the oldest one
+	for (i = 0; i < NAND_TUNE_MAX_CARDS - 1; i++)
+		if (memcmp(table[i].cid, tune->cid, 16) == 0) break;
+	memmove(&table[1], &table[0], sizeof(NandTuneEntry) * i);
+	
+	memcpy(table[0].cid, tune->cid, 16);
+	table[0].chunkSize = tune->bestChunkSize;
+	table[0].rate = tune->bestRate;
+	
+	fsQuickWrite(NAND_TUNE_PATH, table, sizeof(table));
+}
+
+// creates the biggest device buffer the ARM9 heap allows (up to DEVICE_BUFSIZE)
+// and picks the stored chunk size for the inserted SD card or starts autotuning
+s32 nandTuneInit(NandTuner* tune)
+{
+	NandTuneEntry table[NAND_TUNE_MAX_CARDS];
+	
+	memset(tune, 0, sizeof(NandTuner));
+	tune->dbufHandle = -1;
+	
+	for (s32 i = (sizeof(chunkSizes) / sizeof(u32)) - 1; i >= 0; i--)
+	{
+		if (chunkSizes[i] > DEVICE_BUFSIZE) continue;
+		if ((tune->dbufHandle = fCreateDeviceBuffer(chunkSizes[i])) >= 0)
+		{
+			tune->bufSize = chunkSizes[i];
+			break;
+		}
+	}
+	if (tune->dbufHandle < 0) return tune->dbufHandle;
+	
+	tune->chunkSize = tune->bufSize;
+	tune->haveCid = (fGetDeviceCid(FS_DEVICE_SDMC, tune->cid) == 0);
+	
+	// known card? use the stored result
+	if (tune->haveCid && loadTuneTable(table))
+	{
+		for (u32 i = 0; i < NAND_TUNE_MAX_CARDS; i++)
+		{
+			if ((memcmp(table[i].cid, tune->cid, 16) == 0) &&
+				table[i].chunkSize && (table[i].chunkSize <= tune->bufSize))
+			{
+				tune->chunkSize = table[i].chunkSize;
+				tune->bestRate = table[i].rate;
+				return tune->dbufHandle;
+			}
+		}
+	}
+	
+	// try all chunk sizes fitting the buffer, smallest first
+	tune->tuning = true;
+	tune->chunkSize = chunkSizes[0];
+	
+	return tune->dbufHandle;
+}
+
+void nandTuneChunkStart(void)
+{
+	// single shot from the max value, wraps after 32 seconds
+	// at the base clock (less when boosted)
+	TIMER_start(1, 0xFFFFFFFF, false, false);
+}
+
+// ticks since nandTuneChunkStart() at the base clock
+// the timer runs at half the CPU clock which is boosted during transfers
+u32 nandTuneTicks(void)
+{
+	return (0xFFFFFFFF - TIMER_getTicks()) / perfGetClockMul();
+}
+
+void nandTuneChunkEnd(NandTuner* tune, u32 bytes, u32 ticks)
+{
+	if (!tune->tuning) return;
+	
+	tune->trialBytes += bytes;
+	tune->trialTicks += ticks;
+	if (tune->trialBytes < NAND_TUNE_TRIAL_SIZE) return;
+	
+	// done with this chunk size
+	if (tune->trialTicks)
+	{
+		const u32 rate = calcRate(tune->trialBytes, tune->trialTicks);
+		if (rate > tune->bestRate)
+		{
+			tune->bestRate = rate;
+			tune->bestChunkSize = tune->chunkSize;
+		}
+	}
+	
+	tune->trial++;
+	tune->trialBytes = 0;
+	tune->trialTicks = 0;
+	
+	if ((tune->trial < sizeof(chunkSizes) / sizeof(u32)) &&
+		(chunkSizes[tune->trial] <= tune->bufSize))
+	{
+		tune->chunkSize = chunkSizes[tune->trial];
+	}
+	else // all tried, lock in the best one
+	{
+		tune->tuning = false;
+		tune->chunkSize = tune->bestChunkSize ? tune->bestChunkSize : tune->bufSize;
+		saveTuneResult(tune);
+	}
+}
+
+void nandStatsInit(NandStats* stats)
+{
+	memset(stats, 0, sizeof(NandStats));
+	stats->read.minRate = stats->write.minRate = stats->total.minRate = 0xFFFFFFFF;
+}
+
+static void updateStage(NandStageStats* stage, u32 bytes, u32 ticks)
+{
+	const u32 rate = calcRate(bytes, ticks);
+	
+	if (rate < stage->minRate) stage->minRate = rate;
+	if (rate > stage->maxRate) stage->maxRate = rate;
+	stage->bytes += bytes;
+	stage->ticks += ticks;
+}
+
+void nandStatsUpdate(NandStats* stats, u32 bytes, u32 readTicks, u32 writeTicks, u32 totalTicks)
+{
+	updateStage(&stats->read, bytes, readTicks);
+	if (writeTicks) updateStage(&stats->write, bytes, writeTicks);
+	updateStage(&stats->total, bytes, totalTicks);
+	
+	// exponential moving average, 1/8 weight for the new chunk
+	const u32 rate = calcRate(bytes, totalTicks);
+	stats->rate = stats->chunks ? ((stats->rate * 7) + rate) / 8 : rate;
+	stats->chunks++;
+}
+
+// formats "xx.x MiB/s | ETA mm:ss | R xx.x W xx.x" for the progress display
+void nandStatsFormat(const NandStats* stats, u32 remaining, char* str, u32 len)
+{
+	const u32 eta = stats->rate ? (remaining / 1024) / stats->rate : 0;
+	const u32 readRate = calcRate(stats->read.bytes, stats->read.ticks);
+	const u32 writeRate = calcRate(stats->write.bytes, stats->write.ticks);
+	
+	if (!stats->chunks)
+	{
+		ee_snprintf(str, len, "-.- MiB/s | ETA --:--");
+		return;
+	}
+	
+	ee_snprintf(str, len, "%lu.%lu MiB/s | ETA %02lu:%02lu | R %lu.%lu W %lu.%lu",
+		stats->rate / 1024, ((stats->rate % 1024) * 10) / 1024, eta / 60, eta % 60,
+		readRate / 1024, ((readRate % 1024) * 10) / 1024,
+		writeRate / 1024, ((writeRate % 1024) * 10) / 1024);
+}
+
+static u32 formatStage(char* str, u32 len, const char* name, const NandStageStats* stage)
+{
+	if (!stage->bytes)
+		return ee_snprintf(str, len, "%-8s n/a\n", name);
+	
+	// min / avg / max in KiB/s and the total time in ms
+	return ee_snprintf(str, len, "%-8s min %6lu  avg %6lu  max %6lu KiB/s  %8llu ms\n", name,
+		stage->minRate, calcRate(stage->bytes, stage->ticks), stage->maxRate,
+		(stage->ticks * 1000) / (u64) TIMER_TICK_RATE);
+}
+
+// appends a summary of the transfer to the log file at path
+bool nandStatsWriteLog(const NandStats* stats, const char* path, const char* desc)
+{
+	char log[512];
+	u32 len = 0;
+	
+	len += ee_snprintf(log + len, sizeof(log) - len, "%s: %llu bytes in %lu chunks\n",
+		desc, stats->total.bytes, stats->chunks);
+	len += formatStage(log + len, sizeof(log) - len, "read", &stats->read);
+	len += formatStage(log + len, sizeof(log) - len, "write", &stats->write);
+	len += formatStage(log + len, sizeof(log) - len, "total", &stats->total);
+	len += ee_snprintf(log + len, sizeof(log) - len, "\n");
+	
+	s32 fHandle = fOpen(path, FS_OPEN_APPEND | FS_OPEN_WRITE);
+	if (fHandle < 0) return false;
+	
+	bool res = (fWrite(fHandle, log, len) == 0);
+	fClose(fHandle);
+	
+	return res;
+}
@@ -22,10 +22,90 @@
 #include "types.h"
 #include "arm11/menu/splash.h"
 #include "arm11/lz11.h"
+#include "arm11/lz4.h"
 #include "hardware/gfx.h"
 #include "arm11/menu/menu_util.h"
+#include "arm11/smp.h"
+#include "arm11/perf.h"
 
 
+typedef struct
+{
+	const u16 *src;
+	u16 *dst;
+	u32 height;
+} SplashBlit;
+
+typedef struct
+{
+	const u8 *data;
+	u32 size;
+	u32 flags;
+	bool trusted;
+	const SplashAnimHeader *header;
+	u16 *frameBuf;    // One decoded frame, NULL if decoded in place
+	u16 *dst;
+	u32 x;
+	u32 height;
+	u32 frame;
+	u32 vblanksLeft;
+	u32 loopsLeft;
+} SplashAnim;
+
+static SplashAnim anim = {0};
+
+
+// copies the columns [start, end) of the rotated image to the framebuffer
+static void blitColumns(void *arg, u32 start, u32 end)
+{
+	const SplashBlit *const blit = (const SplashBlit*)arg;
+	const u32 height = blit->height;
+	const u16 *src = blit->src + start * height;
+	u16 *dst = blit->dst + start * SCREEN_HEIGHT_TOP;
+
+	// full height columns are contiguous in the framebuffer too
+	if(height == SCREEN_HEIGHT_TOP)
+	{
+		memcpy(dst, src, (end - start) * height * 2);
+		return;
+	}
+
+	for(u32 x = start; x < end; x++)
+	{
+		memcpy(dst, src, height * 2);
+		src += height;
+		dst += SCREEN_HEIGHT_TOP;
+	}
+}
+
+// Draws width columns of a rotated image. tmp must hold the decompressed image
+// unless it covers the full height and can be decompressed in place.
+// Untrusted data goes through the bounded decoders. Only the built-in splash
+// is trusted and may use the faster assembly decoders.
+static bool blitImage(const void *src, u32 srcSize, u32 flags, bool trusted, u16 *tmp, u16 *dst, u32 width, u32 height)
+{
+	const u32 imgSize = width * height * 2;
+	if(flags & FLAG_COMPRESSED)
+	{
+		u16 *const out = (tmp ? tmp : dst);
+		if(trusted) (flags & FLAG_LZ4 ? lz4Decompress : lz11Decompress)(src, out, imgSize);
+		else
+		{
+			bool (*const decompress)(const void*, u32, void*, u32) =
+				(flags & FLAG_LZ4 ? lz4DecompressBounded : lz11DecompressBounded);
+			if(!decompress(src, srcSize, out, imgSize)) return false;
+		}
+
+		if(!tmp) return true;
+		src = tmp;
+	}
+	else if(srcSize < imgSize) return false;
+
+	SplashBlit blit = {src, dst, height};
+	SMP_parallelFor(width, 16, blitColumns, &blit);
+
+	return true;
+}
 
 void getSplashDimensions(const void *const data, u32 *const width, u32 *const height)
 {
@@ -50,42 +130,128 @@ static bool validateSplashHeader(const SplashHeader *const header)
 	return true;
 }
 
-bool drawSplashscreen(const void *const data, s32 startX, s32 startY)
+static bool validateSplashAnim(const SplashHeader *const header, const SplashAnimHeader *const animHeader, u32 size)
+{
+	if(size < sizeof(SplashHeader) + sizeof(SplashAnimHeader)) return false;
+	if(!(header->flags & FLAG_COMPRESSED) || !animHeader->numFrames) return false;
+	if(size < sizeof(SplashHeader) + sizeof(SplashAnimHeader) + animHeader->numFrames * sizeof(SplashFrame))
+		return false;
+	if(animHeader->frames[0].x != 0 || animHeader->frames[0].width != header->width) return false;
+
+	for(u32 i = 0; i < animHeader->numFrames; i++)
+	{
+		const SplashFrame *const frame = &animHeader->frames[i];
+		if(!frame->width || frame->x + frame->width > header->width) return false;
+		if(frame->offset >= size) return false;
+	}
+
+	return true;
+}
+
+bool drawSplashscreen(const void *const data, u32 size, bool trusted, s32 startX, s32 startY)
 {
 	const SplashHeader *const header = (const SplashHeader *const)data;
-	if(!validateSplashHeader(header)) return false;
+	if(size < sizeof(SplashHeader) || !validateSplashHeader(header)) return false;
+
+	endSplashscreen();
 
 	const u32 width = header->width, height = header->height;
 	const u32 flags = header->flags;
 	const bool isCompressed = flags & FLAG_COMPRESSED;
 
-	u16 *imgData;
-	if(isCompressed)
-	{
-		imgData = (u16*)malloc(width * height * 2);
-		if(!imgData) return false;
-		lz11Decompress(data + sizeof(SplashHeader), imgData, width * height * 2);
-	}
-	else imgData = (u16*)(data + sizeof(SplashHeader));
-
 	u32 xx, yy;
 	if(startX < 0 || (u32)startX > SCREEN_WIDTH_TOP - width) xx = (SCREEN_WIDTH_TOP - width) / 2;
 	else xx = (u32)startX;
 	if(startY < 0 || (u32)startY > SCREEN_HEIGHT_TOP - height) yy = (SCREEN_HEIGHT_TOP - height) / 2;
 	else yy = (u32)startY;
 
-	u16 *fb = (u16*)RENDERBUF_TOP;
-	for(u32 x = 0; x < width; x++)
+	u32 imgOffset = sizeof(SplashHeader);
+	if(flags & FLAG_ANIMATED)
+	{
+		const SplashAnimHeader *const animHeader = (const SplashAnimHeader*)(data + imgOffset);
+		if(!validateSplashAnim(header, animHeader, size)) return false;
+		imgOffset = animHeader->frames[0].offset;
+	}
+
+	u16 *const dst = (u16*)RENDERBUF_TOP + xx * SCREEN_HEIGHT_TOP + yy;
+	// Full height images have the same layout as the framebuffer
+	// so they can be decompressed in place.
+	u16 *tmp = NULL;
+	if(isCompressed && height != SCREEN_HEIGHT_TOP)
+	{
+		tmp = (u16*)malloc(width * height * 2);
+		if(!tmp) return false;
+	}
+
+	perfBoostBegin("splash");
+	const bool drawn = blitImage(data + imgOffset, size - imgOffset, flags, trusted, tmp, dst, width, height);
+	perfBoostEnd();
+	GFX_markDirty(SCREEN_TOP, xx, width);
+	if(!drawn)
+	{
+		free(tmp);
+		return false;
+	}
+
+	if(flags & FLAG_ANIMATED)
+	{
+		const SplashAnimHeader *const animHeader = (const SplashAnimHeader*)(data + sizeof(SplashHeader));
+		const u32 duration = animHeader->frames[0].duration;
+
+		// the decode buffer is kept for the following frames
+		anim = (SplashAnim){data, size, flags, trusted, animHeader, tmp, dst, xx, height, 0, (duration ? duration : 1), animHeader->loops};
+	}
+	else free(tmp);
+
+	updateScreens();
+	GFX_waitForPresent();
+
+	return true;
+}
+
+bool isSplashAnimating(void)
+{
+	return anim.header != NULL;
+}
+
+// expected to be called once per VBlank
+void updateSplashscreen(void)
+{
+	if(!anim.header || --anim.vblanksLeft) return;
+
+	u32 next = anim.frame + 1;
+	if(next == anim.header->numFrames)
 	{
-		for(u32 y = 0; y < height; y++)
+		// the last frame stays on screen
+		if(anim.loopsLeft == 1)
 		{
-			fb[(x + xx) * SCREEN_HEIGHT_TOP + y + yy] = imgData[x * height + y];
+			endSplashscreen();
+			return;
 		}
+		if(anim.loopsLeft) anim.loopsLeft--;
+		next = 0;
 	}
 
-	if(isCompressed) free(imgData);
+	// don't touch the render buffer before the previous frame has been copied
+	GFX_waitForPresent();
 
+	const SplashFrame *const frame = &anim.header->frames[next];
+	const bool drawn = blitImage(anim.data + frame->offset, anim.size - frame->offset, anim.flags, anim.trusted, anim.frameBuf,
+	                             anim.dst + frame->x * SCREEN_HEIGHT_TOP, frame->width, anim.height);
+	GFX_markDirty(SCREEN_TOP, anim.x + frame->x, frame->width);
 	updateScreens();
+	if(!drawn)
+	{
+		endSplashscreen();
+		return;
+	}
 
-	return true;
+	anim.frame = next;
+	anim.vblanksLeft = (frame->duration ? frame->duration : 1);
+}
+
+void endSplashscreen(void)
+{
+	free(anim.frameBuf);
+	anim = (SplashAnim){0};
 }
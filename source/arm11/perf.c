@@ -0,0 +1,163 @@
+/*
+ *   This file is part of fastboot 3DS
+ *   Copyright (C) 2017 derrek, profi200
+ *
+ *   This program is free software: you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License as published by
+ *   the Free Software Foundation, either version 3 of the License, or
+ *   (at your option) any later version.
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "types.h"
+#include "arm11/perf.h"
+#include "arm11/hardware/cfg11.h"
+#include "arm11/hardware/cpu.h"
+#include "arm11/hardware/interrupt.h"
+#include "fb_assert.h"
+#include "arm.h"
+#ifndef NDEBUG
+#include "fs.h"
+#include "arm11/fmt.h"
+#include "arm11/hardware/timer.h"
+#include "arm11/hardware/performance_monitor.h"
+#endif
+
+
+// MPCORE_CLKCNT values. Bit 0 is kept as set by core123Init().
+#define CLK_1X  (0u<<1)
+#define CLK_2X  (1u<<1)
+#define CLK_3X  (2u<<1)
+
+#define PERF_LOG_ENTRIES  (32)
+
+
+typedef struct
+{
+	const char *reason; // NULL for the drop back to idle
+	u32 clkCnt;
+	u32 us;             // Time spent boosted. Only set for the drop back to idle.
+} PerfLogEntry;
+
+
+static bool clockControl; // New 3DS only
+static u32 boostDepth;
+static u16 idleClk, boostClk;
+#ifndef NDEBUG
+static u32 boostStart;
+static u32 logPos;
+static PerfLogEntry perfLog[PERF_LOG_ENTRIES];
+#endif
+
+
+
+static bool setClock(u16 clk)
+{
+	if((REG_CFG11_MPCORE_CLKCNT & 7) == clk) return false;
+
+	// CPU_setClock() sleeps until the PDN IRQ registered in __systemInit()
+	// signals the switch. Keep IRQs masked so the IRQ can't be taken before
+	// the WFI and only ends it. Leave its target and enable state alone.
+	const u32 oldState = enterCriticalSection();
+	CPU_setClock(clk);
+	REGs_GID_PEN_CLR[2] = 0x1000000; // Interrupt ID 88
+	leaveCriticalSection(oldState);
+
+	return true;
+}
+
+#ifndef NDEBUG
+static void logTransition(const char *const reason, u32 us)
+{
+	perfLog[logPos++ % PERF_LOG_ENTRIES] = (PerfLogEntry){reason, REG_CFG11_MPCORE_CLKCNT & 7, us};
+}
+#endif
+
+void perfInit(void)
+{
+	// Only New 3DS can change the clock and core123Init()
+	// must have set up the clock hardware
+#ifdef CORE123_INIT
+	if(!(REG_CFG11_SOCINFO & 2)) return;
+#else
+	return;
+#endif
+
+	clockControl = true;
+	const u16 l2 = REG_CFG11_MPCORE_CLKCNT & 1;
+	idleClk = CLK_1X | l2;
+	boostClk = (REG_CFG11_SOCINFO & 4 ? CLK_3X : CLK_2X) | l2;
+
+	if(!boostDepth) setClock(idleClk);
+}
+
+void perfBoostBegin(const char *const reason)
+{
+	fb_assert(__getCpuId() == 0);
+
+	if(boostDepth++ == 0 && clockControl && setClock(boostClk))
+	{
+#ifndef NDEBUG
+		boostStart = getCcnt();
+		logTransition(reason, 0);
+#else
+		(void)reason;
+#endif
+	}
+}
+
+void perfBoostEnd(void)
+{
+	fb_assert(boostDepth > 0);
+
+	if(--boostDepth == 0 && clockControl)
+	{
+#ifndef NDEBUG
+		// The cycle counter runs at CPU clock so convert before switching
+		const u32 us = (u32)(((u64)(getCcnt() - boostStart) * 64) /
+		                     ((u32)(TIMER_BASE_FREQ / 1000000) * perfGetClockMul()));
+		if(setClock(idleClk)) logTransition(NULL, us);
+#else
+		setClock(idleClk);
+#endif
+	}
+}
+
+u32 perfGetClockMul(void)
+{
+	if(!clockControl) return 1;
+	return ((REG_CFG11_MPCORE_CLKCNT & 7)>>1) + 1;
+}
+
+#ifndef NDEBUG
+bool perfDumpLog(const char *const path)
+{
+	const s32 fHandle = fOpen(path, FS_CREATE_ALWAYS | FS_OPEN_WRITE);
+	if(fHandle < 0) return false;
+
+	bool res = true;
+	const u32 first = (logPos > PERF_LOG_ENTRIES ? logPos - PERF_LOG_ENTRIES : 0);
+	for(u32 i = first; i < logPos && res; i++)
+	{
+		const PerfLogEntry *const entry = &perfLog[i % PERF_LOG_ENTRIES];
+		const u32 mhz = (((entry->clkCnt & 7)>>1) + 1) * 268;
+
+		char line[64];
+		u32 len;
+		if(entry->reason) len = ee_snprintf(line, sizeof(line), "boost %lu MHz: %s\n", mhz, entry->reason);
+		else len = ee_snprintf(line, sizeof(line), "idle  %lu MHz after %lu us\n", mhz, entry->us);
+		res = (fWrite(fHandle, line, len) == 0);
+	}
+
+	fClose(fHandle);
+
+	return res;
+}
+#endif
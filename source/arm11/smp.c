@@ -0,0 +1,192 @@
+/*
+ *   This file is part of fastboot 3DS
+ *   Copyright (C) 2017 derrek, profi200
+ *
+ *   This program is free software: you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License as published by
+ *   the Free Software Foundation, either version 3 of the License, or
+ *   (at your option) any later version.
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "types.h"
+#include "arm11/smp.h"
+#include "arm11/spinlock.h"
+#include "arm11/queue.h"
+#include "arm11/start.h"
+#include "arm11/hardware/interrupt.h"
+#include "mem_map.h"
+#include "fb_assert.h"
+#include "arm.h"
+
+
+#define SMP_MAX_CORES   (4)
+#define SMP_QUEUE_SIZE  (4)               // Must be >= SMP_MAX_CORES - 1
+#define SMP_IPI         (IRQ_MPCORE_SW4)  // SW1-3 are used by core123Init()
+// Uncached so it can be written with the MMU and caches off
+#define smpOffline      ((vu32*)A11_SMP_OFFLINE_BASE)
+
+
+typedef struct
+{
+	u32 lock;
+	vu32 pending;
+} SmpGroup;
+
+typedef struct
+{
+	SmpJobFunc func;
+	void *arg;
+	u32 start;
+	u32 end;
+	SmpGroup *group;
+} SmpJob;
+
+
+// Core 0 queues the chunks. Whichever core is free first takes the next one.
+// Statically initialized because workers may poll it before core 0 runs.
+static MpmcCell jobCells[SMP_QUEUE_SIZE] = {{0, 0}, {1, 0}, {2, 0}, {3, 0}};
+static MpmcQueue jobQueue = {.mask = SMP_QUEUE_SIZE - 1, .cells = jobCells};
+static u32 onlineLock;
+static vu32 onlineMask;   // Bit n = core n takes jobs
+static volatile bool workersQuit;
+
+
+
+static void setOnline(u32 cpuId, bool online)
+{
+	spinlockLock(&onlineLock);
+	if(online) onlineMask |= 1u<<cpuId;
+	else       onlineMask &= ~(1u<<cpuId);
+	spinlockUnlock(&onlineLock);
+}
+
+static void runJob(u32 jobPtr)
+{
+	const SmpJob *const job = (const SmpJob*)jobPtr;
+	job->func(job->arg, job->start, job->end);
+
+	SmpGroup *const group = job->group;
+	spinlockLock(&group->lock);
+	group->pending--;
+	spinlockUnlock(&group->lock); // SEV wakes core 0
+}
+
+noreturn void SMP_workerLoop(void)
+{
+	const u32 cpuId = __getCpuId();
+
+	// SW interrupts are always enabled. The IPI needs no handler,
+	// it only wakes us from WFI.
+	__cpsie(i);
+	setOnline(cpuId, true);
+
+	while(1)
+	{
+		u32 jobPtr;
+
+		// Check and sleep with IRQs off. Otherwise the IPI could
+		// arrive right before the WFI and we would miss it.
+		const u32 oldState = enterCriticalSection();
+		while(!mpmcQueuePop(&jobQueue, &jobPtr))
+		{
+			if(workersQuit)
+			{
+				leaveCriticalSection(oldState);
+				setOnline(cpuId, false);
+
+				// Writes back our dirty lines and turns the MMU and caches off.
+				// Only then core 0 may flush the L2 and power off cores.
+				deinitCpu();
+				smpOffline[cpuId] = 1;
+				__dsb();
+				__sev();
+				((void (*)(void))0x0001004C)(); // Back into boot11
+				while(1);
+			}
+
+			__wfi();
+			leaveCriticalSection(oldState);
+			enterCriticalSection();
+		}
+		leaveCriticalSection(oldState);
+
+		runJob(jobPtr);
+	}
+}
+
+void SMP_deinit(void)
+{
+	fb_assert(__getCpuId() == 0);
+
+	const u32 mask = onlineMask;
+	for(u32 cpu = 1; cpu < SMP_MAX_CORES; cpu++) smpOffline[cpu] = 0;
+	workersQuit = true;
+	__dsb();
+	if(mask) IRQ_softwareInterrupt(SMP_IPI, mask);
+
+	for(u32 cpu = 1; cpu < SMP_MAX_CORES; cpu++)
+	{
+		if(mask & 1u<<cpu)
+			while(!smpOffline[cpu]) __wfe();
+	}
+}
+
+u32 SMP_getNumCores(void)
+{
+	return 1 + __builtin_popcount(onlineMask);
+}
+
+void SMP_parallelFor(u32 count, u32 minChunk, SmpJobFunc func, void *arg)
+{
+	u32 mask = (__getCpuId() == 0 && !workersQuit ? onlineMask : 0);
+	u32 cores = 1 + __builtin_popcount(mask);
+	if(minChunk && count / minChunk < cores) cores = count / minChunk;
+	if(cores <= 1)
+	{
+		if(count) func(arg, 0, count);
+		return;
+	}
+
+	// Core 0 takes the first chunk and the remainder
+	const u32 chunk = count / cores;
+	u32 start = count - chunk * (cores - 1);
+	const u32 ownEnd = start;
+	SmpGroup group = {0, 0};
+	SmpJob jobs[SMP_MAX_CORES - 1]; // Valid until all jobs completed
+	bool queued = false;
+	for(u32 i = 0; i < cores - 1; i++)
+	{
+		jobs[i] = (SmpJob){func, arg, start, start + chunk, &group};
+		spinlockLock(&group.lock);
+		group.pending++;
+		spinlockUnlock(&group.lock);
+		if(!mpmcQueuePush(&jobQueue, (u32)&jobs[i]))
+		{
+			// Should never happen. Do it ourself.
+			spinlockLock(&group.lock);
+			group.pending--;
+			spinlockUnlock(&group.lock);
+			func(arg, start, start + chunk);
+		}
+		else queued = true;
+
+		start += chunk;
+	}
+	if(queued) IRQ_softwareInterrupt(SMP_IPI, mask);
+
+	func(arg, 0, ownEnd);
+
+	// Help out with chunks no worker picked up yet
+	u32 jobPtr;
+	while(mpmcQueuePop(&jobQueue, &jobPtr)) runJob(jobPtr);
+
+	while(group.pending) __wfe();
+}
@@ -25,6 +25,9 @@
 #include "arm11/hardware/mcu.h"
 #include "arm11/hardware/hid.h"
 #include "arm11/hardware/cpu.h"
+#include "arm11/smp.h"
+#include "arm11/perf.h"
+#include "arm11/hardware/l2c.h"
 #include "arm.h"
 
 
@@ -42,6 +45,7 @@ void WEAK __systemInit(void)
 	const u32 cpuId = __getCpuId();
 	if(!cpuId)
 	{
+		L2C_init();
 		IRQ_registerHandler(IRQ_PDN, 0, 0b1111, true, NULL);
 		I2C_init();
 		hidInit();
@@ -51,19 +55,21 @@ void WEAK __systemInit(void)
 	}
 	else
 	{
-		// We don't need core 1 yet so back it goes into boot11.
-		// Core 2 and 3 also go there waiting until poweroff.
-		deinitCpu();
-		((void (*)(void))0x0001004C)();
+		// Core 1-3 run jobs for core 0 until deinit. Then they go
+		// back into boot11. Core 2 and 3 wait there until poweroff.
+		SMP_workerLoop();
 	}
 
 	__cpsie(i); // Enables interrupts
-#ifdef CORE123_INIT
-	CPU_poweroffCore23();
-#endif
+	perfInit();
 }
 
 void WEAK __systemDeinit(void)
 {
+#ifdef CORE123_INIT
+	SMP_deinit();
+	L2C_deinit(); // The next firm expects the L2 off and memory up to date
+	CPU_poweroffCore23();
+#endif
 	IRQ_init();
 }
@@ -103,13 +103,9 @@ noreturn void guruMeditation(UNUSED u8 type, UNUSED const u32 *excStack)
 
 void dumpMem(u8 *mem, u32 size, char *filepath)
 {
-	FIL file;
-	UINT bytesWritten;
+	const s32 file = fOpen(filepath, FS_CREATE_ALWAYS | FS_OPEN_WRITE);
+	if(file < 0) return;
 
-	if(f_open(&file, filepath, FA_CREATE_ALWAYS | FA_WRITE) != FR_OK)
-		return;
-
-	f_write(&file, mem, size, &bytesWritten);
-	f_sync(&file);
-	f_close(&file);
+	fWrite(file, mem, size);
+	fClose(file);
 }
@@ -35,6 +35,10 @@
 #include "system.h"
 
 
+// Firms are loaded in chunks of this size to report progress
+#define FIRM_LOAD_CHUNK_SIZE  (0x40000)
+
+
 typedef struct
 {
 	u32 addr;
@@ -53,8 +57,12 @@ static const FirmWhitelist bootWhitelist[] =
 	{ // VRAM excluding the FIRM buffer
 		VRAM_BASE, VRAM_SIZE - 0x400000
 	},
-	{ // DSP memory + AXIWRAM excluding stack and FIRM launch stub
-		DSP_MEM_BASE, DSP_MEM_SIZE + AXIWRAM_SIZE - 0x220
+	{ // DSP memory + AXIWRAM up to the PXI ring. The ring page holds the ARM11
+	  // SMP offline handshake which is still polled while sections are copied.
+		DSP_MEM_BASE, PXI_RING_BASE - DSP_MEM_BASE
+	},
+	{ // AXIWRAM after the PXI ring excluding stack and FIRM launch stub
+		PXI_RING_BASE + PXI_RING_SIZE, AXIWRAM_BASE + AXIWRAM_SIZE - 0x220 - (PXI_RING_BASE + PXI_RING_SIZE)
 	},
 	{ // FCRAM
 		FCRAM_BASE, FCRAM_SIZE + FCRAM_N3DS_EXT_SIZE
@@ -202,9 +210,14 @@ s32 loadVerifyFirm(const char *const path, bool skipHashCheck, bool installMode)
 
 		if(!dev_decnand->read_sector(sector, 1, (void*)FIRM_LOAD_ADDR)) return -4;
 		if(!firm_size((size_t*)&firmSize)) return -5;
-		sector++;
-		if(!dev_decnand->read_sector(sector, (firmSize>>9) - 1, (void*)(FIRM_LOAD_ADDR + sizeof(firm_header))))
-			return -4;
+		for(u32 done = sizeof(firm_header); done < firmSize; )
+		{
+			const u32 readSize = min(firmSize - done, FIRM_LOAD_CHUNK_SIZE);
+			if(!dev_decnand->read_sector(sector + (done>>9), readSize>>9, (void*)(FIRM_LOAD_ADDR + done)))
+				return -4;
+			done += readSize;
+			PXI_setProgress(done, firmSize);
+		}
 	}
 	else
 	{
@@ -217,10 +230,16 @@ s32 loadVerifyFirm(const char *const path, bool skipHashCheck, bool installMode)
 			fClose(f);
 			return -7;
 		}
-		if(fRead(f, (void*)FIRM_LOAD_ADDR, firmSize) < 0)
+		for(u32 done = 0; done < firmSize; )
 		{
-			fClose(f);
-			return -8;
+			const u32 readSize = min(firmSize - done, FIRM_LOAD_CHUNK_SIZE);
+			if(fRead(f, (void*)(FIRM_LOAD_ADDR + done), readSize) < 0)
+			{
+				fClose(f);
+				return -8;
+			}
+			done += readSize;
+			PXI_setProgress(done, firmSize);
 		}
 
 		fClose(f);
@@ -27,6 +27,7 @@
 #include "arm9/hardware/cfg9.h"
 #include "util.h"
 #include "arm9/hardware/crypto.h"
+#include "hardware/pxi.h"
 #include "fastboot3DS_pubkey_bin.h"
 
 
@@ -95,6 +96,7 @@ s32 writeFirmPartition(const char *const part, bool replaceSig)
 	u8 *const cmpBuf = (u8*)malloc(FIRMWRITER_BLK_SIZE);
 	if(!cmpBuf) return -6;
 
+	const u32 progressTotal = firmSize;
 	while(firmSize)
 	{
 		const u32 writeSize = min(firmSize, FIRMWRITER_BLK_SIZE);
@@ -114,6 +116,7 @@ s32 writeFirmPartition(const char *const part, bool replaceSig)
 		sector += writeSize>>9;
 		firmSize -= writeSize;
 		firmBuf += writeSize;
+		PXI_setProgress(progressTotal - firmSize, progressTotal);
 	}
 
 	free(cmpBuf);
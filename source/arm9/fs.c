@@ -25,6 +25,8 @@
 #include "arm9/dev.h"
 #include "arm9/ncsd.h"
 #include "arm9/partitions.h"
+#include "arm9/hardware/crypto.h"
+#include "arm9/hardware/sdmmc.h"
 #include "fatfs/ff.h"
 
 
@@ -33,6 +35,8 @@ typedef struct
 	u8 *mem;
 	size_t memSize;
 	size_t dataSize;
+	bool hashActive;  // SHA engine is fed with everything read to the buffer
+	bool hashTail;    // Last update was not a multiple of the SHA block size
 } DevBuf;
 
 typedef struct
@@ -61,6 +65,10 @@ static bool fsStatBackupTable[FS_MAX_DRIVES] = {0};
 
 static DevBuf devBuf;
 
+// FatFs uses UTF-16 names (FF_LFN_UNICODE 1). Everything else uses UTF-8.
+static WCHAR pathBuf[2][FF_MAX_LFN + 1];
+static FILINFO fileInfo;
+
 static ProtNandRegion protNandRegions[MAX_PARTITIONS + 2]  = {0};
 static size_t numProtNandRegions;
 
@@ -68,6 +76,106 @@ static size_t numProtNandRegions;
 
 static bool isFileHandleValid(s32 handle);
 
+// Converts a UTF-8 path to UTF-16 in pathBuf[buf]. Encoded surrogates are
+// accepted so names with unpaired surrogates from nameToUtf8() round trip.
+// Returns NULL for invalid UTF-8 or paths longer than FF_MAX_LFN.
+static const WCHAR* pathToUtf16(const char *path, u32 buf)
+{
+	WCHAR *const out = pathBuf[buf];
+	u32 len = 0;
+
+	while(*path)
+	{
+		static const u32 minCodepoint[4] = {0, 0x80, 0x800, 0x10000};
+		u32 c = (u8)*path++;
+		u32 left = 0;
+		if(c >= 0x80)
+		{
+			if(c >= 0xC2 && c <= 0xDF) left = 1;
+			else if((c & 0xF0u) == 0xE0) left = 2;
+			else if(c >= 0xF0 && c <= 0xF4) left = 3;
+			else return NULL;
+			c &= 0x3Fu>>left;
+		}
+		const u32 min = minCodepoint[left];
+
+		for(; left; left--)
+		{
+			const u32 b = (u8)*path++;
+			if((b & 0xC0u) != 0x80) return NULL;
+			c = c<<6 | (b & 0x3Fu);
+		}
+		if(c < min || c > 0x10FFFF) return NULL;
+
+		if(c >= 0x10000)
+		{
+			if(len + 2 > FF_MAX_LFN) return NULL;
+			c -= 0x10000;
+			out[len++] = 0xD800 | c>>10;
+			out[len++] = 0xDC00 | (c & 0x3FFu);
+		}
+		else
+		{
+			if(len + 1 > FF_MAX_LFN) return NULL;
+			out[len++] = c;
+		}
+	}
+	out[len] = 0;
+
+	return out;
+}
+
+// Converts a UTF-16 name to UTF-8. Returns false if it doesn't fit.
+static bool nameToUtf8(const WCHAR *name, char *out, u32 size)
+{
+	u32 len = 0;
+
+	while(*name)
+	{
+		u32 c = *name++;
+		if((c & 0xFC00u) == 0xD800 && (*name & 0xFC00u) == 0xDC00)
+			c = 0x10000 + ((c & 0x3FFu)<<10 | (*name++ & 0x3FFu));
+
+		const u32 bytes = (c < 0x80 ? 1 : (c < 0x800 ? 2 : (c < 0x10000 ? 3 : 4)));
+		if(len + bytes >= size) return false;
+		switch(bytes)
+		{
+			case 1:
+				out[len++] = c;
+				break;
+			case 2:
+				out[len++] = 0xC0 | c>>6;
+				out[len++] = 0x80 | (c & 0x3Fu);
+				break;
+			case 3:
+				out[len++] = 0xE0 | c>>12;
+				out[len++] = 0x80 | (c>>6 & 0x3Fu);
+				out[len++] = 0x80 | (c & 0x3Fu);
+				break;
+			default:
+				out[len++] = 0xF0 | c>>18;
+				out[len++] = 0x80 | (c>>12 & 0x3Fu);
+				out[len++] = 0x80 | (c>>6 & 0x3Fu);
+				out[len++] = 0x80 | (c & 0x3Fu);
+		}
+	}
+	out[len] = '\0';
+
+	return true;
+}
+
+static void fileInfoToUtf8(const FILINFO *const fno, FsFileInfo *fi)
+{
+	fi->fsize = fno->fsize;
+	fi->fdate = fno->fdate;
+	fi->ftime = fno->ftime;
+	fi->fattrib = fno->fattrib;
+
+	// Like FatFs does for names the API can't represent
+	if(!nameToUtf8(fno->fname, fi->fname, sizeof(fi->fname)))
+		nameToUtf8(fno->altname, fi->fname, sizeof(fi->fname));
+}
+
 static inline bool isNandProtected()
 {
 	return numProtNandRegions != 0;
@@ -103,7 +211,7 @@ s32 fMount(FsDrive drive)
 	if((u32)drive >= FS_MAX_DRIVES) return -30;
 	if(fsStatTable[drive]) return -31;
 
-	FRESULT res = f_mount(&fsTable[drive], fsPathTable[drive], 1);
+	FRESULT res = f_mount(&fsTable[drive], pathToUtf16(fsPathTable[drive], 0), 1);
 	if(res == FR_OK)
 	{
 		fsStatTable[drive] = true;
@@ -117,7 +225,7 @@ s32 fUnmount(FsDrive drive)
 	if((u32)drive >= FS_MAX_DRIVES) return -30;
 	if(!fsStatTable[drive]) return -31;
 
-	FRESULT res = f_mount(NULL, fsPathTable[drive], 0);
+	FRESULT res = f_mount(NULL, pathToUtf16(fsPathTable[drive], 0), 0);
 	fsStatTable[drive] = false;
 
 	if(res == FR_OK) return FR_OK;
@@ -154,7 +262,7 @@ s32 fGetFree(FsDrive drive, u64 *size)
 
 	DWORD freeClusters;
 	FATFS *fs;
-	FRESULT res = f_getfree(fsPathTable[drive], &freeClusters, &fs);
+	FRESULT res = f_getfree(pathToUtf16(fsPathTable[drive], 0), &freeClusters, &fs);
 	if(res == FR_OK)
 	{
 		if(size) *size = ((u64)(freeClusters * fs->csize)) * 512;
@@ -197,6 +305,15 @@ bool fIsDevActive(FsDevice dev)
 	return false;
 }
 
+s32 fGetDeviceCid(FsDevice dev, u32 cid[4])
+{
+	if(!fIsDevActive(dev)) return -30;
+	
+	if(sdmmc_get_cid(dev == FS_DEVICE_NAND, cid)) return -31;
+	
+	return FR_OK;
+}
+
 s32 fPrepareRawAccess(FsDevice dev)
 {
 	s32 err;
@@ -320,6 +437,7 @@ static bool devBufFree(DevBuf *devBuf)
 	devBuf->mem = NULL;
 	
 	devBuf->memSize = 0;
+	devBuf->hashActive = false;
 	
 	return true;
 }
@@ -402,6 +520,16 @@ s32 fReadToDeviceBuffer(s32 sourceHandle, u32 sourceOffset, u32 sourceSize, DevB
 	
 	devBuf.dataSize = sourceSize;
 	
+	if(devBuf.hashActive)
+	{
+		// A partial block can only be followed by the final hash
+		if(devBuf.hashTail)
+			return -31;
+		
+		SHA_update((const u32*)devBuf.mem, sourceSize);
+		devBuf.hashTail = (sourceSize % 0x40) != 0;
+	}
+	
 	return FR_OK;
 }
 
@@ -527,6 +655,89 @@ s32 fsWriteFromDeviceBuffer(s32 destHandle, u32 destOffset, u32 destSize, DevBuf
 	return FR_OK;
 }
 
+// Starts hashing all data read to the device buffer with SHA-256.
+// Note: nothing else may use the SHA engine until the hash is fetched.
+s32 fStartDeviceBufferHash(DevBufHandle devBufHandle)
+{
+	if(!isValidDevBufHandle(devBufHandle))
+		return -30;
+	
+	SHA_start(SHA_INPUT_BIG | SHA_MODE_256);
+	devBuf.hashActive = true;
+	devBuf.hashTail = false;
+	
+	return FR_OK;
+}
+
+// Finishes the hash started with fStartDeviceBufferHash().
+s32 fGetDeviceBufferHash(DevBufHandle devBufHandle, u32 hash[8])
+{
+	if(!isValidDevBufHandle(devBufHandle) || !devBuf.hashActive)
+		return -30;
+	
+	SHA_finish(hash, SHA_OUTPUT_BIG);
+	devBuf.hashActive = false;
+	
+	return FR_OK;
+}
+
+// Saves the running hash so it can be continued after a restart.
+s32 fSaveDeviceBufferHash(DevBufHandle devBufHandle, FsHashState *state)
+{
+	if(!isValidDevBufHandle(devBufHandle) || !devBuf.hashActive || devBuf.hashTail)
+		return -30;
+	
+	SHA_getState(state->state);
+	
+	return FR_OK;
+}
+
+// Checks once that the SHA engine continues from a state written back with
+// SHA_setState() by hashing 2 blocks in one go and split at a saved state.
+static bool shaStateRestoreWorks(void)
+{
+	static s8 works = -1;
+	
+	if(works < 0)
+	{
+		u32 data[32];
+		u32 state[9];
+		u32 ref[8];
+		u32 hash[8];
+		
+		for(u32 i = 0; i < 32; i++) data[i] = i * 0x9E3779B9u;
+		sha(data, sizeof(data), ref, SHA_INPUT_BIG | SHA_MODE_256, SHA_OUTPUT_BIG);
+		
+		SHA_start(SHA_INPUT_BIG | SHA_MODE_256);
+		SHA_update(data, 0x40);
+		SHA_getState(state);
+		SHA_start(SHA_INPUT_BIG | SHA_MODE_256); // Throw the state away
+		SHA_setState(SHA_INPUT_BIG | SHA_MODE_256, state);
+		SHA_update(data + 16, 0x40);
+		SHA_finish(hash, SHA_OUTPUT_BIG);
+		
+		works = (memcmp(ref, hash, sizeof(hash)) == 0);
+	}
+	
+	return works;
+}
+
+// Continues a hash saved with fSaveDeviceBufferHash().
+// Fails with -31 if the SHA engine can't resume hashes.
+s32 fResumeDeviceBufferHash(DevBufHandle devBufHandle, const FsHashState *state)
+{
+	if(!isValidDevBufHandle(devBufHandle))
+		return -30;
+	if(!shaStateRestoreWorks())
+		return -31;
+	
+	SHA_setState(SHA_INPUT_BIG | SHA_MODE_256, state->state);
+	devBuf.hashActive = true;
+	devBuf.hashTail = false;
+	
+	return FR_OK;
+}
+
 static s32 findUnusedFileSlot(void)
 {
 	if(fHandles >= FS_MAX_FILES) return -1;
@@ -553,7 +764,10 @@ s32 fOpen(const char *const path, FsOpenMode mode)
 	const s32 i = findUnusedFileSlot();
 	if(i < 0) return -30;
 
-	FRESULT res = f_open(&fTable[i], path, mode);
+	const WCHAR *const fatPath = pathToUtf16(path, 0);
+	if(!fatPath) return -FR_INVALID_NAME;
+
+	FRESULT res = f_open(&fTable[i], fatPath, mode);
 	if(res == FR_OK)
 	{
 		fStatTable[i] = true;
@@ -640,8 +854,15 @@ s32 fExpand(s32 handle, u32 size)
 
 s32 fStat(const char *const path, FsFileInfo *fi)
 {
-	FRESULT res = f_stat(path, fi);
-	if(res == FR_OK) return res;
+	const WCHAR *const fatPath = pathToUtf16(path, 0);
+	if(!fatPath) return -FR_INVALID_NAME;
+
+	FRESULT res = f_stat(fatPath, (fi ? &fileInfo : NULL));
+	if(res == FR_OK)
+	{
+		if(fi) fileInfoToUtf8(&fileInfo, fi);
+		return res;
+	}
 	else return -res;
 }
 
@@ -671,7 +892,10 @@ s32 fOpenDir(const char *const path)
 	const s32 i = findUnusedDirSlot();
 	if(i < 0) return -30;
 
-	FRESULT res = f_opendir(&dTable[i], path);
+	const WCHAR *const fatPath = pathToUtf16(path, 0);
+	if(!fatPath) return -FR_INVALID_NAME;
+
+	FRESULT res = f_opendir(&dTable[i], fatPath);
 	if(res == FR_OK)
 	{
 		dStatTable[i] = true;
@@ -689,9 +913,11 @@ s32 fReadDir(s32 handle, FsFileInfo *fi, u32 num)
 	u32 i;
 	for(i = 0; i < num; i++)
 	{
-		FRESULT res = f_readdir(&dTable[handle], &fi[i]);
+		FRESULT res = f_readdir(&dTable[handle], &fileInfo);
 		if(res != FR_OK) return -res;
-		if(!fi[i].fname[0]) break;
+		if(!fileInfo.fname[0]) break;
+
+		fileInfoToUtf8(&fileInfo, &fi[i]);
 	}
 
 	return i;
@@ -711,21 +937,31 @@ s32 fCloseDir(s32 handle)
 
 s32 fMkdir(const char *const path)
 {
-	FRESULT res = f_mkdir(path);
+	const WCHAR *const fatPath = pathToUtf16(path, 0);
+	if(!fatPath) return -FR_INVALID_NAME;
+
+	FRESULT res = f_mkdir(fatPath);
 	if(res == FR_OK) return res;
 	else return -res;
 }
 
 s32 fRename(const char *const old, const char *const new)
 {
-	FRESULT res = f_rename(old, new);
+	const WCHAR *const fatOld = pathToUtf16(old, 0);
+	const WCHAR *const fatNew = pathToUtf16(new, 1);
+	if(!fatOld || !fatNew) return -FR_INVALID_NAME;
+
+	FRESULT res = f_rename(fatOld, fatNew);
 	if(res == FR_OK) return res;
 	else return -res;
 }
 
 s32 fUnlink(const char *const path)
 {
-	FRESULT res = f_unlink(path);
+	const WCHAR *const fatPath = pathToUtf16(path, 0);
+	if(!fatPath) return -FR_INVALID_NAME;
+
+	FRESULT res = f_unlink(fatPath);
 	if(res == FR_OK) return res;
 	else return -res;
 }
@@ -810,6 +1046,65 @@ done:
 	return ret;
 }
 
+s32 fGetNandPartition(const char *const name, FsNandPartition *part)
+{
+	partitionStruct partInfo;
+	size_t index;
+	
+	memset(part, 0, sizeof(FsNandPartition));
+	
+	if(!partitionGetIndex(name, &index) || !partitionGetInfo(index, &partInfo))
+		return -30;
+	
+	/* index in our table is the index in the NCSD header */
+	memcpy(part->name, partInfo.name, sizeof(partInfo.name));
+	part->sector = partInfo.sector;
+	part->count = partInfo.count;
+	part->type = partInfo.type;
+	part->ncsdIndex = index;
+	
+	return FR_OK;
+}
+
+s32 fVerifyNandPartImage(const char *const path)
+{
+	NandPartImageHeader header;
+	FsNandPartition physicalPart;
+	s32 fHandle;
+	s32 ret = -30;
+
+	fHandle = fOpen(path, FS_OPEN_READ);
+	if(fHandle < 0) return ret;
+	
+	if(fRead(fHandle, &header, sizeof(header)) != FR_OK)
+		goto done;
+	
+	if(header.magic != NAND_PART_IMAGE_MAGIC || header.headerSize != sizeof(header))
+		goto done;
+	
+	header.part.name[sizeof(header.part.name) - 1] = '\0';
+	
+	/* must match the current partition layout exactly */
+	if(fGetNandPartition(header.part.name, &physicalPart) != FR_OK)
+		goto done;
+	
+	if(memcmp(&header.part, &physicalPart, sizeof(physicalPart)))
+		goto done;
+	
+	if((u64)fSize(fHandle) != header.headerSize + ((u64)physicalPart.count << 9))
+		goto done;
+	
+	/* success! */
+	
+	ret = FR_OK;
+	
+done:
+
+	fClose(fHandle);
+	
+	return ret;
+}
+
 s32 fSetNandProtection(bool protect)
 {
 	static const ProtNandRegion defaultProt[] = {
@@ -840,7 +1135,7 @@ s32 fSetNandProtection(bool protect)
 		{
 			if(partitionGetInfo(i, &partInfo))
 			{
-				if(partInfo.type != 3) // is not a firmware?
+				if(partInfo.type != NAND_PART_TYPE_FIRM) // is not a firmware?
 					continue;
 				
 				/* Check if we can merge two adjacent regions */
@@ -870,6 +1165,74 @@ s32 fSetNandProtection(bool protect)
 	return FR_OK;
 }
 
+static s32 readWholeFile(const char *const path, void *const buf, u32 bufSize)
+{
+	const s32 handle = fOpen(path, FS_OPEN_EXISTING | FS_OPEN_READ);
+	if(handle < 0) return handle;
+
+	const u32 size = fSize(handle);
+	s32 res;
+	if(size > bufSize) res = -31;
+	else if((res = fRead(handle, buf, size)) == FR_OK) res = size;
+
+	fClose(handle);
+
+	return res;
+}
+
+s32 fBatch(FsBatchOp *ops, u32 num)
+{
+	if(num > FS_BATCH_MAX_OPS) return -30;
+
+	s32 prev = -30;
+	s32 failed = 0;
+	for(u32 i = 0; i < num; i++)
+	{
+		FsBatchOp *const op = &ops[i];
+		const u32 arg = (op->arg == FS_BATCH_PREV_RESULT ? (u32)prev : op->arg);
+		s32 res;
+
+		switch(op->type)
+		{
+			case FS_BATCH_MOUNT:
+				res = fMount(arg);
+				break;
+			case FS_BATCH_STAT:
+				res = fStat(op->path, op->out);
+				break;
+			case FS_BATCH_OPEN:
+				res = fOpen(op->path, arg);
+				break;
+			case FS_BATCH_READ:
+				res = fRead(arg, op->out, op->outSize);
+				break;
+			case FS_BATCH_CLOSE:
+				res = fClose(arg);
+				break;
+			case FS_BATCH_OPEN_DIR:
+				res = fOpenDir(op->path);
+				break;
+			case FS_BATCH_READ_DIR:
+				res = fReadDir(arg, op->out, op->outSize / sizeof(FsFileInfo));
+				break;
+			case FS_BATCH_CLOSE_DIR:
+				res = fCloseDir(arg);
+				break;
+			case FS_BATCH_READ_FILE:
+				res = readWholeFile(op->path, op->out, op->outSize);
+				break;
+			default:
+				res = -30;
+		}
+
+		op->result = prev = res;
+		if(res < 0) failed++;
+	}
+
+	// Number of failed ops. The caller checks the per op results.
+	return failed;
+}
+
 void fsDeinit(void)
 {
 	for(u32 i = 0; i < FS_MAX_FILES; i++) fClose(i);
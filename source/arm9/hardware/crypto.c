@@ -629,6 +629,22 @@ void SHA_finish(u32 *const hash, u8 endianess)
 	for(u32 i = 0; i < hashSize; i++) hash[i] = REG_SHA_HASH[i];
 }
 
+void SHA_getState(u32 state[9])
+{
+	for(u32 i = 0; i < 8; i++) state[i] = REG_SHA_HASH[i];
+	state[8] = REG_SHA_BLKCNT;
+}
+
+void SHA_setState(u8 params, const u32 state[9])
+{
+	// Starting loads the initial hash values so the
+	// saved state must be written afterwards.
+	SHA_start(params);
+
+	for(u32 i = 0; i < 8; i++) REG_SHA_HASH[i] = state[i];
+	REG_SHA_BLKCNT = state[8];
+}
+
 void sha(const u32 *data, u32 size, u32 *const hash, u8 params, u8 hashEndianess)
 {
 	SHA_start(params);
@@ -21,6 +21,7 @@
 #include "mem_map.h"
 #include "ipc_handler.h"
 #include "hardware/cache.h"
+#include "hardware/pxi.h"
 #include "arm9/debug.h"
 #include "fs.h"
 #include "arm9/firm.h"
@@ -34,7 +35,8 @@ u32 IPC_handleCmd(u8 cmdId, u32 inBufs, u32 outBufs, const u32 *const buf)
 	for(u32 i = 0; i < inBufs; i++)
 	{
 		const IpcBuffer *const inBuf = (IpcBuffer*)&buf[i * sizeof(IpcBuffer) / 4];
-		if(inBuf->ptr && inBuf->size) invalidateDCacheRange(inBuf->ptr, inBuf->size);
+		if(inBuf->ptr && inBuf->size && !PXI_isRingBuffer(inBuf->ptr))
+			invalidateDCacheRange(inBuf->ptr, inBuf->size);
 	}
 
 	u32 result = 0;
@@ -153,6 +155,44 @@ u32 IPC_handleCmd(u8 cmdId, u32 inBufs, u32 outBufs, const u32 *const buf)
 		case IPC_CMD_ID_MASK(IPC_CMD9_EXCEPTION):
 			fsDeinit();
 			break;
+		case IPC_CMD_ID_MASK(IPC_CMD9_FSTART_DEV_BUF_HASH):
+			result = fStartDeviceBufferHash(buf[0]);
+			break;
+		case IPC_CMD_ID_MASK(IPC_CMD9_FGET_DEV_BUF_HASH):
+			result = fGetDeviceBufferHash(buf[2], (u32*)buf[0]);
+			break;
+		case IPC_CMD_ID_MASK(IPC_CMD9_FGET_NAND_PART):
+			result = fGetNandPartition((const char *const)buf[0], (FsNandPartition*)buf[2]);
+			break;
+		case IPC_CMD_ID_MASK(IPC_CMD9_FVERIFY_NAND_PART):
+			result = fVerifyNandPartImage((const char *const)buf[0]);
+			break;
+		case IPC_CMD_ID_MASK(IPC_CMD9_FSAVE_DEV_BUF_HASH):
+			result = fSaveDeviceBufferHash(buf[2], (FsHashState*)buf[0]);
+			break;
+		case IPC_CMD_ID_MASK(IPC_CMD9_FRESUME_DEV_BUF_HASH):
+			result = fResumeDeviceBufferHash(buf[2], (const FsHashState*)buf[0]);
+			break;
+		case IPC_CMD_ID_MASK(IPC_CMD9_FGET_DEV_CID):
+			result = fGetDeviceCid(buf[2], (u32*)buf[0]);
+			break;
+		case IPC_CMD_ID_MASK(IPC_CMD9_FBATCH):
+			{
+				FsBatchOp *const ops = (FsBatchOp*)buf[0];
+				const u32 num = buf[1] / sizeof(FsBatchOp);
+				for(u32 i = 0; i < num; i++)
+				{
+					if(ops[i].path) invalidateDCacheRange(ops[i].path, ops[i].pathSize);
+				}
+
+				result = fBatch(ops, num);
+
+				for(u32 i = 0; i < num; i++)
+				{
+					if(ops[i].out && ops[i].outSize) flushInvalidateDCacheRange(ops[i].out, ops[i].outSize);
+				}
+			}
+			break;
 		default:
 			panic();
 	}
@@ -160,7 +200,8 @@ u32 IPC_handleCmd(u8 cmdId, u32 inBufs, u32 outBufs, const u32 *const buf)
 	for(u32 i = inBufs; i < inBufs + outBufs; i++)
 	{
 		const IpcBuffer *const outBuf = (IpcBuffer*)&buf[i * sizeof(IpcBuffer) / 4];
-		if(outBuf->ptr && outBuf->size) flushInvalidateDCacheRange(outBuf->ptr, outBuf->size);
+		if(outBuf->ptr && outBuf->size && !PXI_isRingBuffer(outBuf->ptr))
+			flushInvalidateDCacheRange(outBuf->ptr, outBuf->size);
 	}
 
 	return result;
@@ -258,7 +258,7 @@ setupMpu:
 	@ Region 4 = yes
 	@ Region 5 = no
 	@ Region 6 = yes
-	@ Region 7 = no
+	@ Region 7 = no  <-- PXI request ring, shared with the ARM11
 	mov r0, #0b01011010
 	mcr p15, 0, r0, c2, c0, 0   @ Data cachable bits
 
@@ -300,7 +300,7 @@ _mpu_regions:
 	@ Region 4: DSP mem and AXIWRAM 1 MB
 	@ Region 5: DTCM 16 KB
 	@ Region 6: Exception vectors + ARM9 bootrom 64 KB
-	@ Region 7: - (reserved)
+	@ Region 7: PXI request ring 4 KB (overlaps region 4)
 	.word MAKE_REGION(ITCM_KERNEL_MIRROR, REGION_32KB)
 	.word MAKE_REGION(A9_RAM_BASE,        REGION_2MB)
 	.word MAKE_REGION(IO_MEM_ARM9_ONLY,   REGION_2MB)
@@ -308,7 +308,7 @@ _mpu_regions:
 	.word MAKE_REGION(DSP_MEM_BASE,       REGION_1MB)
 	.word MAKE_REGION(DTCM_BASE,          REGION_16KB)
 	.word MAKE_REGION(BOOT9_BASE,         REGION_64KB)
-	.word 0
+	.word MAKE_REGION(PXI_RING_BASE,      REGION_4KB)
 _mpu_permissions:
 	@ Data access permissions:
 	@ Region 0: User = --, Privileged = RW
@@ -318,11 +318,11 @@ _mpu_permissions:
 	@ Region 4: User = --, Privileged = RW
 	@ Region 5: User = --, Privileged = RW
 	@ Region 6: User = --, Privileged = RO
-	@ Region 7: User = --, Privileged = --
+	@ Region 7: User = --, Privileged = RW
 	.word MAKE_PERMISSIONS(PER_PRIV_RW_USR_NO_ACC, PER_PRIV_RW_USR_NO_ACC,
 	                       PER_PRIV_RW_USR_NO_ACC, PER_PRIV_RW_USR_NO_ACC,
 	                       PER_PRIV_RW_USR_NO_ACC, PER_PRIV_RW_USR_NO_ACC,
-	                       PER_PRIV_RO_USR_NO_ACC, PER_NO_ACC)
+	                       PER_PRIV_RO_USR_NO_ACC, PER_PRIV_RW_USR_NO_ACC)
 	@ Instruction access permissions:
 	@ Region 0: User = --, Privileged = RO
 	@ Region 1: User = --, Privileged = RO
@@ -25,33 +25,64 @@
 
 
 
-bool fsEnsureMounted(const char *path)
+static s32 pathToDrive(const char *path)
 {
-	s32 res = 0;
-	
 	if(strncmp(path, "sdmc:", 5) == 0)
-	{
-		res = fMount(FS_DRIVE_SDMC);
-	}
+		return FS_DRIVE_SDMC;
 	else if(strncmp(path, "twln:", 5) == 0)
-	{
-		res = fMount(FS_DRIVE_TWLN);
-	}
+		return FS_DRIVE_TWLN;
 	else if(strncmp(path, "twlp:", 5) == 0)
-	{
-		res = fMount(FS_DRIVE_TWLP);
-	}
+		return FS_DRIVE_TWLP;
 	else if(strncmp(path, "nand:", 5) == 0)
+		return FS_DRIVE_NAND;
+	
+	return -1;
+}
+
+bool fsEnsureMounted(const char *path)
+{
+	const s32 drive = pathToDrive(path);
+	if(drive < 0) return false;
+	
+	const s32 res = fMount(drive);
+	
+	// succesfull mount or already mounted
+	return ((res == 0) || (res == -31));
+}
+
+// mounts the drives of up to FS_BATCH_MAX_OPS paths in one go,
+// returns a bitmask of the paths on mounted drives
+u32 fsEnsureMountedPaths(const char *const *paths, u32 num)
+{
+	FsBatchOp ops[FS_BATCH_MAX_OPS];
+	u32 idx[FS_BATCH_MAX_OPS];
+	u32 n_ops = 0;
+	u32 mounted = 0;
+	
+	if(num > FS_BATCH_MAX_OPS) num = FS_BATCH_MAX_OPS;
+	
+	memset(ops, 0, sizeof(ops));
+	for(u32 i = 0; i < num; i++)
 	{
-		res = fMount(FS_DRIVE_NAND);
+		const s32 drive = pathToDrive(paths[i]);
+		if(drive < 0) continue;
+		
+		ops[n_ops].type = FS_BATCH_MOUNT;
+		ops[n_ops].arg = drive;
+		idx[n_ops++] = i;
 	}
-	else
+	
+	if(!n_ops || (fBatch(ops, n_ops) < 0))
+		return 0;
+	
+	for(u32 i = 0; i < n_ops; i++)
 	{
-		return false;
+		// succesfull mount or already mounted
+		if((ops[i].result == 0) || (ops[i].result == -31))
+			mounted |= 1u<<idx[i];
 	}
 	
-	// succesfull mount or already mounted
-	return ((res == 0) || (res == -31));
+	return mounted;
 }
 
 void fsUnmountAll()
@@ -151,3 +182,69 @@ bool fsQuickRead(const char* filepath, void* buff, u32 len, u32 off)
 	fClose(fHandle);
 	return res;
 }
+
+bool fsQuickWrite(const char* filepath, const void* buff, u32 len)
+{
+	s32 fHandle = fOpen(filepath, FS_CREATE_ALWAYS | FS_OPEN_WRITE);
+	if (fHandle < 0) return false;
+	
+	bool res = (fWrite(fHandle, buff, len) == 0);
+	
+	fClose(fHandle);
+	if (!res) fUnlink(filepath);
+	return res;
+}
+
+// stats num paths with as few round trips as possible, fi may be NULL
+// returns the number of paths that failed or < 0 on error
+s32 fsStatPaths(const char *const *paths, FsFileInfo *fi, s32 *results, u32 num)
+{
+	FsBatchOp ops[FS_BATCH_MAX_OPS];
+	s32 failed = 0;
+	
+	for(u32 p = 0; p < num; p += FS_BATCH_MAX_OPS)
+	{
+		const u32 n_ops = (num - p > FS_BATCH_MAX_OPS) ? FS_BATCH_MAX_OPS : num - p;
+		
+		memset(ops, 0, sizeof(ops));
+		for(u32 i = 0; i < n_ops; i++)
+		{
+			ops[i].type = FS_BATCH_STAT;
+			ops[i].path = paths[p + i];
+			ops[i].pathSize = strlen(paths[p + i]) + 1;
+			ops[i].out = fi ? &fi[p + i] : NULL;
+			ops[i].outSize = fi ? sizeof(FsFileInfo) : 0;
+		}
+		
+		const s32 res = fBatch(ops, n_ops);
+		if(res < 0) return res;
+		failed += res;
+		
+		if(results)
+		{
+			for(u32 i = 0; i < n_ops; i++)
+				results[p + i] = ops[i].result;
+		}
+	}
+	
+	return failed;
+}
+
+// reads a whole file of up to maxLen bytes in a single round trip
+// returns the file size or < 0 on error
+s32 fsReadSmallFile(const char* filepath, void* buff, u32 maxLen)
+{
+	FsBatchOp op;
+	
+	memset(&op, 0, sizeof(FsBatchOp));
+	op.type = FS_BATCH_READ_FILE;
+	op.path = filepath;
+	op.pathSize = strlen(filepath) + 1;
+	op.out = buff;
+	op.outSize = maxLen;
+	
+	const s32 res = fBatch(&op, 1);
+	if(res < 0) return res;
+	
+	return op.result;
+}
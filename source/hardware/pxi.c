@@ -16,6 +16,7 @@
  *   along with this program.  If not, see <http://www.gnu.org/licenses/>.
  */
 
+#include <string.h>
 #include "types.h"
 #include "hardware/pxi.h"
 #ifdef ARM9
@@ -24,13 +25,33 @@
 #elif ARM11
 	#include "arm11/hardware/interrupt.h"
 	#include "arm11/debug.h"
+	#include "arm11/ipc_stats.h"
 #endif
 #include "ipc_handler.h"
 #include "fb_assert.h"
 #include "hardware/cache.h"
+#include "arm.h"
 
 
 
+#define pxiRing  ((PxiRing*)PXI_RING_BASE)
+
+// The last 16 bytes of the page are used by the ARM11 SMP code
+_Static_assert(sizeof(PxiRing) <= PXI_RING_SIZE - 0x10, "PXI ring too big");
+
+#ifdef ARM11
+#define MAX_IPC_BUFS  (IPC_MAX_PARAMS / 2)
+
+// Slots with a result not yet collected by PXI_pollCmd()
+static u32 ringPending = 0;
+// Original pointers of IPC buffers bounced through the slot data
+static void *ringBounced[PXI_RING_SLOTS][MAX_IPC_BUFS];
+// Submit timestamp and bytes moved for the IPC statistics
+static u32 ringStart[PXI_RING_SLOTS];
+static u32 ringBytes[PXI_RING_SLOTS];
+#endif
+
+
 static void pxiIrqHandler(UNUSED u32 id);
 
 void PXI_init(void)
@@ -39,6 +60,9 @@ void PXI_init(void)
 	REG_PXI_CNT = PXI_ENABLE_SEND_RECV_FIFO | PXI_EMPTY_FULL_ERROR | PXI_FLUSH_SEND_FIFO;
 
 #ifdef ARM9
+	pxiRing->head = 0;
+	pxiRing->tail = 0;
+
 	REG_PXI_DATA_SENT = 9;
 	while(REG_PXI_DATA_RECEIVED != 11);
 
@@ -48,11 +72,53 @@ void PXI_init(void)
 	REG_PXI_DATA_SENT = 11;
 
 	IRQ_registerHandler(IRQ_PXI_SYNC, 13, 0, true, pxiIrqHandler);
+	IPC_statsInit();
 #endif
 }
 
+#ifdef ARM9
+static void handleRingCmds(void)
+{
+	PxiRingSlot *slot;
+	while((slot = pxiRingPeek(pxiRing)) != NULL)
+	{
+		const u32 cmdCode = slot->cmd;
+		const u32 inBufs = IPC_CMD_IN_BUFS_MASK(cmdCode);
+		const u32 outBufs = IPC_CMD_OUT_BUFS_MASK(cmdCode);
+		const u32 params = IPC_CMD_PARAMS_MASK(cmdCode);
+		const u32 cmdBufSize = (inBufs * 2) + (outBufs * 2) + params;
+		if(cmdBufSize > IPC_MAX_PARAMS || cmdBufSize != slot->words)
+		{
+			panic();
+		}
+
+		u32 buf[IPC_MAX_PARAMS];
+		for(u32 i = 0; i < cmdBufSize; i++) buf[i] = slot->buf[i];
+
+		pxiRing->progressDone = 0;
+		pxiRing->progressTotal = 0;
+		pxiRing->progressTicket = pxiRing->tail;
+
+		slot->result = IPC_handleCmd(IPC_CMD_ID_MASK(cmdCode), inBufs, outBufs, buf);
+		pxiRingComplete(pxiRing);
+	}
+
+	// Wake up the ARM11
+	REG_PXI_SYNC = PXI_DATA_SENT(PXI_RING_DOORBELL) | PXI_TRIGGER_SYNC_IRQ;
+}
+#endif
+
 static void pxiIrqHandler(UNUSED u32 id)
 {
+	if(REG_PXI_DATA_RECEIVED == PXI_RING_DOORBELL)
+	{
+#ifdef ARM9
+		handleRingCmds();
+#endif
+		// ARM11: Nothing to do. PXI_waitCmd() polls the ring tail.
+		return;
+	}
+
 	const u32 cmdCode = REG_PXI_RECV;
 	const u32 inBufs = IPC_CMD_IN_BUFS_MASK(cmdCode);
 	const u32 outBufs = IPC_CMD_OUT_BUFS_MASK(cmdCode);
@@ -70,11 +136,8 @@ static void pxiIrqHandler(UNUSED u32 id)
 	REG_PXI_SEND = IPC_handleCmd(IPC_CMD_ID_MASK(cmdCode), inBufs, outBufs, buf);
 }
 
-u32 PXI_sendCmd(u32 cmd, const u32 *const buf, u32 words)
+static u32 sendCmdFifo(u32 cmd, const u32 *const buf, u32 words)
 {
-	fb_assert(words <= IPC_MAX_PARAMS);
-
-
 	const u32 inBufs = IPC_CMD_IN_BUFS_MASK(cmd);
 	const u32 outBufs = IPC_CMD_OUT_BUFS_MASK(cmd);
 	for(u32 i = 0; i < inBufs; i++)
@@ -110,3 +173,178 @@ u32 PXI_sendCmd(u32 cmd, const u32 *const buf, u32 words)
 
 	return res;
 }
+
+#ifdef ARM9
+u32 PXI_sendCmd(u32 cmd, const u32 *const buf, u32 words)
+{
+	fb_assert(words <= IPC_MAX_PARAMS);
+
+	return sendCmdFifo(cmd, buf, words);
+}
+
+void PXI_setProgress(u32 done, u32 total)
+{
+	pxiRing->progressDone = done;
+	pxiRing->progressTotal = total;
+}
+#elif ARM11
+u32 PXI_sendCmd(u32 cmd, const u32 *const buf, u32 words)
+{
+	fb_assert(words <= IPC_MAX_PARAMS);
+
+	// Panic and exception reports may happen with the ring in any state.
+	if(cmd == IPC_CMD9_PANIC || cmd == IPC_CMD9_EXCEPTION)
+		return sendCmdFifo(cmd, buf, words);
+
+	return PXI_waitCmd(PXI_submitCmd(cmd, buf, words));
+}
+
+// Sleeps until the ARM9 has processed the request with this ticket
+static void waitRingTail(u32 ticket)
+{
+	// Check and sleep with IRQs off. Otherwise the doorbell could
+	// arrive right before the WFI and we would miss it.
+	const u32 oldState = enterCriticalSection();
+	while(!pxiRingDone(pxiRing, ticket))
+	{
+		__wfi();
+		leaveCriticalSection(oldState);
+		enterCriticalSection();
+	}
+	leaveCriticalSection(oldState);
+}
+
+u32 PXI_submitCmd(u32 cmd, const u32 *const buf, u32 words)
+{
+	fb_assert(words <= IPC_MAX_PARAMS);
+
+
+	const u32 ticket = pxiRing->head;
+	const u32 slotNum = ticket % PXI_RING_SLOTS;
+
+	// The oldest request must be done and its result collected before reusing the slot
+	if(pxiRingFull(pxiRing)) waitRingTail(ticket - PXI_RING_SLOTS);
+	fb_assert(!(ringPending & 1u<<slotNum));
+
+	PxiRingSlot *const slot = pxiRingSlot(pxiRing, ticket);
+	slot->cmd = cmd;
+	slot->words = words;
+	for(u32 i = 0; i < words; i++) slot->buf[i] = buf[i];
+	ringPending |= 1u<<slotNum;
+
+	// Small buffers are copied into the uncached slot data. Only buffers
+	// not fitting there need cache maintenance.
+	const u32 inBufs = IPC_CMD_IN_BUFS_MASK(cmd);
+	const u32 outBufs = IPC_CMD_OUT_BUFS_MASK(cmd);
+	void **const bounced = ringBounced[slotNum];
+	u32 dataUsed = 0;
+	u32 bytes = 0;
+	for(u32 i = 0; i < inBufs + outBufs; i++)
+	{
+		IpcBuffer *const ipcBuf = (IpcBuffer*)&slot->buf[i * sizeof(IpcBuffer) / 4];
+		void *const ptr = ipcBuf->ptr;
+		bounced[i] = NULL;
+		if(!ptr || !ipcBuf->size) continue;
+		bytes += ipcBuf->size;
+
+		// An out buffer may also be an in buffer. Share the copy.
+		u32 j = inBufs;
+		if(i >= inBufs)
+		{
+			for(j = 0; j < inBufs; j++)
+			{
+				const IpcBuffer *const inBuf = (IpcBuffer*)&buf[j * sizeof(IpcBuffer) / 4];
+				if(bounced[j] == ptr && inBuf->size == ipcBuf->size) break;
+			}
+		}
+		if(j < inBufs)
+		{
+			ipcBuf->ptr = ((IpcBuffer*)&slot->buf[j * sizeof(IpcBuffer) / 4])->ptr;
+			bounced[i] = ptr;
+			continue;
+		}
+
+		const u32 alignedSize = (ipcBuf->size + 3) & ~3u;
+		if(dataUsed + alignedSize <= PXI_RING_SLOT_DATA)
+		{
+			u8 *const bounceBuf = (u8*)slot->data + dataUsed;
+			if(i < inBufs) memcpy(bounceBuf, ptr, ipcBuf->size);
+			ipcBuf->ptr = bounceBuf;
+			bounced[i] = ptr;
+			dataUsed += alignedSize;
+		}
+		else if(i < inBufs) flushDCacheRange(ptr, ipcBuf->size);
+		else invalidateDCacheRange(ptr, ipcBuf->size);
+	}
+
+	// Device buffer transfers move their data on the ARM9 side only
+	if(cmd == IPC_CMD9_FREAD_TO_DEV_BUF || cmd == IPC_CMD9_FWRITE_FROM_DEV_BUF) bytes += buf[2];
+	ringBytes[slotNum] = bytes;
+	ringStart[slotNum] = IPC_statsTimestamp();
+
+	// The slot must be visible before the new head and the head before the doorbell.
+	pxiRingPublish(pxiRing, ticket);
+	__dsb();
+	REG_PXI_SYNC = PXI_DATA_SENT(PXI_RING_DOORBELL) | PXI_TRIGGER_SYNC_IRQ;
+
+	return ticket;
+}
+
+bool PXI_pollCmd(u32 ticket, u32 *const result)
+{
+	const u32 slotNum = ticket % PXI_RING_SLOTS;
+
+	fb_assert(ringPending & 1u<<slotNum);
+
+	if(!pxiRingDone(pxiRing, ticket)) return false;
+
+	const PxiRingSlot *const slot = pxiRingSlot(pxiRing, ticket);
+	const u32 inBufs = IPC_CMD_IN_BUFS_MASK(slot->cmd);
+	const u32 outBufs = IPC_CMD_OUT_BUFS_MASK(slot->cmd);
+
+	void *const *const bounced = ringBounced[slotNum];
+	for(u32 i = inBufs; i < inBufs + outBufs; i++)
+	{
+		const IpcBuffer *const outBuf = (const IpcBuffer*)&slot->buf[i * sizeof(IpcBuffer) / 4];
+		if(!outBuf->ptr || !outBuf->size) continue;
+
+		// The CPU may do speculative prefetches of data after the first invalidation
+		// so we need to do it again.
+		if(bounced[i]) memcpy(bounced[i], outBuf->ptr, outBuf->size);
+		else invalidateDCacheRange(outBuf->ptr, outBuf->size);
+	}
+
+	*result = slot->result;
+	ringPending &= ~(1u<<slotNum);
+	IPC_statsRecord(slot->cmd, ringBytes[slotNum], ringStart[slotNum]);
+
+	return true;
+}
+
+u32 PXI_waitCmd(u32 ticket)
+{
+	fb_assert(ringPending & 1u<<(ticket % PXI_RING_SLOTS));
+
+	waitRingTail(ticket);
+
+	u32 res;
+	PXI_pollCmd(ticket, &res);
+
+	return res;
+}
+
+void PXI_getProgress(u32 ticket, u32 *const done, u32 *const total)
+{
+	u32 d = 0, t = 0;
+	if(pxiRing->progressTicket == ticket)
+	{
+		// The ARM9 may update both while we read them
+		t = pxiRing->progressTotal;
+		d = pxiRing->progressDone;
+		if(d > t) d = t;
+	}
+
+	*done = d;
+	*total = t;
+}
+#endif
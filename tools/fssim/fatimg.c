@@ -0,0 +1,138 @@
+/*
+ *   This file is part of fastboot 3DS
+ *   Copyright (C) 2017 derrek, profi200
+ *
+ *   This program is free software: you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License as published by
+ *   the Free Software Foundation, either version 3 of the License, or
+ *   (at your option) any later version.
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/*
+ * Minimal FAT32 formatter for the simulator images. The firm builds
+ * FatFs without f_mkfs() so the images are prepared here. Writes an MBR
+ * with one partition, the boot sector, FSInfo, their backups, empty FATs
+ * and an empty root directory.
+ */
+
+#include <string.h>
+#include "types.h"
+#include "fssim.h"
+
+
+#define FAT_RESERVED_SECTORS  (32u)
+#define FAT_NUM_FATS          (2u)
+#define FAT_ROOT_CLUSTER      (2u)
+#define FAT_ZERO_SECTORS      (64u)
+
+
+static void put16(u8 *p, u16 val)
+{
+	p[0] = val;
+	p[1] = val>>8;
+}
+
+static void put32(u8 *p, u32 val)
+{
+	put16(p, val);
+	put16(p + 2, val>>16);
+}
+
+static bool writeZeros(SimWriteFunc write, u32 sector, u32 count)
+{
+	static const u8 zeros[FAT_ZERO_SECTORS * 512];
+
+	while(count)
+	{
+		const u32 n = (count > FAT_ZERO_SECTORS ? FAT_ZERO_SECTORS : count);
+		if(!write(sector, n, zeros)) return false;
+		sector += n;
+		count -= n;
+	}
+
+	return true;
+}
+
+bool simFormatFat32(SimWriteFunc write, u32 sectors, u32 partStart, u32 clusterSectors, const char *label)
+{
+	const u32 volSectors = sectors - partStart;
+
+	// FAT size from the Microsoft FAT specification
+	const u32 tmp1 = volSectors - FAT_RESERVED_SECTORS;
+	const u32 tmp2 = (256 * clusterSectors + FAT_NUM_FATS) / 2;
+	const u32 fatSectors = (tmp1 + tmp2 - 1) / tmp2;
+	const u32 dataStart = FAT_RESERVED_SECTORS + FAT_NUM_FATS * fatSectors;
+	const u32 clusters = (volSectors - dataStart) / clusterSectors;
+
+	// FatFs decides the FAT type by the cluster count alone
+	if(clusters < 65525) return false;
+
+	u8 sec[512];
+
+	// MBR with a single FAT32 (LBA) partition
+	memset(sec, 0, sizeof(sec));
+	u8 *const part = &sec[0x1BE];
+	part[4] = 0x0C;
+	put32(&part[8], partStart);
+	put32(&part[12], volSectors);
+	put16(&sec[510], 0xAA55);
+	if(!write(0, 1, sec)) return false;
+	if(!writeZeros(write, 1, partStart - 1)) return false;
+
+	// Boot sector
+	memset(sec, 0, sizeof(sec));
+	memcpy(sec, "\xEB\x58\x90" "MSWIN4.1", 11);
+	put16(&sec[11], 512);
+	sec[13] = clusterSectors;
+	put16(&sec[14], FAT_RESERVED_SECTORS);
+	sec[16] = FAT_NUM_FATS;
+	sec[21] = 0xF8;                         // Fixed disk
+	put16(&sec[24], 63);
+	put16(&sec[26], 255);
+	put32(&sec[28], partStart);
+	put32(&sec[32], volSectors);
+	put32(&sec[36], fatSectors);
+	put32(&sec[44], FAT_ROOT_CLUSTER);
+	put16(&sec[48], 1);                     // FSInfo sector
+	put16(&sec[50], 6);                     // Backup boot sector
+	sec[64] = 0x80;
+	sec[66] = 0x29;
+	put32(&sec[67], 0x3D5F51A7);
+	memset(&sec[71], ' ', 11);
+	memcpy(&sec[71], label, strnlen(label, 11));
+	memcpy(&sec[82], "FAT32   ", 8);
+	put16(&sec[510], 0xAA55);
+
+	u8 fsInfo[512];
+	memset(fsInfo, 0, sizeof(fsInfo));
+	put32(&fsInfo[0], 0x41615252);
+	put32(&fsInfo[484], 0x61417272);
+	put32(&fsInfo[488], clusters - 1);      // Free clusters minus the root directory
+	put32(&fsInfo[492], FAT_ROOT_CLUSTER + 1);
+	put16(&fsInfo[510], 0xAA55);
+
+	// Zero the reserved area, FATs and root directory first
+	if(!writeZeros(write, partStart, dataStart + clusterSectors)) return false;
+	if(!write(partStart, 1, sec) || !write(partStart + 6, 1, sec)) return false;
+	if(!write(partStart + 1, 1, fsInfo) || !write(partStart + 7, 1, fsInfo)) return false;
+
+	// Media descriptor, reserved entry and end of chain for the root directory
+	memset(sec, 0, sizeof(sec));
+	put32(&sec[0], 0x0FFFFFF8);
+	put32(&sec[4], 0x0FFFFFFF);
+	put32(&sec[8], 0x0FFFFFFF);
+	for(u32 i = 0; i < FAT_NUM_FATS; i++)
+	{
+		if(!write(partStart + FAT_RESERVED_SECTORS + i * fatSectors, 1, sec)) return false;
+	}
+
+	return true;
+}
@@ -0,0 +1,267 @@
+/*
+ *   This file is part of fastboot 3DS
+ *   Copyright (C) 2017 derrek, profi200
+ *
+ *   This program is free software: you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License as published by
+ *   the Free Software Foundation, either version 3 of the License, or
+ *   (at your option) any later version.
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/*
+ * ARM11 side of the simulator. Runs the boot, browse, backup and restore
+ * flows through the real ARM11 fs, config and menu code and prints what
+ * each of them cost in host time, IPC round trips and device traffic.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "types.h"
+#include "mem_map.h"
+#include "util.h"
+#include "fs.h"
+#include "fsutils.h"
+#include "hardware/pxi.h"
+#include "arm.h"
+#include "arm11/config.h"
+
+struct _reent; // Only newlib has it
+#include "arm11/console.h"
+#include "arm11/firm.h"
+#include "arm11/ipc_stats.h"
+#include "arm11/hardware/hid.h"
+#include "arm11/hardware/mcu.h"
+#include "arm11/menu/menu.h"
+#include "arm11/menu/menu_fsel.h"
+#include "arm11/menu/menu_func.h"
+#include "fssim.h"
+
+
+#define BOOT_FIRM_PATH      "sdmc:/boot.firm"
+#define BOOT_FIRM_SIZE      (0x200000u)
+#define BROWSE_PATH         "sdmc:/browse"
+#define BROWSE_DIRS         (8u)
+#define BROWSE_FILES        (200u)
+#define BROWSE_FILE_SIZE    (0x400u)
+#define SIM_SERIAL          "SIM0123456789"
+#define NAND_MARKER_PATH    "nand:/sim_marker.bin"
+
+
+typedef struct
+{
+	const char *name;
+	bool (*run)(void);
+} SimFlow;
+
+
+static const char *const browseDirs[BROWSE_DIRS] =
+{
+	"Bilder", "Müsli Rezepte", "Документы", "Φωτογραφίες",
+	"Musik 2017", "Заметки", "Ελληνικά", "Sicherungen"
+};
+
+static const char configText[] = "BOOT_OPTION1 = " BOOT_FIRM_PATH "\r\n"
+                                 "BOOT_MODE = Normal\r\n";
+
+static PrintConsole termCon = {.consoleWidth = 66, .consoleHeight = 24, .windowWidth = 66, .windowHeight = 24};
+static PrintConsole menuCon = {.consoleWidth = 53, .consoleHeight = 24, .windowWidth = 53, .windowHeight = 24};
+static u8 backupHash[32];
+
+
+
+static bool writeBootFirm(void)
+{
+	u8 *const firm = malloc(BOOT_FIRM_SIZE);
+	if(!firm) return false;
+
+	simBuildFirm(firm, BOOT_FIRM_SIZE);
+	const bool ok = fsQuickWrite(BOOT_FIRM_PATH, firm, BOOT_FIRM_SIZE);
+	free(firm);
+
+	return ok;
+}
+
+static bool writeBrowseTree(void)
+{
+	u8 data[BROWSE_FILE_SIZE];
+	char path[256];
+
+	memset(data, 0x5A, sizeof(data));
+	if(fMkdir(BROWSE_PATH) != 0) return false;
+	for(u32 d = 0; d < BROWSE_DIRS; d++)
+	{
+		snprintf(path, sizeof(path), BROWSE_PATH "/%s", browseDirs[d]);
+		if(fMkdir(path) != 0) return false;
+
+		for(u32 f = 0; f < BROWSE_FILES; f++)
+		{
+			snprintf(path, sizeof(path), BROWSE_PATH "/%s/%s %03lu.txt", browseDirs[d], browseDirs[d], (unsigned long)f);
+			if(!fsQuickWrite(path, data, sizeof(data))) return false;
+		}
+	}
+
+	return true;
+}
+
+static bool flowSetup(void)
+{
+	char secureInfo[0x111];
+
+	memset(secureInfo, 0, sizeof(secureInfo));
+	memcpy(&secureInfo[0x102], SIM_SERIAL, sizeof(SIM_SERIAL) - 1);
+
+	bool ok = fsMountSdmc() && (fsMountNandFilesystems() & 1u<<2) &&
+	          fsCreateFileWithPath("sdmc:/3ds/fastbootcfg.txt") &&
+	          fsQuickWrite("sdmc:/3ds/fastbootcfg.txt", configText, sizeof(configText) - 1) &&
+	          writeBootFirm() &&
+	          fsCreateFileWithPath("nand:/rw/sys/SecureInfo_A") &&
+	          fsQuickWrite("nand:/rw/sys/SecureInfo_A", secureInfo, sizeof(secureInfo)) &&
+	          writeBrowseTree();
+	fsUnmountAll();
+
+	return ok;
+}
+
+static bool flowBoot(void)
+{
+	if(!fsMountSdmc() || !fsMountNandFilesystems() || !loadConfigFile()) return false;
+
+	const char *const path = configGetData(KBootOption1);
+	if(!path || strcmp(path, BOOT_FIRM_PATH) != 0) return false;
+
+	return loadVerifyFirm(path, false) >= 0;
+}
+
+static bool flowBrowse(void)
+{
+	// Enter and leave every directory, then pick the first file of the last one.
+	// Every D-pad press is followed by a release for the cooldown scan.
+	static u32 keys[BROWSE_DIRS * 4 + 3];
+	u32 n = 0;
+	for(u32 i = 0; i < BROWSE_DIRS - 1; i++)
+	{
+		keys[n++] = KEY_A;
+		keys[n++] = KEY_B;
+		keys[n++] = KEY_DDOWN;
+		keys[n++] = 0;
+	}
+	keys[n++] = KEY_A;
+	keys[n++] = 0;
+	keys[n++] = KEY_A;
+	simHidScript(keys, n);
+
+	char path[FF_MAX_LFN + 1];
+	if(!menuFileSelector(path, &menuCon, BROWSE_PATH, "*", false)) return false;
+	simHidScript(NULL, 0);
+
+	return strncmp(path, BROWSE_PATH "/", sizeof(BROWSE_PATH)) == 0 && fStat(path, NULL) == 0;
+}
+
+static bool hashFromSidecar(const char *const path, u8 hash[32])
+{
+	char hex[64];
+	if(!fsQuickRead(path, hex, sizeof(hex), 0)) return false;
+
+	for(u32 i = 0; i < 32; i++)
+	{
+		unsigned int val;
+		if(sscanf(&hex[i * 2], "%2x", &val) != 1) return false;
+		hash[i] = val;
+	}
+
+	return true;
+}
+
+static bool flowBackup(void)
+{
+	simHidScript(NULL, 0);
+	if(menuBackupNand(&termCon, &menuCon, 0) != MENU_OK) return false;
+
+	// Same name menuBackupNand() builds from the RTC and serial
+	u8 rtc[8];
+	char path[128];
+	MCU_readRTC(rtc);
+	snprintf(path, sizeof(path), NAND_BACKUP_PATH "/%02X%02X%02X%02X%02X%02X_%s_nand.bin.sha",
+	         rtc[6], rtc[5], rtc[4], rtc[2], rtc[1], rtc[0], SIM_SERIAL);
+
+	u8 imageHash[32];
+	return hashFromSidecar(path, backupHash) && simHashNandImage(imageHash) &&
+	       memcmp(backupHash, imageHash, 32) == 0;
+}
+
+static bool flowRestore(void)
+{
+	// Something for the restore to undo
+	if(!fsQuickWrite(NAND_MARKER_PATH, backupHash, sizeof(backupHash))) return false;
+
+	// Pick the backup in the file selector, then confirm with A + LEFT
+	static const u32 keys[2] = {KEY_A, KEY_A | KEY_DLEFT};
+	simHidScript(keys, 2);
+	if(menuRestoreNand(&termCon, &menuCon, 0) != MENU_OK) return false;
+
+	u8 imageHash[32];
+	return fStat(NAND_MARKER_PATH, NULL) != 0 && simHashNandImage(imageHash) &&
+	       memcmp(backupHash, imageHash, 32) == 0;
+}
+
+static void printFlowStats(const char *name, bool ok, u64 ns)
+{
+	u32 calls = 0;
+	u64 ipcUs = 0;
+	for(u32 i = 0; i < IPC_STATS_MAX_CMDS; i++)
+	{
+		const IpcCmdStats *const stats = IPC_statsGet(i);
+		calls += stats->calls;
+		ipcUs += stats->totalUs;
+	}
+
+	const SimStats *const s = &g_simStats;
+	printf("%-8s %-4s %9.1f %7lu %9.1f %8llu %8llu %8llu %8llu %9llu %8.1f\n", name, ok ? "ok" : "FAIL",
+	       ns / 1e6, (unsigned long)calls, ipcUs / 1e3,
+	       (unsigned long long)s->sd.readSectors, (unsigned long long)s->sd.writeSectors,
+	       (unsigned long long)s->nand.readSectors, (unsigned long long)s->nand.writeSectors,
+	       (unsigned long long)s->aesBlocks, s->shaBytes / 1048576.0);
+}
+
+void* simArm11Main(UNUSED void *arg)
+{
+	static const SimFlow flows[] =
+	{
+		{"setup", flowSetup},
+		{"boot", flowBoot},
+		{"browse", flowBrowse},
+		{"backup", flowBackup},
+		{"restore", flowRestore}
+	};
+
+	PXI_init();
+	// The wire thread copies the sync registers with a delay. Don't let the
+	// first doorbell replace the handshake value before the ARM9 saw it.
+	while(!simArm9Ready()) __wfi();
+
+	printf("%-8s %-4s %9s %7s %9s %8s %8s %8s %8s %9s %8s\n", "flow", "res", "host ms", "ipc",
+	       "ipc ms", "sd rd", "sd wr", "nand rd", "nand wr", "aes blks", "sha MiB");
+
+	bool ok = true;
+	for(u32 i = 0; i < arrayEntries(flows) && ok; i++)
+	{
+		memset(&g_simStats, 0, sizeof(g_simStats));
+		IPC_statsReset();
+
+		const u64 start = simGetNs();
+		ok = flows[i].run();
+		printFlowStats(flows[i].name, ok, simGetNs() - start);
+	}
+	fsUnmountAll();
+
+	return ok ? NULL : (void*)1;
+}
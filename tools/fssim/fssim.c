@@ -0,0 +1,217 @@
+/*
+ *   This file is part of fastboot 3DS
+ *   Copyright (C) 2017 derrek, profi200
+ *
+ *   This program is free software: you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License as published by
+ *   the Free Software Foundation, either version 3 of the License, or
+ *   (at your option) any later version.
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/*
+ * Host simulator of the fs and IPC stack. The ARM9 fs.c, FatFs, dev.c and
+ * partitions.c and the ARM11 fs/config/menu code are compiled unmodified
+ * and run on two pthreads talking over the real PXI ring. A third thread
+ * is the wire between the two PXI register sets. SD and NAND are image
+ * files, AES and SHA are done in software.
+ *
+ * The firm passes pointers as 32 bit words so every buffer shared by the
+ * two CPUs has to be below 4 GiB. The binary is linked at 1 GiB, malloc()
+ * is limited to the brk heap and the ARM11 stack is mapped with MAP_32BIT.
+ * The IO, VRAM, AXIWRAM and ITCM regions the code accesses directly are
+ * mapped at their real addresses.
+ */
+
+#include <errno.h>
+#include <malloc.h>
+#include <pthread.h>
+#include <sched.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/mman.h>
+#include <time.h>
+#include <unistd.h>
+#include "types.h"
+#include "mem_map.h"
+#include "hardware/cache.h"
+#include "fssim.h"
+
+
+#define PXI9_SYNC               ((vu32*)(IO_MEM_ARM9_ONLY + 0x8000))
+#define PXI11_SYNC              ((vu32*)(IO_MEM_ARM9_ARM11 + 0x63000))
+#define PXI_SYNC_IRQ_ENABLE     (1u<<31)
+#define PXI11_TRIGGER_SYNC_IRQ  (1u<<30) // ARM11 -> ARM9
+#define PXI9_TRIGGER_SYNC_IRQ   (1u<<29) // ARM9 -> ARM11
+
+
+SimStats g_simStats;
+bool g_simVerbose = false;
+volatile bool g_simStop = false;
+
+static volatile bool arm9IrqPending = false;
+
+
+
+static bool mapRegion(uintptr_t addr, size_t size)
+{
+	void *const p = mmap((void*)addr, size, PROT_READ | PROT_WRITE,
+	                     MAP_PRIVATE | MAP_ANONYMOUS | MAP_FIXED_NOREPLACE, -1, 0);
+	if(p == MAP_FAILED || p != (void*)addr)
+	{
+		fprintf(stderr, "Can't map 0x%08lX: %s\n", (unsigned long)addr, strerror(errno));
+		return false;
+	}
+
+	return true;
+}
+
+u64 simGetNs(void)
+{
+	struct timespec ts;
+	clock_gettime(CLOCK_MONOTONIC, &ts);
+
+	return (u64)ts.tv_sec * 1000000000u + ts.tv_nsec;
+}
+
+bool simTakeArm9Irq(void)
+{
+	return __atomic_exchange_n(&arm9IrqPending, false, __ATOMIC_ACQ_REL);
+}
+
+// The caches are not simulated
+void flushDCacheRange(UNUSED const void *const base, UNUSED u32 size)
+{
+	__atomic_thread_fence(__ATOMIC_SEQ_CST);
+}
+
+void flushInvalidateDCacheRange(UNUSED const void *const base, UNUSED u32 size)
+{
+	__atomic_thread_fence(__ATOMIC_SEQ_CST);
+}
+
+void invalidateDCacheRange(UNUSED const void *const base, UNUSED u32 size)
+{
+	__atomic_thread_fence(__ATOMIC_SEQ_CST);
+}
+
+// Copies the sent byte of each side to the received byte of the other
+// and turns sync IRQ triggers into a pending ARM9 IRQ.
+static void* pxiWire(UNUSED void *arg)
+{
+	vu8 *const sync9 = (vu8*)PXI9_SYNC;
+	vu8 *const sync11 = (vu8*)PXI11_SYNC;
+
+	while(!g_simStop)
+	{
+		if(sync9[0] != sync11[1]) sync9[0] = sync11[1];
+		if(sync11[0] != sync9[1]) sync11[0] = sync9[1];
+
+		if(*PXI11_SYNC & PXI11_TRIGGER_SYNC_IRQ)
+		{
+			__atomic_fetch_and(PXI11_SYNC, ~PXI11_TRIGGER_SYNC_IRQ, __ATOMIC_ACQ_REL);
+			if(*PXI9_SYNC & PXI_SYNC_IRQ_ENABLE)
+				__atomic_store_n(&arm9IrqPending, true, __ATOMIC_RELEASE);
+		}
+
+		// The ARM11 polls the ring. Just acknowledge the doorbell.
+		if(*PXI9_SYNC & PXI9_TRIGGER_SYNC_IRQ)
+			__atomic_fetch_and(PXI9_SYNC, ~PXI9_TRIGGER_SYNC_IRQ, __ATOMIC_ACQ_REL);
+
+		sched_yield();
+	}
+
+	return NULL;
+}
+
+static void usage(const char *name)
+{
+	fprintf(stderr, "Usage: %s [-v] [-k] [-d dir]\n"
+	                "  -v      Print the console output of the ARM11\n"
+	                "  -k      Keep the SD and NAND images\n"
+	                "  -d dir  Directory for the images (default: .)\n", name);
+}
+
+int main(int argc, char *argv[])
+{
+	const char *dir = ".";
+	bool keep = false;
+
+	int opt;
+	while((opt = getopt(argc, argv, "vkd:")) != -1)
+	{
+		switch(opt)
+		{
+			case 'v':
+				g_simVerbose = true;
+				break;
+			case 'k':
+				keep = true;
+				break;
+			case 'd':
+				dir = optarg;
+				break;
+			default:
+				usage(argv[0]);
+				return 1;
+		}
+	}
+
+	// Keep all allocations on the brk heap below 4 GiB
+	mallopt(M_MMAP_MAX, 0);
+	mallopt(M_ARENA_MAX, 1);
+
+	if(!mapRegion(IO_MEM_BASE, 0x400000) || !mapRegion(VRAM_BASE, VRAM_SIZE) ||
+	   !mapRegion(AXIWRAM_BASE, AXIWRAM_SIZE) || !mapRegion(ITCM_KERNEL_MIRROR, ITCM_SIZE))
+		return 1;
+
+	if(!simCryptoSelfTest())
+	{
+		fprintf(stderr, "Crypto self test failed\n");
+		return 1;
+	}
+
+	if(!simImagesCreate(dir))
+	{
+		fprintf(stderr, "Can't create the SD and NAND images in %s\n", dir);
+		simImagesDelete();
+		return 1;
+	}
+
+	void *const stack11 = mmap(NULL, SIM_ARM11_STACK, PROT_READ | PROT_WRITE,
+	                           MAP_PRIVATE | MAP_ANONYMOUS | MAP_32BIT, -1, 0);
+	if(stack11 == MAP_FAILED)
+	{
+		fprintf(stderr, "Can't map the ARM11 stack\n");
+		simImagesDelete();
+		return 1;
+	}
+
+	pthread_attr_t attr11;
+	pthread_attr_init(&attr11);
+	pthread_attr_setstack(&attr11, stack11, SIM_ARM11_STACK);
+
+	pthread_t wire, arm9, arm11;
+	pthread_create(&wire, NULL, pxiWire, NULL);
+	pthread_create(&arm9, NULL, simArm9Main, NULL);
+	pthread_create(&arm11, &attr11, simArm11Main, NULL);
+
+	void *res;
+	pthread_join(arm11, &res);
+	g_simStop = true;
+	pthread_join(arm9, NULL);
+	pthread_join(wire, NULL);
+	pthread_attr_destroy(&attr11);
+
+	if(!keep) simImagesDelete();
+
+	return res == NULL ? 0 : 1;
+}
@@ -0,0 +1,91 @@
+#pragma once
+
+/*
+ *   This file is part of fastboot 3DS
+ *   Copyright (C) 2017 derrek, profi200
+ *
+ *   This program is free software: you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License as published by
+ *   the Free Software Foundation, either version 3 of the License, or
+ *   (at your option) any later version.
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+// Shared between the host, ARM9 and ARM11 parts of the simulator. Only
+// plain types here because the three parts are built with different
+// CPU defines.
+
+#include "types.h"
+
+
+#define SIM_SD_SECTORS     (0x100000u) // 512 MiB
+#define SIM_NAND_SECTORS   (0x28400u)  // 80.5 MiB
+#define SIM_ARM11_STACK    (0x100000u)
+
+
+typedef struct
+{
+	u64 readCmds;
+	u64 readSectors;
+	u64 writeCmds;
+	u64 writeSectors;
+} SimDiskStats;
+
+typedef struct
+{
+	SimDiskStats sd;
+	SimDiskStats nand;
+	u64 aesBlocks;
+	u64 shaBytes;
+} SimStats;
+
+extern SimStats g_simStats;
+extern bool g_simVerbose;
+extern volatile bool g_simStop;
+
+
+
+// Host (fssim.c)
+u64 simGetNs(void);
+// Takes a pending ARM9 PXI sync IRQ. Returns true if there was one.
+bool simTakeArm9Irq(void);
+
+// Host (fatimg.c)
+typedef bool (*SimWriteFunc)(u32 sector, u32 count, const void *buf);
+bool simFormatFat32(SimWriteFunc write, u32 sectors, u32 partStart, u32 clusterSectors, const char *label);
+
+// ARM9 (softcrypto.c)
+typedef struct
+{
+	u32 state[8];
+	u64 bytes;
+	u8 buf[64];
+	u32 bufLen;
+} SimSha256;
+
+void simSha256Start(SimSha256 *ctx);
+void simSha256Update(SimSha256 *ctx, const void *data, u32 size);
+void simSha256Finish(SimSha256 *ctx, u8 hash[32]);
+bool simCryptoSelfTest(void);
+
+// ARM9 (hw9.c)
+bool simImagesCreate(const char *dir);
+void simImagesDelete(void);
+bool simHashNandImage(u8 hash[32]);
+// Fills buf with a FIRM with one FCRAM section of pseudo random data
+void simBuildFirm(u8 *buf, u32 size);
+void* simArm9Main(void *arg);
+// True once the ARM9 finished the PXI handshake
+bool simArm9Ready(void);
+
+// ARM11 (flows.c, hw11.c)
+void* simArm11Main(void *arg);
+// HID input for the next hidScanInput() calls. 0 entries release all keys.
+void simHidScript(const u32 *keys, u32 num);
@@ -0,0 +1,270 @@
+/*
+ *   This file is part of fastboot 3DS
+ *   Copyright (C) 2017 derrek, profi200
+ *
+ *   This program is free software: you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License as published by
+ *   the Free Software Foundation, either version 3 of the License, or
+ *   (at your option) any later version.
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/*
+ * ARM11 side stand-ins. Graphics and the console are dropped (console
+ * output goes to stdout with -v), the clock is the host monotonic clock
+ * and the buttons come from a script set by the flows. An empty script
+ * answers every wait for a VBlank with a B press so "Press B to return"
+ * prompts don't hang the run.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "types.h"
+#include "mem_map.h"
+#include "hardware/gfx.h"
+
+struct _reent; // Only newlib has it
+#include "arm11/console.h"
+#include "arm11/debug.h"
+#include "arm11/perf.h"
+#include "arm11/smp.h"
+#include "arm11/hardware/hid.h"
+#include "arm11/hardware/interrupt.h"
+#include "arm11/hardware/mcu.h"
+#include "arm11/hardware/timer.h"
+#include "arm11/menu/battery.h"
+#include "arm11/menu/bootslot.h"
+#include "fb_assert.h"
+#include "fssim.h"
+
+
+#define HID_SCRIPT_MAX  (4096u)
+
+
+static struct
+{
+	u32 keys[HID_SCRIPT_MAX];
+	u32 num;
+	u32 pos;
+	u32 held;
+	u32 down;
+	u32 up;
+	bool waited; // Last UI call waited for a VBlank
+} hid;
+
+static PrintConsole *currentConsole;
+static u64 timerStartNs;
+static u32 timerStartTicks;
+static u8 timerPrescaler = 1;
+
+
+
+void simHidScript(const u32 *keys, u32 num)
+{
+	if(num > HID_SCRIPT_MAX) num = HID_SCRIPT_MAX;
+
+	if(num) memcpy(hid.keys, keys, num * sizeof(u32));
+	hid.num = num;
+	hid.pos = 0;
+}
+
+void hidScanInput(void)
+{
+	const u32 prev = hid.held;
+
+	if(hid.pos < hid.num) hid.held = hid.keys[hid.pos++];
+	else if(hid.waited) hid.held = (prev & KEY_B ? 0 : KEY_B);
+	else hid.held = 0;
+	hid.waited = false;
+
+	hid.down = hid.held & ~prev;
+	hid.up = ~hid.held & prev;
+}
+
+u32 hidKeysHeld(void)
+{
+	return hid.held;
+}
+
+u32 hidKeysDown(void)
+{
+	return hid.down;
+}
+
+u32 hidKeysUp(void)
+{
+	return hid.up;
+}
+
+u32 hidGetPowerButton(UNUSED bool resetState)
+{
+	return 0;
+}
+
+void GFX_waitForEvent(UNUSED GfxEvent event, UNUSED bool discard)
+{
+	hid.waited = true;
+}
+
+void GFX_swapFramebufs(void)
+{
+}
+
+void GFX_markDirty(UNUSED u8 screen, UNUSED u32 x, UNUSED u32 width)
+{
+}
+
+void GFX_queuePresent(void)
+{
+	hid.waited = false;
+}
+
+void GFX_enterLowPowerState(void)
+{
+}
+
+void GFX_returnFromLowPowerState(void)
+{
+}
+
+void GX_memoryFill(u64 *buf0a, UNUSED u32 buf0v, u32 buf0Sz, u32 val0, UNUSED u64 *buf1a,
+                   UNUSED u32 buf1v, UNUSED u32 buf1Sz, UNUSED u32 val1)
+{
+	if(buf0a) memset(buf0a, (u8)val0, buf0Sz);
+}
+
+void GX_textureCopy(UNUSED u64 *in, UNUSED u32 indim, UNUSED u64 *out, UNUSED u32 outdim, UNUSED u32 size)
+{
+}
+
+ssize_t con_write(UNUSED struct _reent *r, UNUSED void *fd, const char *ptr, size_t len)
+{
+	if(g_simVerbose) fwrite(ptr, 1, len, stdout);
+
+	return len;
+}
+
+PrintConsole *consoleSelect(PrintConsole* console)
+{
+	PrintConsole *const prev = currentConsole;
+	currentConsole = console;
+
+	return prev;
+}
+
+PrintConsole *consoleGet(void)
+{
+	return currentConsole;
+}
+
+void consoleClear(void)
+{
+}
+
+void consoleSetCursor(PrintConsole* console, int x, int y)
+{
+	if(!console) console = currentConsole;
+	if(!console) return;
+
+	console->cursorX = x;
+	console->cursorY = y;
+}
+
+u16 consoleGetRGB565Color(u8 colorIndex)
+{
+	return colorIndex * 0x1111u;
+}
+
+void IRQ_registerHandler(UNUSED Interrupt id, UNUSED u8 prio, UNUSED u8 cpuMask,
+                         UNUSED bool edgeTriggered, UNUSED IrqHandler handler)
+{
+	// Replies are polled. The PXI code waits with __wfi().
+}
+
+void MCU_readRTC(void *rtc)
+{
+	// 2017-03-14 15:09:26 in BCD
+	static const u8 time[8] = {0x26, 0x09, 0x15, 0x02, 0x14, 0x03, 0x17, 0x00};
+
+	memcpy(rtc, time, sizeof(time));
+}
+
+void getBatteryState(BatteryState *battery)
+{
+	battery->percent = 100;
+	battery->charging = true;
+}
+
+bool storeBootslot(UNUSED u8 slot)
+{
+	return true;
+}
+
+u32 SMP_getNumCores(void)
+{
+	return 1;
+}
+
+void SMP_parallelFor(u32 count, UNUSED u32 minChunk, SmpJobFunc func, void *arg)
+{
+	if(count) func(arg, 0, count);
+}
+
+void TIMER_start(u8 prescaler, u32 ticks, UNUSED bool autoReload, UNUSED bool enableIrq)
+{
+	timerPrescaler = (prescaler ? prescaler : 1);
+	timerStartTicks = ticks;
+	timerStartNs = simGetNs();
+}
+
+u32 TIMER_getTicks(void)
+{
+	const double elapsed = (double)(simGetNs() - timerStartNs) * (TIMER_BASE_FREQ / 2 / timerPrescaler / 1e9);
+	if(elapsed >= timerStartTicks) return 0;
+
+	return timerStartTicks - (u32)elapsed;
+}
+
+void perfBoostBegin(UNUSED const char *const reason)
+{
+}
+
+void perfBoostEnd(void)
+{
+}
+
+u32 perfGetClockMul(void)
+{
+	return 1;
+}
+
+bool perfDumpLog(UNUSED const char *const path)
+{
+	return true;
+}
+
+noreturn void panic()
+{
+	fprintf(stderr, "ARM11 panic\n");
+	abort();
+}
+
+noreturn void panicMsg(const char *msg)
+{
+	fprintf(stderr, "ARM11 panic: %s\n", msg);
+	abort();
+}
+
+noreturn void __fb_assert(const char *const str, u32 line)
+{
+	fprintf(stderr, "ARM11 assertion failed: %s:%u\n", str, line);
+	abort();
+}
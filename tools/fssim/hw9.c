@@ -0,0 +1,377 @@
+/*
+ *   This file is part of fastboot 3DS
+ *   Copyright (C) 2017 derrek, profi200
+ *
+ *   This program is free software: you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License as published by
+ *   the Free Software Foundation, either version 3 of the License, or
+ *   (at your option) any later version.
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/*
+ * ARM9 side of the simulator. SD and NAND are image files accessed with
+ * pread()/pwrite() behind the sdmmc driver interface, everything else the
+ * fs stack touches is stubbed. The NAND image gets an NCSD header and a
+ * FAT32 CTR NAND partition written through the real dev_decnand glue.
+ */
+
+#include <fcntl.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+#include "types.h"
+#include "mem_map.h"
+#include "util.h"
+#include "arm9/ncsd.h"
+#include "arm9/hardware/sdmmc.h"
+#include "arm9/hardware/interrupt.h"
+#include "arm9/hardware/timer.h"
+#include "arm9/hardware/spiflash.h"
+#include "arm9/debug.h"
+#include "arm9/dev.h"
+#include "arm9/firm.h"
+#include "firmwriter.h"
+#include "fb_assert.h"
+#include "fs.h"
+#include "hardware/pxi.h"
+#include "arm.h"
+#include "fssim.h"
+
+
+#define NAND_TWLN_SECTOR     (0x0u)
+#define NAND_AGB_SECTOR      (0x8000u)
+#define NAND_FIRM0_SECTOR    (0x8400u)
+#define NAND_FIRM1_SECTOR    (0xA400u)
+#define NAND_CTRNAND_SECTOR  (0xC400u)
+#define CTRNAND_FAT_SECTOR   (0x97u)
+#define SD_FAT_SECTOR        (0x2000u)
+#define HASH_CHUNK_SIZE      (0x100000u)
+
+
+typedef struct
+{
+	char path[256];
+	int fd;
+	SimDiskStats *stats;
+	mmcdevice mmc;
+} SimDisk;
+
+
+volatile bool g_startFirmLaunch = false;
+
+static SimDisk sdDisk = {.fd = -1, .stats = &g_simStats.sd};
+static SimDisk nandDisk = {.fd = -1, .stats = &g_simStats.nand};
+static IrqHandler irqHandlers[32];
+static volatile bool arm9Ready = false;
+
+
+
+static int diskRead(SimDisk *disk, u32 sector, u32 count, u8 *out)
+{
+	if(disk->fd < 0 || sector > disk->mmc.total_size || count > disk->mmc.total_size - sector)
+		return 1;
+
+	const size_t size = (size_t)count<<9;
+	if(pread(disk->fd, out, size, (off_t)sector<<9) != (ssize_t)size) return 1;
+
+	disk->stats->readCmds++;
+	disk->stats->readSectors += count;
+
+	return 0;
+}
+
+static int diskWrite(SimDisk *disk, u32 sector, u32 count, const u8 *in)
+{
+	if(disk->fd < 0 || sector > disk->mmc.total_size || count > disk->mmc.total_size - sector)
+		return 1;
+
+	const size_t size = (size_t)count<<9;
+	if(pwrite(disk->fd, in, size, (off_t)sector<<9) != (ssize_t)size) return 1;
+
+	disk->stats->writeCmds++;
+	disk->stats->writeSectors += count;
+
+	return 0;
+}
+
+static bool diskCreate(SimDisk *disk, const char *dir, const char *name, u32 sectors)
+{
+	snprintf(disk->path, sizeof(disk->path), "%s/%s", dir, name);
+	disk->fd = open(disk->path, O_RDWR | O_CREAT | O_TRUNC, 0644);
+	if(disk->fd < 0) return false;
+
+	// Sparse so only written sectors take up space
+	if(ftruncate(disk->fd, (off_t)sectors<<9) != 0) return false;
+	disk->mmc.total_size = sectors;
+
+	return true;
+}
+
+void sdmmc_init()
+{
+	// The card is always inserted
+	sdmmc_write16(REG_SDSTATUS0, TMIO_STAT0_SIGSTATE);
+}
+
+int SD_Init()
+{
+	return sdDisk.fd < 0;
+}
+
+int Nand_Init()
+{
+	return nandDisk.fd < 0;
+}
+
+mmcdevice *getMMCDevice(int drive)
+{
+	if(drive == 0) return &nandDisk.mmc;
+	return &sdDisk.mmc;
+}
+
+int sdmmc_sdcard_readsectors(uint32_t sector_no, uint32_t numsectors, uint8_t *out)
+{
+	return diskRead(&sdDisk, sector_no, numsectors, out);
+}
+
+int sdmmc_sdcard_writesectors(uint32_t sector_no, uint32_t numsectors, const uint8_t *in)
+{
+	return diskWrite(&sdDisk, sector_no, numsectors, in);
+}
+
+int sdmmc_nand_readsectors(uint32_t sector_no, uint32_t numsectors, uint8_t *out)
+{
+	return diskRead(&nandDisk, sector_no, numsectors, out);
+}
+
+int sdmmc_nand_writesectors(uint32_t sector_no, uint32_t numsectors, const uint8_t *in)
+{
+	return diskWrite(&nandDisk, sector_no, numsectors, in);
+}
+
+int sdmmc_get_cid(bool isNand, uint32_t *info)
+{
+	static const u32 nandCid[4] = {0x4D8A2F15, 0x0B1E9C74, 0x32303031, 0x15004A4D};
+	static const u32 sdCid[4] = {0x5A6C3C21, 0x9E2A01B5, 0x4D495341, 0x03000053};
+
+	memcpy(info, isNand ? nandCid : sdCid, 16);
+
+	return 0;
+}
+
+// There is no SPI flash on retail units. dev_flash stays inactive.
+bool spiflash_get_status()
+{
+	return false;
+}
+
+void spiflash_read(UNUSED u32 offset, u32 size, u8 *buf)
+{
+	memset(buf, 0xFF, size);
+}
+
+void TIMER_sleep(UNUSED u32 ms)
+{
+}
+
+void IRQ_registerHandler(Interrupt id, IrqHandler handler)
+{
+	irqHandlers[id] = handler;
+}
+
+noreturn void panic()
+{
+	fprintf(stderr, "ARM9 panic\n");
+	abort();
+}
+
+noreturn void panicMsg(const char *msg)
+{
+	fprintf(stderr, "ARM9 panic: %s\n", msg);
+	abort();
+}
+
+noreturn void __fb_assert(const char *const str, u32 line)
+{
+	fprintf(stderr, "ARM9 assertion failed: %s:%u\n", str, line);
+	abort();
+}
+
+// Flashing FIRM partitions and updates is not simulated
+s32 writeFirmPartition(UNUSED const char *const part, UNUSED bool replaceSig)
+{
+	return -1;
+}
+
+s32 loadVerifyUpdate(UNUSED const char *const path, UNUSED u32 *const version)
+{
+	return -1;
+}
+
+
+
+static bool sdImageWrite(u32 sector, u32 count, const void *buf)
+{
+	return !diskWrite(&sdDisk, sector, count, buf);
+}
+
+static bool ctrNandWrite(u32 sector, u32 count, const void *buf)
+{
+	extern u32 ctr_nand_sector;
+
+	return dev_decnand->write_sector(ctr_nand_sector + sector, count, buf);
+}
+
+static bool writeNcsdHeader(void)
+{
+	static const struct
+	{
+		u8 type;
+		u32 sector;
+		u32 count;
+	} parts[5] =
+	{
+		{1, NAND_TWLN_SECTOR, NAND_AGB_SECTOR - NAND_TWLN_SECTOR},
+		{4, NAND_AGB_SECTOR, NAND_FIRM0_SECTOR - NAND_AGB_SECTOR},
+		{3, NAND_FIRM0_SECTOR, NAND_FIRM1_SECTOR - NAND_FIRM0_SECTOR},
+		{3, NAND_FIRM1_SECTOR, NAND_CTRNAND_SECTOR - NAND_FIRM1_SECTOR},
+		{1, NAND_CTRNAND_SECTOR, SIM_NAND_SECTORS - NAND_CTRNAND_SECTOR}
+	};
+
+	NCSD_header header;
+	memset(&header, 0, sizeof(header));
+	memcpy(&header.magic, "NCSD", 4);
+	header.mediaSize = SIM_NAND_SECTORS;
+	for(u32 i = 0; i < arrayEntries(parts); i++)
+	{
+		header.partFsType[i] = parts[i].type;
+		header.partCryptType[i] = (i == 0 ? 1 : 2);
+		header.partitions[i].mediaOffset = parts[i].sector;
+		header.partitions[i].mediaSize = parts[i].count;
+	}
+
+	u8 sector[512];
+	memset(sector, 0, sizeof(sector));
+	memcpy(sector, &header, sizeof(header));
+
+	return !diskWrite(&nandDisk, 0, 1, sector);
+}
+
+bool simImagesCreate(const char *dir)
+{
+	if(!diskCreate(&sdDisk, dir, "sd.img", SIM_SD_SECTORS) ||
+	   !simFormatFat32(sdImageWrite, SIM_SD_SECTORS, SD_FAT_SECTOR, 8, "SIMSD"))
+		return false;
+
+	if(!diskCreate(&nandDisk, dir, "nand.img", SIM_NAND_SECTORS) || !writeNcsdHeader())
+		return false;
+
+	// The CTR NAND filesystem is encrypted like on real hardware
+	const bool ok = dev_decnand->init() &&
+	                simFormatFat32(ctrNandWrite, SIM_NAND_SECTORS - NAND_CTRNAND_SECTOR,
+	                               CTRNAND_FAT_SECTOR, 1, "CTRNAND");
+	dev_decnand->close();
+	dev_rawnand->close();
+	dev_sdcard->close();
+
+	memset(&g_simStats, 0, sizeof(g_simStats));
+
+	return ok;
+}
+
+void simImagesDelete(void)
+{
+	SimDisk *const disks[2] = {&sdDisk, &nandDisk};
+	for(u32 i = 0; i < 2; i++)
+	{
+		if(disks[i]->fd < 0) continue;
+
+		close(disks[i]->fd);
+		disks[i]->fd = -1;
+		unlink(disks[i]->path);
+	}
+}
+
+// Hashes the raw NAND image without going through the simulated hardware
+bool simHashNandImage(u8 hash[32])
+{
+	u8 *const buf = malloc(HASH_CHUNK_SIZE);
+	if(!buf) return false;
+
+	SimSha256 ctx;
+	simSha256Start(&ctx);
+
+	const u64 size = (u64)nandDisk.mmc.total_size<<9;
+	bool ok = true;
+	for(u64 done = 0; done < size && ok; done += HASH_CHUNK_SIZE)
+	{
+		const u32 n = min(size - done, HASH_CHUNK_SIZE);
+		ok = pread(nandDisk.fd, buf, n, done) == (ssize_t)n;
+		simSha256Update(&ctx, buf, n);
+	}
+	simSha256Finish(&ctx, hash);
+	free(buf);
+
+	return ok;
+}
+
+bool simArm9Ready(void)
+{
+	return arm9Ready;
+}
+
+void simBuildFirm(u8 *buf, u32 size)
+{
+	memset(buf, 0, sizeof(firm_header));
+
+	firm_header *const hdr = (firm_header*)buf;
+	memcpy(&hdr->magic, "FIRM", 4);
+	hdr->entrypointarm11 = FCRAM_BASE;
+	hdr->entrypointarm9 = FCRAM_BASE + 0x100;
+
+	firm_sectionheader *const section = &hdr->section[0];
+	section->offset = sizeof(firm_header);
+	section->address = FCRAM_BASE;
+	section->size = size - sizeof(firm_header);
+	section->copyMethod = 0;
+
+	u32 x = 0x3DB007u;
+	u32 *const data = (u32*)(buf + section->offset);
+	for(u32 i = 0; i < section->size / 4; i++)
+	{
+		x ^= x<<13;
+		x ^= x>>17;
+		x ^= x<<5;
+		data[i] = x;
+	}
+
+	SimSha256 ctx;
+	simSha256Start(&ctx);
+	simSha256Update(&ctx, data, section->size);
+	simSha256Finish(&ctx, section->hash);
+}
+
+void* simArm9Main(UNUSED void *arg)
+{
+	PXI_init();
+	arm9Ready = true;
+
+	while(!g_simStop)
+	{
+		if(simTakeArm9Irq()) irqHandlers[IRQ_PXI_SYNC](IRQ_PXI_SYNC);
+		else __wfi();
+	}
+
+	fsDeinit();
+
+	return NULL;
+}
@@ -0,0 +1,60 @@
+#pragma once
+
+/*
+ *   This file is part of fastboot 3DS
+ *   Copyright (C) 2017 derrek, profi200
+ *
+ *   This program is free software: you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License as published by
+ *   the Free Software Foundation, either version 3 of the License, or
+ *   (at your option) any later version.
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+// Host stand-in for arm.h. Found before the real one so the ARM9 and
+// ARM11 code builds for the host. Only the defines of the real header
+// are used.
+
+#define __ASSEMBLER__ 1
+#include "../../../include/arm.h"
+#undef __ASSEMBLER__
+
+#include <sched.h>
+#include "types.h"
+
+
+#define __cpsid(flags)
+#define __cpsie(flags)
+
+// There are no IRQs on the host. The CPSR only needs to round trip.
+static inline u32 __getCpsr(void)
+{
+	return 0;
+}
+
+static inline void __setCpsr_c(UNUSED u32 cpsr)
+{
+}
+
+// Waiting for an IRQ gives the other CPU thread a chance to run
+static inline void __wfi(void)
+{
+	sched_yield();
+}
+
+static inline void __dmb(void)
+{
+	__atomic_thread_fence(__ATOMIC_SEQ_CST);
+}
+
+static inline void __dsb(void)
+{
+	__atomic_thread_fence(__ATOMIC_SEQ_CST);
+}
@@ -0,0 +1,69 @@
+#pragma once
+
+/*
+ *   This file is part of fastboot 3DS
+ *   Copyright (C) 2017 derrek, profi200
+ *
+ *   This program is free software: you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License as published by
+ *   the Free Software Foundation, either version 3 of the License, or
+ *   (at your option) any later version.
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+// Host stand-in for the ARM11 performance monitor. The cycle counter is
+// derived from the monotonic clock as if the CPU ran at 268 MHz with the
+// divide by 64 enabled. The event counters always read 0.
+
+#include <time.h>
+#include "types.h"
+#include "arm.h"
+#include "arm11/hardware/timer.h"
+
+
+
+static inline void startProfiling(UNUSED u16 pmnEvents, UNUSED u8 intMask, UNUSED bool ccntDiv64, UNUSED u8 reset)
+{
+}
+
+static inline void stopProfiling(void)
+{
+}
+
+static inline void setCcnt(UNUSED u32 val)
+{
+}
+
+static inline void setPmn0(UNUSED u32 val)
+{
+}
+
+static inline void setPmn1(UNUSED u32 val)
+{
+}
+
+static inline u32 getCcnt(void)
+{
+	struct timespec ts;
+	clock_gettime(CLOCK_MONOTONIC, &ts);
+
+	const u64 ns = (u64)ts.tv_sec * 1000000000u + ts.tv_nsec;
+	return (u32)(u64)((double)ns * (TIMER_BASE_FREQ / 64 / 1e9));
+}
+
+static inline u32 getPmn0(void)
+{
+	return 0;
+}
+
+static inline u32 getPmn1(void)
+{
+	return 0;
+}
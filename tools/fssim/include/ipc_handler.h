@@ -0,0 +1,33 @@
+#pragma once
+
+/*
+ *   This file is part of fastboot 3DS
+ *   Copyright (C) 2017 derrek, profi200
+ *
+ *   This program is free software: you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License as published by
+ *   the Free Software Foundation, either version 3 of the License, or
+ *   (at your option) any later version.
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+// Host stand-in for ipc_handler.h. The firm passes buffer pointers as
+// 32 bit command words so IpcBuffer must keep its 8 byte layout on the
+// 64 bit host. The simulator keeps all shared buffers below 4 GiB.
+
+#define IpcBuffer IpcBufferArm
+#include "../../../include/ipc_handler.h"
+#undef IpcBuffer
+
+typedef struct
+{
+	u32 ptr;
+	u32 size;
+} IpcBuffer;
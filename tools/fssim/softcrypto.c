@@ -0,0 +1,505 @@
+/*
+ *   This file is part of fastboot 3DS
+ *   Copyright (C) 2017 derrek, profi200
+ *
+ *   This program is free software: you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License as published by
+ *   the Free Software Foundation, either version 3 of the License, or
+ *   (at your option) any later version.
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/*
+ * Software stand-in for the ARM9 AES and SHA engines. Implements the
+ * parts of arm9/hardware/crypto.h used by the fs stack. AES keyslots hold
+ * fixed test keys so encrypted NAND images only round trip within the
+ * simulator. The counter handling follows the hardware so sector offsets
+ * and multi block transfers produce the same keystream.
+ */
+
+#include <string.h>
+#include "types.h"
+#include "util.h"
+#include "arm9/hardware/crypto.h"
+#include "fssim.h"
+
+
+#define ROTR32(x, n)  ((x)>>(n) | (x)<<(32 - (n)))
+#define ROTL32(x, n)  ((x)<<(n) | (x)>>(32 - (n)))
+
+
+typedef struct
+{
+	u32 mode;
+	u32 state[8];
+	u32 blocks;
+	u8 buf[64];
+	u32 bufLen;
+} ShaEngine;
+
+
+static const u8 aesSbox[256] =
+{
+	0x63, 0x7C, 0x77, 0x7B, 0xF2, 0x6B, 0x6F, 0xC5, 0x30, 0x01, 0x67, 0x2B, 0xFE, 0xD7, 0xAB, 0x76,
+	0xCA, 0x82, 0xC9, 0x7D, 0xFA, 0x59, 0x47, 0xF0, 0xAD, 0xD4, 0xA2, 0xAF, 0x9C, 0xA4, 0x72, 0xC0,
+	0xB7, 0xFD, 0x93, 0x26, 0x36, 0x3F, 0xF7, 0xCC, 0x34, 0xA5, 0xE5, 0xF1, 0x71, 0xD8, 0x31, 0x15,
+	0x04, 0xC7, 0x23, 0xC3, 0x18, 0x96, 0x05, 0x9A, 0x07, 0x12, 0x80, 0xE2, 0xEB, 0x27, 0xB2, 0x75,
+	0x09, 0x83, 0x2C, 0x1A, 0x1B, 0x6E, 0x5A, 0xA0, 0x52, 0x3B, 0xD6, 0xB3, 0x29, 0xE3, 0x2F, 0x84,
+	0x53, 0xD1, 0x00, 0xED, 0x20, 0xFC, 0xB1, 0x5B, 0x6A, 0xCB, 0xBE, 0x39, 0x4A, 0x4C, 0x58, 0xCF,
+	0xD0, 0xEF, 0xAA, 0xFB, 0x43, 0x4D, 0x33, 0x85, 0x45, 0xF9, 0x02, 0x7F, 0x50, 0x3C, 0x9F, 0xA8,
+	0x51, 0xA3, 0x40, 0x8F, 0x92, 0x9D, 0x38, 0xF5, 0xBC, 0xB6, 0xDA, 0x21, 0x10, 0xFF, 0xF3, 0xD2,
+	0xCD, 0x0C, 0x13, 0xEC, 0x5F, 0x97, 0x44, 0x17, 0xC4, 0xA7, 0x7E, 0x3D, 0x64, 0x5D, 0x19, 0x73,
+	0x60, 0x81, 0x4F, 0xDC, 0x22, 0x2A, 0x90, 0x88, 0x46, 0xEE, 0xB8, 0x14, 0xDE, 0x5E, 0x0B, 0xDB,
+	0xE0, 0x32, 0x3A, 0x0A, 0x49, 0x06, 0x24, 0x5C, 0xC2, 0xD3, 0xAC, 0x62, 0x91, 0x95, 0xE4, 0x79,
+	0xE7, 0xC8, 0x37, 0x6D, 0x8D, 0xD5, 0x4E, 0xA9, 0x6C, 0x56, 0xF4, 0xEA, 0x65, 0x7A, 0xAE, 0x08,
+	0xBA, 0x78, 0x25, 0x2E, 0x1C, 0xA6, 0xB4, 0xC6, 0xE8, 0xDD, 0x74, 0x1F, 0x4B, 0xBD, 0x8B, 0x8A,
+	0x70, 0x3E, 0xB5, 0x66, 0x48, 0x03, 0xF6, 0x0E, 0x61, 0x35, 0x57, 0xB9, 0x86, 0xC1, 0x1D, 0x9E,
+	0xE1, 0xF8, 0x98, 0x11, 0x69, 0xD9, 0x8E, 0x94, 0x9B, 0x1E, 0x87, 0xE9, 0xCE, 0x55, 0x28, 0xDF,
+	0x8C, 0xA1, 0x89, 0x0D, 0xBF, 0xE6, 0x42, 0x68, 0x41, 0x99, 0x2D, 0x0F, 0xB0, 0x54, 0xBB, 0x16
+};
+
+static const u32 sha256K[64] =
+{
+	0x428A2F98, 0x71374491, 0xB5C0FBCF, 0xE9B5DBA5, 0x3956C25B, 0x59F111F1, 0x923F82A4, 0xAB1C5ED5,
+	0xD807AA98, 0x12835B01, 0x243185BE, 0x550C7DC3, 0x72BE5D74, 0x80DEB1FE, 0x9BDC06A7, 0xC19BF174,
+	0xE49B69C1, 0xEFBE4786, 0x0FC19DC6, 0x240CA1CC, 0x2DE92C6F, 0x4A7484AA, 0x5CB0A9DC, 0x76F988DA,
+	0x983E5152, 0xA831C66D, 0xB00327C8, 0xBF597FC7, 0xC6E00BF3, 0xD5A79147, 0x06CA6351, 0x14292967,
+	0x27B70A85, 0x2E1B2138, 0x4D2C6DFC, 0x53380D13, 0x650A7354, 0x766A0ABB, 0x81C2C92E, 0x92722C85,
+	0xA2BFE8A1, 0xA81A664B, 0xC24B8B70, 0xC76C51A3, 0xD192E819, 0xD6990624, 0xF40E3585, 0x106AA070,
+	0x19A4C116, 0x1E376C08, 0x2748774C, 0x34B0BCB5, 0x391C0CB3, 0x4ED8AA4A, 0x5B9CCA4F, 0x682E6FF3,
+	0x748F82EE, 0x78A5636F, 0x84C87814, 0x8CC70208, 0x90BEFFFA, 0xA4506CEB, 0xBEF9A3F7, 0xC67178F2
+};
+
+static const u32 sha256Init[8] =
+{
+	0x6A09E667, 0xBB67AE85, 0x3C6EF372, 0xA54FF53A, 0x510E527F, 0x9B05688C, 0x1F83D9AB, 0x5BE0CD19
+};
+
+static const u32 sha1Init[5] = {0x67452301, 0xEFCDAB89, 0x98BADCFE, 0x10325476, 0xC3D2E1F0};
+
+// Expanded round keys of the selected keyslot
+static u8 aesRoundKeys[11][16];
+static ShaEngine shaEngine;
+
+
+
+static u8 aesXtime(u8 x)
+{
+	return x<<1 ^ (x & 0x80 ? 0x1B : 0);
+}
+
+static void aesExpandKey(const u8 key[16])
+{
+	static const u8 rcon[10] = {0x01, 0x02, 0x04, 0x08, 0x10, 0x20, 0x40, 0x80, 0x1B, 0x36};
+
+	memcpy(aesRoundKeys[0], key, 16);
+	for(u32 r = 1; r < 11; r++)
+	{
+		const u8 *const prev = aesRoundKeys[r - 1];
+		u8 *const cur = aesRoundKeys[r];
+
+		cur[0] = prev[0] ^ aesSbox[prev[13]] ^ rcon[r - 1];
+		cur[1] = prev[1] ^ aesSbox[prev[14]];
+		cur[2] = prev[2] ^ aesSbox[prev[15]];
+		cur[3] = prev[3] ^ aesSbox[prev[12]];
+		for(u32 i = 4; i < 16; i++) cur[i] = prev[i] ^ cur[i - 4];
+	}
+}
+
+static void aesEncryptBlock(const u8 in[16], u8 out[16])
+{
+	u8 s[16];
+	for(u32 i = 0; i < 16; i++) s[i] = in[i] ^ aesRoundKeys[0][i];
+
+	for(u32 r = 1; r < 11; r++)
+	{
+		u8 t[16];
+
+		// SubBytes and ShiftRows
+		for(u32 c = 0; c < 4; c++)
+		{
+			for(u32 row = 0; row < 4; row++) t[c * 4 + row] = aesSbox[s[((c + row) % 4) * 4 + row]];
+		}
+
+		// MixColumns except in the last round
+		if(r < 10)
+		{
+			for(u32 c = 0; c < 4; c++)
+			{
+				u8 *const col = &t[c * 4];
+				const u8 all = col[0] ^ col[1] ^ col[2] ^ col[3];
+				const u8 first = col[0];
+				col[0] ^= all ^ aesXtime(col[0] ^ col[1]);
+				col[1] ^= all ^ aesXtime(col[1] ^ col[2]);
+				col[2] ^= all ^ aesXtime(col[2] ^ col[3]);
+				col[3] ^= all ^ aesXtime(col[3] ^ first);
+			}
+		}
+
+		for(u32 i = 0; i < 16; i++) s[i] = t[i] ^ aesRoundKeys[r][i];
+	}
+
+	memcpy(out, s, 16);
+}
+
+void AES_selectKeyslot(u8 keyslot)
+{
+	// Fixed test key per keyslot
+	u8 key[16];
+	for(u32 i = 0; i < 16; i++) key[i] = (u8)(keyslot * 0x11u + i * 0x3Du);
+
+	aesExpandKey(key);
+}
+
+void AES_setCtrIv(AES_ctx *const ctx, u8 orderEndianess, const u32 ctrIv[4])
+{
+	ctx->ctrIvNonceParams = (u32)orderEndianess<<23;
+	u32 *const ctrIvNonce = ctx->ctrIvNonce;
+	if(orderEndianess & AES_INPUT_NORMAL)
+	{
+		ctrIvNonce[0] = ctrIv[3];
+		ctrIvNonce[1] = ctrIv[2];
+		ctrIvNonce[2] = ctrIv[1];
+		ctrIvNonce[3] = ctrIv[0];
+	}
+	else
+	{
+		ctrIvNonce[0] = ctrIv[0];
+		ctrIvNonce[1] = ctrIv[1];
+		ctrIvNonce[2] = ctrIv[2];
+		ctrIvNonce[3] = ctrIv[3];
+	}
+}
+
+void AES_addCounter(u32 ctr[4], u32 val)
+{
+	u32 carry, i = 1;
+	u64 sum;
+
+	sum = ctr[0];
+	sum += (val >> 4);
+	carry = sum >> 32;
+	ctr[0] = sum & 0xFFFFFFFFu;
+
+	while(carry && i < 4)
+	{
+		sum = ctr[i];
+		sum += carry;
+		carry = sum >> 32;
+		ctr[i] = sum & 0xFFFFFFFFu;
+		i++;
+	}
+}
+
+void AES_setCryptParams(AES_ctx *const ctx, u8 inEndianessOrder, u8 outEndianessOrder)
+{
+	ctx->aesParams = (u32)inEndianessOrder<<23 | (u32)outEndianessOrder<<22;
+}
+
+// The word order settings only matter for exchanging data with real
+// hardware. The keystream just has to depend on the counter.
+void AES_ctr(AES_ctx *const ctx, const u32 *in, u32 *out, u32 blocks, UNUSED bool dma)
+{
+	u32 *const ctr = ctx->ctrIvNonce;
+
+	g_simStats.aesBlocks += blocks;
+	for(u32 i = 0; i < blocks; i++)
+	{
+		u8 stream[16];
+		aesEncryptBlock((const u8*)ctr, stream);
+
+		const u8 *const src = (const u8*)&in[i * 4];
+		u8 *const dst = (u8*)&out[i * 4];
+		for(u32 n = 0; n < 16; n++) dst[n] = src[n] ^ stream[n];
+
+		AES_addCounter(ctr, 16);
+	}
+}
+
+
+
+static u32 loadBe32(const u8 *p)
+{
+	return (u32)p[0]<<24 | (u32)p[1]<<16 | (u32)p[2]<<8 | p[3];
+}
+
+static void storeBe32(u8 *p, u32 val)
+{
+	p[0] = val>>24;
+	p[1] = val>>16;
+	p[2] = val>>8;
+	p[3] = val;
+}
+
+static void sha256Block(u32 state[8], const u8 block[64])
+{
+	u32 w[64];
+	for(u32 i = 0; i < 16; i++) w[i] = loadBe32(&block[i * 4]);
+	for(u32 i = 16; i < 64; i++)
+	{
+		const u32 s0 = ROTR32(w[i - 15], 7) ^ ROTR32(w[i - 15], 18) ^ w[i - 15]>>3;
+		const u32 s1 = ROTR32(w[i - 2], 17) ^ ROTR32(w[i - 2], 19) ^ w[i - 2]>>10;
+		w[i] = w[i - 16] + s0 + w[i - 7] + s1;
+	}
+
+	u32 a = state[0], b = state[1], c = state[2], d = state[3];
+	u32 e = state[4], f = state[5], g = state[6], h = state[7];
+	for(u32 i = 0; i < 64; i++)
+	{
+		const u32 t1 = h + (ROTR32(e, 6) ^ ROTR32(e, 11) ^ ROTR32(e, 25)) + ((e & f) ^ (~e & g)) + sha256K[i] + w[i];
+		const u32 t2 = (ROTR32(a, 2) ^ ROTR32(a, 13) ^ ROTR32(a, 22)) + ((a & b) ^ (a & c) ^ (b & c));
+		h = g;
+		g = f;
+		f = e;
+		e = d + t1;
+		d = c;
+		c = b;
+		b = a;
+		a = t1 + t2;
+	}
+
+	state[0] += a;
+	state[1] += b;
+	state[2] += c;
+	state[3] += d;
+	state[4] += e;
+	state[5] += f;
+	state[6] += g;
+	state[7] += h;
+}
+
+static void sha1Block(u32 state[8], const u8 block[64])
+{
+	u32 w[80];
+	for(u32 i = 0; i < 16; i++) w[i] = loadBe32(&block[i * 4]);
+	for(u32 i = 16; i < 80; i++) w[i] = ROTL32(w[i - 3] ^ w[i - 8] ^ w[i - 14] ^ w[i - 16], 1);
+
+	u32 a = state[0], b = state[1], c = state[2], d = state[3], e = state[4];
+	for(u32 i = 0; i < 80; i++)
+	{
+		u32 f, k;
+		if(i < 20)
+		{
+			f = (b & c) | (~b & d);
+			k = 0x5A827999;
+		}
+		else if(i < 40)
+		{
+			f = b ^ c ^ d;
+			k = 0x6ED9EBA1;
+		}
+		else if(i < 60)
+		{
+			f = (b & c) | (b & d) | (c & d);
+			k = 0x8F1BBCDC;
+		}
+		else
+		{
+			f = b ^ c ^ d;
+			k = 0xCA62C1D6;
+		}
+
+		const u32 tmp = ROTL32(a, 5) + f + e + k + w[i];
+		e = d;
+		d = c;
+		c = ROTL32(b, 30);
+		b = a;
+		a = tmp;
+	}
+
+	state[0] += a;
+	state[1] += b;
+	state[2] += c;
+	state[3] += d;
+	state[4] += e;
+}
+
+static void shaEngineBlock(const u8 block[64])
+{
+	if(shaEngine.mode == SHA_MODE_1) sha1Block(shaEngine.state, block);
+	else sha256Block(shaEngine.state, block);
+	shaEngine.blocks++;
+}
+
+// Only SHA-256 and SHA-1 are used by the fs stack
+void SHA_start(u8 params)
+{
+	shaEngine.mode = params & (SHA_MODE_1 | SHA_MODE_224 | SHA_MODE_256);
+	if(shaEngine.mode == SHA_MODE_1) memcpy(shaEngine.state, sha1Init, sizeof(sha1Init));
+	else memcpy(shaEngine.state, sha256Init, sizeof(sha256Init));
+	shaEngine.blocks = 0;
+	shaEngine.bufLen = 0;
+}
+
+void SHA_update(const u32 *data, u32 size)
+{
+	const u8 *src = (const u8*)data;
+
+	g_simStats.shaBytes += size;
+	while(size)
+	{
+		const u32 n = min(size, 64u - shaEngine.bufLen);
+		memcpy(&shaEngine.buf[shaEngine.bufLen], src, n);
+		shaEngine.bufLen += n;
+		src += n;
+		size -= n;
+
+		if(shaEngine.bufLen == 64)
+		{
+			shaEngineBlock(shaEngine.buf);
+			shaEngine.bufLen = 0;
+		}
+	}
+}
+
+void SHA_finish(u32 *const hash, u8 endianess)
+{
+	const u64 bits = ((u64)shaEngine.blocks * 64 + shaEngine.bufLen) * 8;
+
+	shaEngine.buf[shaEngine.bufLen++] = 0x80;
+	if(shaEngine.bufLen > 56)
+	{
+		memset(&shaEngine.buf[shaEngine.bufLen], 0, 64 - shaEngine.bufLen);
+		shaEngineBlock(shaEngine.buf);
+		shaEngine.bufLen = 0;
+	}
+	memset(&shaEngine.buf[shaEngine.bufLen], 0, 56 - shaEngine.bufLen);
+	storeBe32(&shaEngine.buf[56], bits>>32);
+	storeBe32(&shaEngine.buf[60], bits);
+	shaEngineBlock(shaEngine.buf);
+	shaEngine.bufLen = 0;
+
+	const u32 hashSize = (shaEngine.mode == SHA_MODE_1 ? 5 : 8);
+	for(u32 i = 0; i < hashSize; i++)
+	{
+		// Big endian output is the byte order of the standard digest
+		if(endianess == SHA_OUTPUT_BIG) storeBe32((u8*)&hash[i], shaEngine.state[i]);
+		else hash[i] = shaEngine.state[i];
+	}
+}
+
+void SHA_getState(u32 state[9])
+{
+	for(u32 i = 0; i < 8; i++) state[i] = shaEngine.state[i];
+	state[8] = shaEngine.blocks;
+}
+
+void SHA_setState(u8 params, const u32 state[9])
+{
+	SHA_start(params);
+
+	for(u32 i = 0; i < 8; i++) shaEngine.state[i] = state[i];
+	shaEngine.blocks = state[8];
+}
+
+void sha(const u32 *data, u32 size, u32 *const hash, u8 params, u8 hashEndianess)
+{
+	SHA_start(params);
+	SHA_update(data, size);
+	SHA_finish(hash, hashEndianess);
+}
+
+
+
+// SHA-256 for the simulator itself. Doesn't touch the engine state.
+void simSha256Start(SimSha256 *ctx)
+{
+	memcpy(ctx->state, sha256Init, sizeof(sha256Init));
+	ctx->bytes = 0;
+	ctx->bufLen = 0;
+}
+
+void simSha256Update(SimSha256 *ctx, const void *data, u32 size)
+{
+	const u8 *src = data;
+
+	ctx->bytes += size;
+	while(size)
+	{
+		const u32 n = min(size, 64u - ctx->bufLen);
+		memcpy(&ctx->buf[ctx->bufLen], src, n);
+		ctx->bufLen += n;
+		src += n;
+		size -= n;
+
+		if(ctx->bufLen == 64)
+		{
+			sha256Block(ctx->state, ctx->buf);
+			ctx->bufLen = 0;
+		}
+	}
+}
+
+void simSha256Finish(SimSha256 *ctx, u8 hash[32])
+{
+	const u64 bits = ctx->bytes * 8;
+	static const u8 pad[64] = {0x80};
+	u8 len[8];
+
+	storeBe32(&len[0], bits>>32);
+	storeBe32(&len[4], bits);
+	simSha256Update(ctx, pad, (ctx->bufLen < 56 ? 56 : 120) - ctx->bufLen);
+	simSha256Update(ctx, len, 8);
+
+	for(u32 i = 0; i < 8; i++) storeBe32(&hash[i * 4], ctx->state[i]);
+}
+
+// Known answers from FIPS 180-2 and FIPS 197
+bool simCryptoSelfTest(void)
+{
+	static const u8 abc256[32] =
+	{
+		0xBA, 0x78, 0x16, 0xBF, 0x8F, 0x01, 0xCF, 0xEA, 0x41, 0x41, 0x40, 0xDE, 0x5D, 0xAE, 0x22, 0x23,
+		0xB0, 0x03, 0x61, 0xA3, 0x96, 0x17, 0x7A, 0x9C, 0xB4, 0x10, 0xFF, 0x61, 0xF2, 0x00, 0x15, 0xAD
+	};
+	static const u8 abc1[20] =
+	{
+		0xA9, 0x99, 0x3E, 0x36, 0x47, 0x06, 0x81, 0x6A, 0xBA, 0x3E,
+		0x25, 0x71, 0x78, 0x50, 0xC2, 0x6C, 0x9C, 0xD0, 0xD8, 0x9D
+	};
+	static const u8 aesKey[16] =
+	{
+		0x00, 0x01, 0x02, 0x03, 0x04, 0x05, 0x06, 0x07, 0x08, 0x09, 0x0A, 0x0B, 0x0C, 0x0D, 0x0E, 0x0F
+	};
+	static const u8 aesPlain[16] =
+	{
+		0x00, 0x11, 0x22, 0x33, 0x44, 0x55, 0x66, 0x77, 0x88, 0x99, 0xAA, 0xBB, 0xCC, 0xDD, 0xEE, 0xFF
+	};
+	static const u8 aesCipher[16] =
+	{
+		0x69, 0xC4, 0xE0, 0xD8, 0x6A, 0x7B, 0x04, 0x30, 0xD8, 0xCD, 0xB7, 0x80, 0x70, 0xB4, 0xC5, 0x5A
+	};
+
+	u32 data = 0x00636261; // "abc" in little endian
+	u32 hash[8];
+	bool ok = true;
+
+	sha(&data, 3, hash, SHA_INPUT_BIG | SHA_MODE_256, SHA_OUTPUT_BIG);
+	ok &= memcmp(hash, abc256, 32) == 0;
+	sha(&data, 3, hash, SHA_INPUT_BIG | SHA_MODE_1, SHA_OUTPUT_BIG);
+	ok &= memcmp(hash, abc1, 20) == 0;
+
+	SimSha256 ctx;
+	u8 hash8[32];
+	simSha256Start(&ctx);
+	simSha256Update(&ctx, "a", 1);
+	simSha256Update(&ctx, "bc", 2);
+	simSha256Finish(&ctx, hash8);
+	ok &= memcmp(hash8, abc256, 32) == 0;
+
+	u8 block[16];
+	aesExpandKey(aesKey);
+	aesEncryptBlock(aesPlain, block);
+	ok &= memcmp(block, aesCipher, 16) == 0;
+
+	g_simStats.shaBytes = 0;
+
+	return ok;
+}
@@ -0,0 +1,299 @@
+/*
+ *   This file is part of fastboot 3DS
+ *   Copyright (C) 2017 derrek, profi200
+ *
+ *   This program is free software: you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License as published by
+ *   the Free Software Foundation, either version 3 of the License, or
+ *   (at your option) any later version.
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/*
+ * Host benchmark for the ARM11 -> ARM9 request ring and the SPSC and MPMC
+ * queues. Pthreads stand in for the CPUs and poll instead of taking IRQs so
+ * the numbers are an upper bound for the index protocol only. Results
+ * are checked so the run doubles as a stress test.
+ */
+
+#include <pthread.h>
+#include <sched.h>
+#include <stdio.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <time.h>
+#include "types.h"
+#include "ipc_handler.h"
+#include "hardware/pxi_ring.h"
+#include "arm11/queue.h"
+
+
+#define RING_REQUESTS   (1u<<22)
+#define SYNC_REQUESTS   (1u<<18)
+#define QUEUE_VALUES    (1u<<24)
+#define QUEUE_SIZE      (64u)
+#define MPMC_THREADS    (4u)              // Producers and consumers each
+#define MPMC_VALUES     (1u<<20)          // Per producer
+#define TEST_CMD        (IPC_CMD9_FREAD)
+
+
+static PxiRing ring __attribute__((aligned(32)));
+static SpscQueue queue;
+static u32 queueBuf[QUEUE_SIZE];
+static MpmcQueue mpmcQueue;
+static MpmcCell mpmcCells[QUEUE_SIZE];
+static u8 mpmcSeen[MPMC_THREADS][MPMC_VALUES];
+static u32 mpmcPopped;
+
+
+
+static u64 nowNs(void)
+{
+	struct timespec ts;
+	clock_gettime(CLOCK_MONOTONIC, &ts);
+	return (u64)ts.tv_sec * 1000000000u + ts.tv_nsec;
+}
+
+static u32 cmdWords(u32 cmd)
+{
+	return IPC_CMD_IN_BUFS_MASK(cmd) * 2 + IPC_CMD_OUT_BUFS_MASK(cmd) * 2 + IPC_CMD_PARAMS_MASK(cmd);
+}
+
+// Stands in for IPC_handleCmd(). The ARM11 side computes the same to check results.
+static u32 fakeHandleCmd(u32 cmd, const u32 *const buf, u32 words)
+{
+	u32 res = cmd;
+	for(u32 i = 0; i < words; i++) res = res * 31 + buf[i];
+	return res;
+}
+
+static void fillSlot(PxiRingSlot *slot, u32 ticket)
+{
+	slot->cmd = TEST_CMD;
+	slot->words = cmdWords(TEST_CMD);
+	for(u32 i = 0; i < slot->words; i++) slot->buf[i] = ticket * 7 + i;
+}
+
+static u32 expectedResult(u32 ticket)
+{
+	u32 buf[IPC_MAX_PARAMS];
+	const u32 words = cmdWords(TEST_CMD);
+	for(u32 i = 0; i < words; i++) buf[i] = ticket * 7 + i;
+	return fakeHandleCmd(TEST_CMD, buf, words);
+}
+
+// ARM9: Same loop as handleRingCmds() without the doorbell IRQ
+static void* arm9Thread(void *arg)
+{
+	const u32 requests = *(const u32*)arg;
+
+	for(u32 handled = 0; handled < requests; )
+	{
+		PxiRingSlot *const slot = pxiRingPeek(&ring);
+		if(!slot)
+		{
+			sched_yield();
+			continue;
+		}
+
+		u32 buf[IPC_MAX_PARAMS];
+		const u32 words = slot->words;
+		for(u32 i = 0; i < words; i++) buf[i] = slot->buf[i];
+
+		slot->result = fakeHandleCmd(slot->cmd, buf, words);
+		pxiRingComplete(&ring);
+		handled++;
+	}
+
+	return NULL;
+}
+
+// ARM11: Collects the result of ticket. Returns false on a mismatch.
+static bool collect(u32 ticket)
+{
+	while(!pxiRingDone(&ring, ticket)) sched_yield();
+	return pxiRingSlot(&ring, ticket)->result == expectedResult(ticket);
+}
+
+// Keeps all slots busy like PXI_submitCmd() + PXI_pollCmd()
+static u32 runRingAsync(u32 requests)
+{
+	u32 errors = 0;
+	u32 collected = 0;
+
+	for(u32 ticket = 0; ticket < requests; ticket++)
+	{
+		if(ticket - collected >= PXI_RING_SLOTS) errors += !collect(collected++);
+
+		fillSlot(pxiRingSlot(&ring, ticket), ticket);
+		pxiRingPublish(&ring, ticket);
+	}
+	while(collected < requests) errors += !collect(collected++);
+
+	return errors;
+}
+
+// One request at a time like PXI_sendCmd()
+static u32 runRingSync(u32 requests)
+{
+	u32 errors = 0;
+
+	for(u32 ticket = 0; ticket < requests; ticket++)
+	{
+		fillSlot(pxiRingSlot(&ring, ticket), ticket);
+		pxiRingPublish(&ring, ticket);
+		errors += !collect(ticket);
+	}
+
+	return errors;
+}
+
+static bool benchRing(const char *const name, u32 (*run)(u32), u32 requests)
+{
+	ring.head = 0;
+	ring.tail = 0;
+
+	pthread_t arm9;
+	if(pthread_create(&arm9, NULL, arm9Thread, &requests) != 0) return false;
+
+	const u64 start = nowNs();
+	const u32 errors = run(requests);
+	pthread_join(arm9, NULL);
+	const u64 ns = nowNs() - start;
+
+	printf("ring %-6s %8u requests %8.1f ns/request %u errors\n", name, requests,
+	       (double)ns / requests, errors);
+
+	return errors == 0;
+}
+
+static void* queueConsumer(void *arg)
+{
+	u32 *const errors = arg;
+
+	for(u32 expected = 0; expected < QUEUE_VALUES; expected++)
+	{
+		u32 val;
+		while(!spscQueuePop(&queue, &val)) sched_yield();
+		if(val != expected) (*errors)++;
+	}
+
+	return NULL;
+}
+
+static bool benchQueue(void)
+{
+	spscQueueInit(&queue, queueBuf, QUEUE_SIZE);
+
+	u32 errors = 0;
+	pthread_t consumer;
+	if(pthread_create(&consumer, NULL, queueConsumer, &errors) != 0) return false;
+
+	const u64 start = nowNs();
+	for(u32 i = 0; i < QUEUE_VALUES; i++)
+	{
+		while(!spscQueuePush(&queue, i)) sched_yield();
+	}
+	pthread_join(consumer, NULL);
+	const u64 ns = nowNs() - start;
+
+	printf("spsc queue  %8u values   %8.1f ns/value   %u errors\n", QUEUE_VALUES,
+	       (double)ns / QUEUE_VALUES, errors);
+
+	return errors == 0;
+}
+
+// Values are producer<<24 | sequence number
+static void* mpmcProducer(void *arg)
+{
+	const u32 producer = (u32)(uintptr_t)arg;
+
+	for(u32 i = 0; i < MPMC_VALUES; i++)
+	{
+		while(!mpmcQueuePush(&mpmcQueue, producer<<24 | i)) sched_yield();
+	}
+
+	return NULL;
+}
+
+static void* mpmcConsumer(void *arg)
+{
+	u32 *const errors = arg;
+	// A FIFO hands each consumer the values of one producer in order
+	s32 last[MPMC_THREADS];
+	for(u32 i = 0; i < MPMC_THREADS; i++) last[i] = -1;
+
+	while(__atomic_load_n(&mpmcPopped, __ATOMIC_RELAXED) < MPMC_THREADS * MPMC_VALUES)
+	{
+		u32 val;
+		if(!mpmcQueuePop(&mpmcQueue, &val))
+		{
+			sched_yield();
+			continue;
+		}
+		__atomic_fetch_add(&mpmcPopped, 1, __ATOMIC_RELAXED);
+
+		const u32 producer = val>>24;
+		const u32 seq = val & 0xFFFFFF;
+		if(producer >= MPMC_THREADS || seq >= MPMC_VALUES || (s32)seq <= last[producer])
+		{
+			(*errors)++;
+			continue;
+		}
+		last[producer] = seq;
+		mpmcSeen[producer][seq]++;
+	}
+
+	return NULL;
+}
+
+static bool benchMpmcQueue(void)
+{
+	mpmcQueueInit(&mpmcQueue, mpmcCells, QUEUE_SIZE);
+
+	u32 errors[MPMC_THREADS] = {0};
+	pthread_t producers[MPMC_THREADS], consumers[MPMC_THREADS];
+	const u64 start = nowNs();
+	for(u32 i = 0; i < MPMC_THREADS; i++)
+	{
+		if(pthread_create(&consumers[i], NULL, mpmcConsumer, &errors[i]) != 0) return false;
+		if(pthread_create(&producers[i], NULL, mpmcProducer, (void*)(uintptr_t)i) != 0) return false;
+	}
+	for(u32 i = 0; i < MPMC_THREADS; i++)
+	{
+		pthread_join(producers[i], NULL);
+		pthread_join(consumers[i], NULL);
+	}
+	const u64 ns = nowNs() - start;
+
+	// Every value exactly once
+	u32 errorSum = 0;
+	for(u32 i = 0; i < MPMC_THREADS; i++)
+	{
+		errorSum += errors[i];
+		for(u32 seq = 0; seq < MPMC_VALUES; seq++) errorSum += mpmcSeen[i][seq] != 1;
+	}
+
+	const u32 values = MPMC_THREADS * MPMC_VALUES;
+	printf("mpmc queue  %8u values   %8.1f ns/value   %u errors (%u producers, %u consumers)\n",
+	       values, (double)ns / values, errorSum, MPMC_THREADS, MPMC_THREADS);
+
+	return errorSum == 0;
+}
+
+int main(void)
+{
+	bool ok = benchRing("async", runRingAsync, RING_REQUESTS);
+	ok &= benchRing("sync", runRingSync, SYNC_REQUESTS);
+	ok &= benchQueue();
+	ok &= benchMpmcQueue();
+
+	return ok ? EXIT_SUCCESS : EXIT_FAILURE;
+}
@@ -0,0 +1,421 @@
+/*
+ *   This file is part of fastboot 3DS
+ *   Copyright (C) 2017 derrek, profi200
+ *
+ *   This program is free software: you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License as published by
+ *   the Free Software Foundation, either version 3 of the License, or
+ *   (at your option) any later version.
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <stdio.h>
+#include <string.h>
+#include "armsim.h"
+
+
+
+void armSimMap(ArmSim *sim, u32 base, void *mem, u32 size, bool writable)
+{
+	if(sim->numRegions < ARMSIM_MAX_REGIONS)
+		sim->regions[sim->numRegions++] = (ArmSimRegion){base, size, (u8*)mem, writable};
+}
+
+static u8* translate(ArmSim *sim, u32 addr, u32 size, bool write)
+{
+	for(u32 i = 0; i < sim->numRegions; i++)
+	{
+		const ArmSimRegion *const reg = &sim->regions[i];
+		if(addr >= reg->base && addr - reg->base <= reg->size && reg->size - (addr - reg->base) >= size)
+		{
+			if(write && !reg->writable) break;
+			return reg->mem + (addr - reg->base);
+		}
+	}
+
+	snprintf(sim->fault, sizeof(sim->fault), "%s of %u bytes at 0x%08X out of bounds (pc 0x%08X)",
+	         (write ? "store" : "load"), size, addr, sim->r[15] - 8);
+	return NULL;
+}
+
+static bool load(ArmSim *sim, u32 addr, u32 size, u32 *val)
+{
+	const u8 *const p = translate(sim, addr, size, false);
+	if(!p) return false;
+
+	const ArmSimRegion *const code = &sim->regions[0];
+	if(sim->loads && addr >= code->base && addr - code->base < code->size) sim->loads[(addr - code->base) / 4]++;
+
+	u32 tmp = 0;
+	memcpy(&tmp, p, size); // Little endian host
+	*val = tmp;
+	return true;
+}
+
+static bool store(ArmSim *sim, u32 addr, u32 size, u32 val)
+{
+	u8 *const p = translate(sim, addr, size, true);
+	if(!p) return false;
+
+	memcpy(p, &val, size);
+	return true;
+}
+
+static bool condPassed(const ArmSim *sim, u32 cond)
+{
+	bool res;
+	switch(cond>>1)
+	{
+		case 0: res = sim->z; break;                           // EQ/NE
+		case 1: res = sim->c; break;                           // CS/CC
+		case 2: res = sim->n; break;                           // MI/PL
+		case 3: res = sim->v; break;                           // VS/VC
+		case 4: res = sim->c && !sim->z; break;                // HI/LS
+		case 5: res = sim->n == sim->v; break;                 // GE/LT
+		case 6: res = !sim->z && sim->n == sim->v; break;      // GT/LE
+		default: return true;                                  // AL
+	}
+
+	return (cond & 1 ? !res : res);
+}
+
+static u32 shift(u32 val, u32 type, u32 amount, bool byReg, bool *carry)
+{
+	if(byReg && amount == 0) return val;
+
+	switch(type)
+	{
+		case 0: // LSL
+			if(amount == 0) return val;
+			if(amount < 32)
+			{
+				*carry = val>>(32 - amount) & 1;
+				return val<<amount;
+			}
+			*carry = (amount == 32 ? val & 1 : 0);
+			return 0;
+		case 1: // LSR, #0 encodes #32
+			if(!byReg && amount == 0) amount = 32;
+			if(amount < 32)
+			{
+				*carry = val>>(amount - 1) & 1;
+				return val>>amount;
+			}
+			*carry = (amount == 32 ? val>>31 : 0);
+			return 0;
+		case 2: // ASR, #0 encodes #32
+			if(!byReg && amount == 0) amount = 32;
+			if(amount < 32)
+			{
+				*carry = (s32)val>>(amount - 1) & 1;
+				return (u32)((s32)val>>amount);
+			}
+			*carry = val>>31;
+			return (val>>31 ? 0xFFFFFFFFu : 0);
+		default: // ROR, #0 encodes RRX
+			if(!byReg && amount == 0)
+			{
+				const u32 res = (u32)*carry<<31 | val>>1;
+				*carry = val & 1;
+				return res;
+			}
+			amount &= 31;
+			if(amount) val = val>>amount | val<<(32 - amount);
+			*carry = val>>31;
+			return val;
+	}
+}
+
+static u32 addWithCarry(ArmSim *sim, u32 a, u32 b, bool carryIn, bool setFlags)
+{
+	const u64 res = (u64)a + b + carryIn;
+	if(setFlags)
+	{
+		sim->c = res>>32;
+		sim->v = (~(a ^ b) & (a ^ (u32)res))>>31;
+	}
+	return (u32)res;
+}
+
+static bool dataProcessing(ArmSim *sim, u32 ins)
+{
+	const u32 op = ins>>21 & 0xF;
+	const bool s = ins>>20 & 1;
+	const u32 rn = ins>>16 & 0xF;
+	const u32 rd = ins>>12 & 0xF;
+
+	bool carry = sim->c;
+	u32 op2;
+	if(ins & 1u<<25)
+	{
+		const u32 rot = (ins>>8 & 0xF) * 2;
+		op2 = ins & 0xFF;
+		if(rot)
+		{
+			op2 = op2>>rot | op2<<(32 - rot);
+			carry = op2>>31;
+		}
+	}
+	else
+	{
+		const bool byReg = ins>>4 & 1;
+		const u32 amount = (byReg ? sim->r[ins>>8 & 0xF] & 0xFF : ins>>7 & 0x1F);
+		op2 = shift(sim->r[ins & 0xF], ins>>5 & 3, amount, byReg, &carry);
+	}
+
+	const u32 a = sim->r[rn];
+	bool logical = true;
+	u32 res;
+	switch(op)
+	{
+		case 0x0: case 0x8: res = a & op2; break;   // AND/TST
+		case 0x1: case 0x9: res = a ^ op2; break;   // EOR/TEQ
+		case 0xC: res = a | op2; break;             // ORR
+		case 0xD: res = op2; break;                 // MOV
+		case 0xE: res = a & ~op2; break;            // BIC
+		case 0xF: res = ~op2; break;                // MVN
+		default:
+			logical = false;
+			switch(op)
+			{
+				case 0x2: case 0xA: res = addWithCarry(sim, a, ~op2, true, s); break;    // SUB/CMP
+				case 0x3: res = addWithCarry(sim, op2, ~a, true, s); break;              // RSB
+				case 0x4: case 0xB: res = addWithCarry(sim, a, op2, false, s); break;    // ADD/CMN
+				case 0x5: res = addWithCarry(sim, a, op2, sim->c, s); break;             // ADC
+				case 0x6: res = addWithCarry(sim, a, ~op2, sim->c, s); break;            // SBC
+				default: res = addWithCarry(sim, op2, ~a, sim->c, s); break;             // RSC
+			}
+	}
+
+	if(s)
+	{
+		if(rd == 15)
+		{
+			snprintf(sim->fault, sizeof(sim->fault), "unsupported flag setting write to pc");
+			return false;
+		}
+		sim->n = res>>31;
+		sim->z = res == 0;
+		if(logical) sim->c = carry;
+	}
+	if(op < 8 || op > 0xB) sim->r[rd] = res; // TST/TEQ/CMP/CMN only set flags
+
+	return true;
+}
+
+static bool loadStore(ArmSim *sim, u32 ins)
+{
+	const bool p = ins>>24 & 1, u = ins>>23 & 1, b = ins>>22 & 1, w = ins>>21 & 1, l = ins>>20 & 1;
+	const u32 rn = ins>>16 & 0xF;
+	const u32 rd = ins>>12 & 0xF;
+
+	u32 offset;
+	if(ins & 1u<<25)
+	{
+		bool carry = sim->c;
+		offset = shift(sim->r[ins & 0xF], ins>>5 & 3, ins>>7 & 0x1F, false, &carry);
+	}
+	else offset = ins & 0xFFF;
+
+	const u32 base = sim->r[rn];
+	const u32 offAddr = (u ? base + offset : base - offset);
+	const u32 addr = (p ? offAddr : base);
+	const u32 size = (b ? 1 : 4);
+
+	u32 val = 0;
+	if(l)
+	{
+		if(!load(sim, addr, size, &val)) return false;
+	}
+	else if(!store(sim, addr, size, sim->r[rd] + (rd == 15 ? 4 : 0))) return false;
+
+	if(!p || w) sim->r[rn] = offAddr;
+	if(l) sim->r[rd] = val;
+
+	return true;
+}
+
+static bool extraLoadStore(ArmSim *sim, u32 ins)
+{
+	const bool p = ins>>24 & 1, u = ins>>23 & 1, i = ins>>22 & 1, w = ins>>21 & 1, l = ins>>20 & 1;
+	const u32 rn = ins>>16 & 0xF;
+	const u32 rd = ins>>12 & 0xF;
+	const u32 sh = ins>>5 & 3;
+
+	const u32 offset = (i ? (ins>>4 & 0xF0) | (ins & 0xF) : sim->r[ins & 0xF]);
+	const u32 base = sim->r[rn];
+	const u32 offAddr = (u ? base + offset : base - offset);
+	const u32 addr = (p ? offAddr : base);
+
+	u32 val = 0;
+	if(l)
+	{
+		const u32 size = (sh == 2 ? 1 : 2);
+		if(!load(sim, addr, size, &val)) return false;
+		if(sh == 2) val = (u32)(s8)val;
+		else if(sh == 3) val = (u32)(s16)val;
+	}
+	else
+	{
+		if(sh != 1)
+		{
+			snprintf(sim->fault, sizeof(sim->fault), "unsupported LDRD/STRD at 0x%08X", sim->r[15] - 8);
+			return false;
+		}
+		if(!store(sim, addr, 2, sim->r[rd])) return false;
+	}
+
+	if(!p || w) sim->r[rn] = offAddr;
+	if(l) sim->r[rd] = val;
+
+	return true;
+}
+
+static bool blockTransfer(ArmSim *sim, u32 ins, bool *branched)
+{
+	const bool p = ins>>24 & 1, u = ins>>23 & 1, w = ins>>21 & 1, l = ins>>20 & 1;
+	const u32 rn = ins>>16 & 0xF;
+	const u32 list = ins & 0xFFFF;
+
+	if(ins & 1u<<22)
+	{
+		snprintf(sim->fault, sizeof(sim->fault), "unsupported LDM/STM with ^ at 0x%08X", sim->r[15] - 8);
+		return false;
+	}
+
+	const u32 bytes = (u32)__builtin_popcount(list) * 4;
+	const u32 base = sim->r[rn];
+	u32 addr = (u ? base : base - bytes);
+	if(p == u) addr += 4;
+
+	for(u32 reg = 0; reg < 16; reg++)
+	{
+		if(!(list & 1u<<reg)) continue;
+
+		if(l)
+		{
+			u32 val;
+			if(!load(sim, addr, 4, &val)) return false;
+			sim->r[reg] = val;
+			if(reg == 15) *branched = true;
+		}
+		else if(!store(sim, addr, 4, sim->r[reg])) return false;
+		addr += 4;
+	}
+
+	if(w && !(l && (list & 1u<<rn))) sim->r[rn] = (u ? base + bytes : base - bytes);
+
+	return true;
+}
+
+static bool step(ArmSim *sim, u32 pc, bool *branched)
+{
+	const u8 *const insPtr = (pc & 3 ? NULL : translate(sim, pc, 4, false));
+	if(!insPtr)
+	{
+		snprintf(sim->fault, sizeof(sim->fault), "bad instruction fetch at 0x%08X", pc);
+		return false;
+	}
+	u32 ins;
+	memcpy(&ins, insPtr, 4);
+
+	const u32 cond = ins>>28;
+	sim->r[15] = pc + 8;
+	if(cond == 0xF)
+	{
+		if((ins & 0xFD70F000u) == 0xF550F000u) return true; // PLD
+		snprintf(sim->fault, sizeof(sim->fault), "unsupported instruction 0x%08X at 0x%08X", ins, pc);
+		return false;
+	}
+	if(!condPassed(sim, cond)) return true;
+
+	bool ok;
+	const u32 rd = ins>>12 & 0xF;
+	switch(ins>>25 & 7)
+	{
+		case 0:
+			if((ins & 0x0FFFFFF0u) == 0x012FFF10u) // BX
+			{
+				const u32 target = sim->r[ins & 0xF];
+				if(target & 1)
+				{
+					snprintf(sim->fault, sizeof(sim->fault), "Thumb is not supported (pc 0x%08X)", pc);
+					return false;
+				}
+				sim->r[15] = target;
+				*branched = true;
+				return true;
+			}
+			if((ins & 0x90u) == 0x90u)
+			{
+				if(ins & 0x60u)
+				{
+					ok = extraLoadStore(sim, ins);
+					*branched = ok && (ins>>20 & 1) && rd == 15;
+					return ok;
+				}
+				snprintf(sim->fault, sizeof(sim->fault), "unsupported multiply/swap 0x%08X at 0x%08X", ins, pc);
+				return false;
+			}
+			if((ins & 0x01900000u) == 0x01000000u)
+			{
+				snprintf(sim->fault, sizeof(sim->fault), "unsupported instruction 0x%08X at 0x%08X", ins, pc);
+				return false;
+			}
+			// Fallthrough
+		case 1:
+			ok = dataProcessing(sim, ins);
+			*branched = ok && rd == 15 && ((ins>>21 & 0xF) < 8 || (ins>>21 & 0xF) > 0xB);
+			return ok;
+		case 3:
+			if(ins & 0x10u)
+			{
+				snprintf(sim->fault, sizeof(sim->fault), "undefined instruction 0x%08X at 0x%08X", ins, pc);
+				return false;
+			}
+			// Fallthrough
+		case 2:
+			ok = loadStore(sim, ins);
+			*branched = ok && (ins>>20 & 1) && rd == 15;
+			return ok;
+		case 4:
+			return blockTransfer(sim, ins, branched);
+		case 5:
+			if(ins & 1u<<24) sim->r[14] = pc + 4; // BL
+			sim->r[15] = pc + 8 + ((u32)((s32)(ins<<8)>>6));
+			*branched = true;
+			return true;
+		default:
+			snprintf(sim->fault, sizeof(sim->fault), "unsupported instruction 0x%08X at 0x%08X", ins, pc);
+			return false;
+	}
+}
+
+bool armSimCall(ArmSim *sim, u32 entry, const u32 *args, u32 numArgs, u64 maxSteps)
+{
+	for(u32 i = 0; i < numArgs && i < 4; i++) sim->r[i] = args[i];
+	sim->r[14] = ARMSIM_RETURN;
+	sim->fault[0] = '\0';
+
+	const ArmSimRegion *const code = &sim->regions[0];
+	u32 pc = entry;
+	for(sim->steps = 0; sim->steps < maxSteps; sim->steps++)
+	{
+		if(pc == ARMSIM_RETURN) return true;
+		if(sim->hits && pc >= code->base && pc - code->base < code->size) sim->hits[(pc - code->base) / 4]++;
+
+		bool branched = false;
+		if(!step(sim, pc, &branched)) return false;
+		pc = (branched ? sim->r[15] : pc + 4);
+	}
+
+	snprintf(sim->fault, sizeof(sim->fault), "no return after %llu instructions", (unsigned long long)maxSteps);
+	return false;
+}
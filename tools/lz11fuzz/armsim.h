@@ -0,0 +1,80 @@
+#pragma once
+
+/*
+ *   This file is part of fastboot 3DS
+ *   Copyright (C) 2017 derrek, profi200
+ *
+ *   This program is free software: you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License as published by
+ *   the Free Software Foundation, either version 3 of the License, or
+ *   (at your option) any later version.
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/*
+ * Minimal ARM (A32) interpreter for running leaf assembly functions on a
+ * host. Covers data processing, single and halfword loads/stores, LDM/STM,
+ * B/BL/BX and PLD. No Thumb, multiplies, coprocessors or exceptions.
+ * Unaligned word and halfword accesses behave like ARMv6 with U=1.
+ * Every memory access must fall into one of the registered regions.
+ */
+
+#include "types.h"
+
+
+#define ARMSIM_MAX_REGIONS  (8)
+#define ARMSIM_RETURN       (0xFFFFFFF0u) // lr of the called function
+
+
+typedef struct
+{
+	u32 base;
+	u32 size;
+	u8 *mem;
+	bool writable;
+} ArmSimRegion;
+
+typedef struct
+{
+	u32 r[16];
+	bool n, z, c, v;
+	ArmSimRegion regions[ARMSIM_MAX_REGIONS];
+	u32 numRegions;
+	u32 *hits;      // Optional. Execution count per word of the first region.
+	u32 *loads;     // Optional. Load count per word of the first region (literal pools).
+	u64 steps;      // Instructions executed by the last armSimCall()
+	char fault[96]; // Reason the last run stopped early
+} ArmSim;
+
+
+
+/**
+ * @brief      Maps host memory into the guest address space.
+ *
+ * @param      sim       The simulator.
+ * @param[in]  base      The guest address.
+ * @param      mem       The host memory.
+ * @param[in]  size      The size in bytes.
+ * @param[in]  writable  Allow stores.
+ */
+void armSimMap(ArmSim *sim, u32 base, void *mem, u32 size, bool writable);
+
+/**
+ * @brief      Calls a function with up to 4 arguments (AAPCS).
+ *
+ * @param      sim       The simulator. r13 must point to a mapped stack.
+ * @param[in]  entry     The function address.
+ * @param[in]  args      The arguments.
+ * @param[in]  numArgs   The number of arguments.
+ * @param[in]  maxSteps  Instruction limit.
+ *
+ * @return     true if the function returned, false on a fault (see sim->fault).
+ */
+bool armSimCall(ArmSim *sim, u32 entry, const u32 *args, u32 numArgs, u64 maxSteps);
@@ -0,0 +1,171 @@
+/*
+ *   This file is part of fastboot 3DS
+ *   Copyright (C) 2017 derrek, profi200
+ *
+ *   This program is free software: you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License as published by
+ *   the Free Software Foundation, either version 3 of the License, or
+ *   (at your option) any later version.
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/*
+ * Host fuzz test for lz11DecompressBounded(). Random data is compressed
+ * with a greedy encoder, then decoded unmodified, truncated and with
+ * flipped bits. Every result must match a byte-wise reference decoder.
+ * Buffers are allocated with their exact size so ASan catches any read
+ * or write past them.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "types.h"
+#include "arm11/lz11.h"
+#include "lz11test.h"
+
+
+#define ITERATIONS  (2000u)
+
+
+
+// Byte-wise reference with the same semantics as lz11DecompressBounded().
+static bool refDecompress(const u8 *in, u32 inSize, u8 *out, u32 outSize)
+{
+	u32 inPos = 0, outPos = 0;
+	while(outPos < outSize)
+	{
+		if(inPos >= inSize) return false;
+		const u32 flags = in[inPos++];
+
+		for(u32 mask = 0x80; mask && outPos < outSize; mask >>= 1)
+		{
+			if(!(flags & mask))
+			{
+				if(inPos >= inSize) return false;
+				out[outPos++] = in[inPos++];
+				continue;
+			}
+
+			if(inPos >= inSize) return false;
+			const u32 type = in[inPos]>>4;
+			const u32 need = (type == 0 ? 3 : (type == 1 ? 4 : 2));
+			if(inSize - inPos < need) return false;
+
+			const u8 *const p = &in[inPos];
+			u32 len, disp;
+			if(type == 0)
+			{
+				len = ((p[0] & 0xFu)<<4 | p[1]>>4) + 0x11;
+				disp = (p[1] & 0xFu)<<8 | p[2];
+			}
+			else if(type == 1)
+			{
+				len = ((p[0] & 0xFu)<<12 | (u32)p[1]<<4 | p[2]>>4) + 0x111;
+				disp = (p[2] & 0xFu)<<8 | p[3];
+			}
+			else
+			{
+				len = type + 1;
+				disp = (p[0] & 0xFu)<<8 | p[1];
+			}
+			inPos += need;
+			disp++;
+
+			if(disp > outPos || len > outSize - outPos) return false;
+			for(u32 i = 0; i < len; i++, outPos++) out[outPos] = out[outPos - disp];
+		}
+	}
+
+	return true;
+}
+
+// Returns false if the two decoders disagree.
+static bool check(const u8 *in, u32 inSize, u32 outSize)
+{
+	u8 *const exact = (u8*)malloc(inSize ? inSize : 1);
+	u8 *const out = (u8*)malloc(outSize);
+	u8 *const ref = (u8*)malloc(outSize);
+	if(!exact || !out || !ref)
+	{
+		fputs("Out of memory\n", stderr);
+		exit(EXIT_FAILURE);
+	}
+	memcpy(exact, in, inSize);
+
+	const bool res = lz11DecompressBounded(exact, inSize, out, outSize);
+	const bool refRes = refDecompress(exact, inSize, ref, outSize);
+	const bool ok = (res == refRes) && (!res || !memcmp(out, ref, outSize));
+
+	free(ref);
+	free(out);
+	free(exact);
+
+	return ok;
+}
+
+int main(void)
+{
+	u8 *const data = (u8*)malloc(MAX_SIZE);
+	u8 *const comp = (u8*)malloc(MAX_SIZE * 9 / 8 + 8);
+	u8 *const dec = (u8*)malloc(MAX_SIZE);
+	if(!data || !comp || !dec) return EXIT_FAILURE;
+
+	u32 errors = 0, roundTrips = 0, mutations = 0;
+	for(u32 it = 0; it < ITERATIONS; it++)
+	{
+		const u32 size = 1u + rng() % MAX_SIZE;
+		fillRandom(data, size);
+		const u32 compSize = compress(data, size, comp);
+
+		// round trip
+		u8 *const exact = (u8*)malloc(compSize);
+		memcpy(exact, comp, compSize);
+		if(!lz11DecompressBounded(exact, compSize, dec, size) || memcmp(dec, data, size))
+		{
+			printf("Round trip failed: size 0x%X\n", size);
+			errors++;
+		}
+		free(exact);
+		roundTrips++;
+
+		// truncated input and a larger output than encoded
+		if(!check(comp, rng() % compSize, size)) errors++;
+		if(!check(comp, compSize, size + 1u + rng() % 64u)) errors++;
+
+		// flipped bits
+		for(u32 i = 0; i < 8; i++)
+		{
+			const u32 pos = rng() % compSize;
+			const u8 bit = 1u<<(rng() % 8);
+			comp[pos] ^= bit;
+			if(!check(comp, compSize, size))
+			{
+				printf("Mismatch: size 0x%X, byte 0x%X\n", size, pos);
+				errors++;
+			}
+			comp[pos] ^= bit;
+			mutations++;
+		}
+
+		// random garbage
+		fillRandom(comp, compSize);
+		if(!check(comp, compSize, size)) errors++;
+		mutations += 3;
+	}
+
+	free(dec);
+	free(comp);
+	free(data);
+
+	printf("%u round trips, %u corrupted streams, %u errors\n", roundTrips, mutations, errors);
+
+	return (errors ? EXIT_FAILURE : EXIT_SUCCESS);
+}
@@ -0,0 +1,117 @@
+#pragma once
+
+/*
+ *   This file is part of fastboot 3DS
+ *   Copyright (C) 2017 derrek, profi200
+ *
+ *   This program is free software: you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License as published by
+ *   the Free Software Foundation, either version 3 of the License, or
+ *   (at your option) any later version.
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+// Test data generator and greedy LZ11 encoder shared by the host tests.
+
+#include "types.h"
+
+
+#define MAX_SIZE    (0x6000u)
+#define WINDOW      (0x1000u)
+#define MAX_LEN     (0x10110u)
+
+
+
+static u32 rngState = 0x3D5F00D;
+
+static u32 rng(void)
+{
+	// xorshift32
+	u32 x = rngState;
+	x ^= x<<13;
+	x ^= x>>17;
+	x ^= x<<5;
+	return rngState = x;
+}
+
+// Greedy encoder. Returns the compressed size.
+static u32 compress(const u8 *in, u32 size, u8 *out)
+{
+	u32 inPos = 0, outPos = 0;
+	while(inPos < size)
+	{
+		const u32 flagsPos = outPos++;
+		u8 flags = 0;
+		for(u32 i = 0; i < 8 && inPos < size; i++)
+		{
+			u32 bestLen = 0, bestDisp = 0;
+			const u32 maxDisp = (inPos < WINDOW ? inPos : WINDOW);
+			for(u32 disp = 1; disp <= maxDisp; disp++)
+			{
+				u32 len = 0;
+				while(len < MAX_LEN && inPos + len < size && in[inPos + len] == in[inPos + len - disp]) len++;
+				if(len > bestLen)
+				{
+					bestLen = len;
+					bestDisp = disp;
+				}
+			}
+
+			if(bestLen < 3)
+			{
+				out[outPos++] = in[inPos++];
+				continue;
+			}
+
+			flags |= 0x80u>>i;
+			const u32 d = bestDisp - 1;
+			if(bestLen <= 0x10)
+			{
+				out[outPos++] = (bestLen - 1)<<4 | d>>8;
+			}
+			else if(bestLen <= 0x110)
+			{
+				const u32 l = bestLen - 0x11;
+				out[outPos++] = l>>4;
+				out[outPos++] = (l & 0xFu)<<4 | d>>8;
+			}
+			else
+			{
+				const u32 l = bestLen - 0x111;
+				out[outPos++] = 1u<<4 | l>>12;
+				out[outPos++] = l>>4;
+				out[outPos++] = (l & 0xFu)<<4 | d>>8;
+			}
+			out[outPos++] = d;
+			inPos += bestLen;
+		}
+		out[flagsPos] = flags;
+	}
+
+	return outPos;
+}
+
+static void fillRandom(u8 *buf, u32 size)
+{
+	// small alphabets and repeated runs give plenty of matches
+	const u32 alphabet = 1u + rng() % 256u;
+	u32 i = 0;
+	while(i < size)
+	{
+		if(i >= 8 && rng() % 4 == 0)
+		{
+			const u32 disp = 1u + rng() % (i < 64 ? i : 64);
+			u32 len = 1u + rng() % 300u;
+			if(rng() % 64 == 0) len += rng() % 0x4000u;
+			for(; len && i < size; len--, i++) buf[i] = buf[i - disp];
+		}
+		else buf[i++] = rng() % alphabet;
+	}
+}
@@ -0,0 +1,158 @@
+/*
+ *   This file is part of fastboot 3DS
+ *   Copyright (C) 2017 derrek, profi200
+ *
+ *   This program is free software: you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License as published by
+ *   the Free Software Foundation, either version 3 of the License, or
+ *   (at your option) any later version.
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/*
+ * Host check of the assembly lz4Decompress() in source/arm11/lz4.s.
+ * The function is assembled for the ARM11 and run in a small ARM
+ * interpreter (armsim.c) on blocks from the splatool encoder with all
+ * input/output alignments. Output must match the original data and any
+ * access outside the input, output, stack and code is reported. Also
+ * checks that every instruction ran at least once so the literal and
+ * word copy fast paths are covered.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "types.h"
+#include "armsim.h"
+#include "lz11test.h"
+#include "lzenc.h"
+
+
+#define ITERATIONS  (2000u)
+#define CODE_BASE   (0x00001000u)
+#define IN_BASE     (0x00100000u)
+#define OUT_BASE    (0x00200000u)
+#define STACK_BASE  (0x00F00000u)
+#define STACK_SIZE  (0x1000u)
+#define MAX_CODE    (0x1000u)
+
+
+
+static u8 code[MAX_CODE];
+static u32 codeSize;
+static u32 hits[MAX_CODE / 4];
+static u32 loads[MAX_CODE / 4];
+static u8 stack[STACK_SIZE];
+
+static bool loadCode(const char *const path)
+{
+	FILE *const f = fopen(path, "rb");
+	if(!f) return false;
+	codeSize = fread(code, 1, sizeof(code), f);
+	fclose(f);
+
+	return codeSize >= 4 && !(codeSize & 3);
+}
+
+// Runs the assembly decoder with in and out at the given misalignments.
+static bool runAsm(const u8 *in, u32 inSize, u32 inAlign, u8 *out, u32 outSize, u32 outAlign)
+{
+	ArmSim sim;
+	memset(&sim, 0, sizeof(sim));
+	sim.hits = hits;
+	sim.loads = loads;
+	armSimMap(&sim, CODE_BASE, code, codeSize, false); // Must be first
+	armSimMap(&sim, IN_BASE + inAlign, (void*)in, inSize, false);
+	armSimMap(&sim, OUT_BASE + outAlign, out, outSize, true);
+	armSimMap(&sim, STACK_BASE, stack, STACK_SIZE, true);
+	sim.r[13] = STACK_BASE + STACK_SIZE;
+	for(u32 i = 4; i < 12; i++) sim.r[i] = 0xDEAD0000u + i;
+
+	const u32 args[3] = {IN_BASE + inAlign, OUT_BASE + outAlign, outSize};
+	if(!armSimCall(&sim, CODE_BASE, args, 3, 64ull * outSize + 1000))
+	{
+		printf("Fault: %s\n", sim.fault);
+		return false;
+	}
+
+	// r4-r11 and sp are callee saved
+	for(u32 i = 4; i < 12; i++)
+	{
+		if(sim.r[i] != 0xDEAD0000u + i)
+		{
+			printf("r%u not preserved\n", i);
+			return false;
+		}
+	}
+	if(sim.r[13] != STACK_BASE + STACK_SIZE)
+	{
+		puts("sp not preserved");
+		return false;
+	}
+
+	return true;
+}
+
+int main(int argc, char *argv[])
+{
+	if(argc != 2 || !loadCode(argv[1]))
+	{
+		fprintf(stderr, "Usage: %s lz4.bin\n", argv[0]);
+		return EXIT_FAILURE;
+	}
+
+	u8 *const data = (u8*)malloc(MAX_SIZE);
+	u8 *const comp = (u8*)malloc(LZ4_BOUND(MAX_SIZE));
+	if(!data || !comp) return EXIT_FAILURE;
+
+	u32 errors = 0;
+	for(u32 it = 0; it < ITERATIONS; it++)
+	{
+		const u32 size = (it < 64 ? it + 1 : 1u + rng() % MAX_SIZE);
+		fillRandom(data, size);
+		const u32 compSize = lz4Compress(data, size, comp);
+
+		// exact sizes so any access past the buffers faults
+		const u32 inAlign = it & 3;
+		const u32 outAlign = it>>2 & 3;
+		u8 *const in = (u8*)malloc(compSize);
+		u8 *const out = (u8*)malloc(size);
+		memcpy(in, comp, compSize);
+		memset(out, 0xA5, size);
+
+		if(!runAsm(in, compSize, inAlign, out, size, outAlign) || memcmp(out, data, size))
+		{
+			printf("Mismatch: size 0x%X, in +%u, out +%u\n", size, inAlign, outAlign);
+			errors++;
+		}
+
+		free(out);
+		free(in);
+	}
+
+	// every word of the function is either executed or literal pool data
+	u32 unused = 0;
+	for(u32 i = 0; i < codeSize / 4; i++)
+	{
+		if(!hits[i] && !loads[i])
+		{
+			printf("Instruction at +0x%X never executed\n", i * 4);
+			unused++;
+		}
+	}
+
+	free(comp);
+	free(data);
+
+	printf("%u streams, %u of %u words covered, %u errors\n", ITERATIONS,
+	       codeSize / 4 - unused, codeSize / 4, errors);
+
+	return (errors || unused ? EXIT_FAILURE : EXIT_SUCCESS);
+}
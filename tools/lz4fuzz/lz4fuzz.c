@@ -0,0 +1,181 @@
+/*
+ *   This file is part of fastboot 3DS
+ *   Copyright (C) 2017 derrek, profi200
+ *
+ *   This program is free software: you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License as published by
+ *   the Free Software Foundation, either version 3 of the License, or
+ *   (at your option) any later version.
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/*
+ * Host fuzz test for lz4DecompressBounded(). Random data is compressed
+ * with the splatool LZ4 encoder, then decoded unmodified, truncated and
+ * with flipped bits. Every result must match a byte-wise reference
+ * decoder. Buffers are allocated with their exact size so ASan catches
+ * any read or write past them.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "types.h"
+#include "arm11/lz4.h"
+#include "lz11test.h"
+#include "lzenc.h"
+
+
+#define ITERATIONS  (2000u)
+
+
+
+// Byte-wise reference with the same semantics as lz4DecompressBounded().
+static bool refDecompress(const u8 *in, u32 inSize, u8 *out, u32 outSize)
+{
+	u32 inPos = 0, outPos = 0;
+	while(inPos < inSize)
+	{
+		const u32 token = in[inPos++];
+
+		u32 len = token>>4, b;
+		if(len == 15)
+		{
+			do
+			{
+				if(inPos >= inSize) return false;
+				b = in[inPos++];
+				len += b;
+			} while(b == 255);
+		}
+		for(u32 i = 0; i < len; i++)
+		{
+			if(inPos >= inSize || outPos >= outSize) return false;
+			out[outPos++] = in[inPos++];
+		}
+
+		if(inPos == inSize || outPos == outSize) break;
+
+		if(inSize - inPos < 2) return false;
+		const u32 offset = in[inPos] | (u32)in[inPos + 1]<<8;
+		inPos += 2;
+
+		len = token & 0xFu;
+		if(len == 15)
+		{
+			do
+			{
+				if(inPos >= inSize) return false;
+				b = in[inPos++];
+				len += b;
+			} while(b == 255);
+		}
+		len += 4;
+
+		if(!offset || offset > outPos) return false;
+		for(u32 i = 0; i < len; i++, outPos++)
+		{
+			if(outPos >= outSize) return false;
+			out[outPos] = out[outPos - offset];
+		}
+	}
+
+	return outPos == outSize;
+}
+
+// Returns false if the two decoders disagree.
+static bool check(const u8 *in, u32 inSize, u32 outSize)
+{
+	u8 *const exact = (u8*)malloc(inSize ? inSize : 1);
+	u8 *const out = (u8*)malloc(outSize);
+	u8 *const ref = (u8*)malloc(outSize);
+	if(!exact || !out || !ref)
+	{
+		fputs("Out of memory\n", stderr);
+		exit(EXIT_FAILURE);
+	}
+	memcpy(exact, in, inSize);
+
+	const bool res = lz4DecompressBounded(exact, inSize, out, outSize);
+	const bool refRes = refDecompress(exact, inSize, ref, outSize);
+	const bool ok = (res == refRes) && (!res || !memcmp(out, ref, outSize));
+
+	free(ref);
+	free(out);
+	free(exact);
+
+	return ok;
+}
+
+int main(void)
+{
+	u8 *const data = (u8*)malloc(MAX_SIZE);
+	u8 *const comp = (u8*)malloc(LZ4_BOUND(MAX_SIZE) + 1);
+	u8 *const dec = (u8*)malloc(MAX_SIZE);
+	if(!data || !comp || !dec) return EXIT_FAILURE;
+
+	u32 errors = 0, roundTrips = 0, mutations = 0;
+	for(u32 it = 0; it < ITERATIONS; it++)
+	{
+		// all the small sizes first for the block end rules
+		const u32 size = (it < 64 ? it + 1 : 1u + rng() % MAX_SIZE);
+		fillRandom(data, size);
+		const u32 compSize = lz4Compress(data, size, comp);
+		if(!compSize) return EXIT_FAILURE;
+
+		// round trip, the reference must agree too
+		u8 *const exact = (u8*)malloc(compSize);
+		memcpy(exact, comp, compSize);
+		if(!lz4DecompressBounded(exact, compSize, dec, size) || memcmp(dec, data, size) ||
+		   !refDecompress(exact, compSize, dec, size) || memcmp(dec, data, size))
+		{
+			printf("Round trip failed: size 0x%X\n", size);
+			errors++;
+		}
+		free(exact);
+		roundTrips++;
+
+		// data after the block is ignored (animated splash frames)
+		comp[compSize] = rng();
+		if(!lz4DecompressBounded(comp, compSize + 1, dec, size) || memcmp(dec, data, size)) errors++;
+
+		// truncated input and a larger output than encoded
+		if(!check(comp, rng() % compSize, size)) errors++;
+		if(!check(comp, compSize, size + 1u + rng() % 64u)) errors++;
+
+		// flipped bits
+		for(u32 i = 0; i < 8; i++)
+		{
+			const u32 pos = rng() % compSize;
+			const u8 bit = 1u<<(rng() % 8);
+			comp[pos] ^= bit;
+			if(!check(comp, compSize, size))
+			{
+				printf("Mismatch: size 0x%X, byte 0x%X\n", size, pos);
+				errors++;
+			}
+			comp[pos] ^= bit;
+			mutations++;
+		}
+
+		// random garbage
+		fillRandom(comp, compSize);
+		if(!check(comp, compSize, size)) errors++;
+		mutations += 3;
+	}
+
+	free(dec);
+	free(comp);
+	free(data);
+
+	printf("%u round trips, %u corrupted streams, %u errors\n", roundTrips, mutations, errors);
+
+	return (errors ? EXIT_FAILURE : EXIT_SUCCESS);
+}
@@ -0,0 +1,185 @@
+/*
+ *   This file is part of fastboot 3DS
+ *   Copyright (C) 2017 derrek, profi200
+ *
+ *   This program is free software: you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License as published by
+ *   the Free Software Foundation, either version 3 of the License, or
+ *   (at your option) any later version.
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/*
+ * LZ11 vs. LZ4 comparison for splash assets. Every input (raw pixel data,
+ * for example from "splatool raw") is compressed with the splatool
+ * encoders and decoded with
+ *  - the C bounded decoders on this host (MB/s) and
+ *  - the ARM11 assembly decoders in armsim (instructions per output byte).
+ * The instruction count is not a cycle count. It ignores caches and
+ * memory wait states but is the same for both decoders so they can be
+ * compared. Without inputs the fuzz test data is used.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include "types.h"
+#include "arm11/lz11.h"
+#include "arm11/lz4.h"
+#include "armsim.h"
+#include "lz11test.h"
+#include "lzenc.h"
+
+
+#define CODE_BASE     (0x00001000u)
+#define IN_BASE       (0x00100000u)
+#define OUT_BASE      (0x00400000u)
+#define STACK_BASE    (0x00F00000u)
+#define STACK_SIZE    (0x1000u)
+#define MAX_CODE      (0x1000u)
+#define MAX_INPUT     (0x100000u)
+#define CORPUS_FILES  (64u)
+#define MIN_BENCH_NS  (200000000ull)
+
+
+typedef struct
+{
+	const char *name;
+	u32 (*compress)(const u8*, u32, u8*);
+	bool (*decompress)(const void*, u32, void*, u32);
+	u8 code[MAX_CODE];
+	u32 codeSize;
+	u64 inBytes, outBytes, ns, steps;
+} Codec;
+
+static Codec codecs[2] =
+{
+	{"lz11", lz11Compress, lz11DecompressBounded, {0}, 0, 0, 0, 0, 0},
+	{"lz4",  lz4Compress,  lz4DecompressBounded,  {0}, 0, 0, 0, 0, 0}
+};
+static u8 stack[STACK_SIZE];
+
+
+
+static u64 nowNs(void)
+{
+	struct timespec ts;
+	clock_gettime(CLOCK_MONOTONIC, &ts);
+	return (u64)ts.tv_sec * 1000000000u + ts.tv_nsec;
+}
+
+static bool loadFile(const char *const path, u8 *buf, u32 maxSize, u32 *size)
+{
+	FILE *const f = fopen(path, "rb");
+	if(!f) return false;
+	*size = fread(buf, 1, maxSize, f);
+	const bool ok = !ferror(f) && fgetc(f) == EOF; // Fail if too big
+	fclose(f);
+
+	return ok && *size;
+}
+
+static bool benchOne(Codec *codec, const u8 *data, u32 size, u8 *comp, u8 *out)
+{
+	const u32 compSize = codec->compress(data, size, comp);
+	if(!compSize) return false;
+
+	// host C decoder, repeated until the time is measurable
+	u32 runs = 0;
+	const u64 start = nowNs();
+	u64 ns;
+	do
+	{
+		if(!codec->decompress(comp, compSize, out, size) || memcmp(out, data, size)) return false;
+		runs++;
+	} while((ns = nowNs() - start) < MIN_BENCH_NS / CORPUS_FILES);
+
+	// ARM11 assembly decoder
+	ArmSim sim;
+	memset(&sim, 0, sizeof(sim));
+	armSimMap(&sim, CODE_BASE, codec->code, codec->codeSize, false);
+	armSimMap(&sim, IN_BASE, comp, compSize, false);
+	armSimMap(&sim, OUT_BASE, out, size, true);
+	armSimMap(&sim, STACK_BASE, stack, STACK_SIZE, true);
+	sim.r[13] = STACK_BASE + STACK_SIZE;
+	memset(out, 0, size);
+	const u32 args[3] = {IN_BASE, OUT_BASE, size};
+	if(!armSimCall(&sim, CODE_BASE, args, 3, 64ull * size + 1000) || memcmp(out, data, size))
+	{
+		printf("%s: assembly decoder failed %s\n", codec->name, sim.fault);
+		return false;
+	}
+
+	codec->inBytes += size;
+	codec->outBytes += compSize;
+	codec->ns += ns / runs;
+	codec->steps += sim.steps;
+
+	return true;
+}
+
+int main(int argc, char *argv[])
+{
+	if(argc < 3 || !loadFile(argv[1], codecs[0].code, MAX_CODE, &codecs[0].codeSize) ||
+	   !loadFile(argv[2], codecs[1].code, MAX_CODE, &codecs[1].codeSize))
+	{
+		fprintf(stderr, "Usage: %s lz11.bin lz4.bin [raw data files...]\n", argv[0]);
+		return EXIT_FAILURE;
+	}
+
+	u8 *const data = (u8*)malloc(MAX_INPUT);
+	u8 *const comp = (u8*)malloc(LZ4_BOUND(MAX_INPUT) + LZ11_BOUND(MAX_INPUT));
+	u8 *const out = (u8*)malloc(MAX_INPUT);
+	if(!data || !comp || !out) return EXIT_FAILURE;
+
+	const u32 files = (argc > 3 ? (u32)argc - 3 : CORPUS_FILES);
+	for(u32 i = 0; i < files; i++)
+	{
+		u32 size;
+		if(argc > 3)
+		{
+			if(!loadFile(argv[3 + i], data, MAX_INPUT, &size))
+			{
+				fprintf(stderr, "Can't read '%s' (max %u bytes)\n", argv[3 + i], MAX_INPUT);
+				return EXIT_FAILURE;
+			}
+		}
+		else
+		{
+			size = 1u + rng() % MAX_SIZE;
+			fillRandom(data, size);
+		}
+
+		for(u32 c = 0; c < 2; c++)
+		{
+			if(!benchOne(&codecs[c], data, size, comp, out))
+			{
+				printf("%s: round trip failed\n", codecs[c].name);
+				return EXIT_FAILURE;
+			}
+		}
+	}
+
+	printf("%u input(s), %llu bytes\n", files, (unsigned long long)codecs[0].inBytes);
+	for(u32 c = 0; c < 2; c++)
+	{
+		const Codec *const codec = &codecs[c];
+		printf("%-5s size %6.1f%%   host C %8.1f MB/s   ARM11 asm %5.2f instructions/byte\n", codec->name,
+		       100.0 * codec->outBytes / codec->inBytes, 1000.0 * codec->inBytes / codec->ns,
+		       (double)codec->steps / codec->inBytes);
+	}
+
+	free(out);
+	free(comp);
+	free(data);
+
+	return EXIT_SUCCESS;
+}
@@ -0,0 +1,209 @@
+/*
+ *   This file is part of fastboot 3DS
+ *   Copyright (C) 2017 derrek, profi200
+ *
+ *   This program is free software: you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License as published by
+ *   the Free Software Foundation, either version 3 of the License, or
+ *   (at your option) any later version.
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <stdlib.h>
+#include "lzenc.h"
+
+
+#define HASH_BITS   (15u)
+#define MAX_CHAIN   (256u)  // Candidates checked per position
+
+
+// Hash chains over all 3 byte prefixes seen so far
+typedef struct
+{
+	const u8 *in;
+	u32 size;
+	u32 minLen;
+	u32 maxLen;
+	u32 window;
+	s32 *head;
+	s32 *prev;
+} Matcher;
+
+
+
+static bool matcherInit(Matcher *m, const u8 *in, u32 size, u32 minLen, u32 maxLen, u32 window)
+{
+	*m = (Matcher){in, size, minLen, maxLen, window, NULL, NULL};
+	m->head = (s32*)malloc(sizeof(s32)<<HASH_BITS);
+	m->prev = (s32*)malloc(sizeof(s32) * (size ? size : 1));
+	if(!m->head || !m->prev)
+	{
+		free(m->prev);
+		free(m->head);
+		return false;
+	}
+
+	for(u32 i = 0; i < 1u<<HASH_BITS; i++) m->head[i] = -1;
+
+	return true;
+}
+
+static void matcherFree(Matcher *m)
+{
+	free(m->prev);
+	free(m->head);
+}
+
+static u32 hash3(const u8 *p)
+{
+	return ((u32)p[0]<<16 | (u32)p[1]<<8 | p[2]) * 2654435761u>>(32 - HASH_BITS);
+}
+
+// Must be called for every position in order
+static void matcherInsert(Matcher *m, u32 pos)
+{
+	if(pos + 3 > m->size) return;
+
+	const u32 h = hash3(&m->in[pos]);
+	m->prev[pos] = m->head[h];
+	m->head[h] = (s32)pos;
+}
+
+// Returns the longest match at pos ending at or before limit
+static u32 matcherFind(const Matcher *m, u32 pos, u32 limit, u32 *disp)
+{
+	u32 maxLen = limit - pos;
+	if(maxLen > m->maxLen) maxLen = m->maxLen;
+	if(limit <= pos || maxLen < m->minLen) return 0;
+
+	const u8 *const in = m->in;
+	u32 best = 0;
+	s32 cand = m->head[hash3(&in[pos])];
+	for(u32 depth = 0; cand >= 0 && pos - (u32)cand <= m->window && depth < MAX_CHAIN; depth++)
+	{
+		u32 len = 0;
+		while(len < maxLen && in[cand + len] == in[pos + len]) len++;
+		if(len > best)
+		{
+			best = len;
+			*disp = pos - (u32)cand;
+			if(best == maxLen) break;
+		}
+		cand = m->prev[cand];
+	}
+
+	return (best >= m->minLen ? best : 0);
+}
+
+u32 lz11Compress(const u8 *in, u32 size, u8 *out)
+{
+	Matcher m;
+	if(!matcherInit(&m, in, size, 3, 0x10110, 0x1000)) return 0;
+
+	u32 inPos = 0, outPos = 0;
+	while(inPos < size)
+	{
+		const u32 flagsPos = outPos++;
+		u8 flags = 0;
+		for(u32 i = 0; i < 8 && inPos < size; i++)
+		{
+			u32 disp = 0;
+			const u32 len = matcherFind(&m, inPos, size, &disp);
+			if(!len)
+			{
+				matcherInsert(&m, inPos);
+				out[outPos++] = in[inPos++];
+				continue;
+			}
+
+			flags |= 0x80u>>i;
+			const u32 d = disp - 1;
+			if(len <= 0x10)
+			{
+				out[outPos++] = (len - 1)<<4 | d>>8;
+			}
+			else if(len <= 0x110)
+			{
+				const u32 l = len - 0x11;
+				out[outPos++] = l>>4;
+				out[outPos++] = (l & 0xFu)<<4 | d>>8;
+			}
+			else
+			{
+				const u32 l = len - 0x111;
+				out[outPos++] = 1u<<4 | l>>12;
+				out[outPos++] = l>>4;
+				out[outPos++] = (l & 0xFu)<<4 | d>>8;
+			}
+			out[outPos++] = d;
+
+			for(const u32 end = inPos + len; inPos < end; inPos++) matcherInsert(&m, inPos);
+		}
+		out[flagsPos] = flags;
+	}
+
+	matcherFree(&m);
+
+	return outPos;
+}
+
+static u32 lz4WriteLength(u8 *out, u32 outPos, u32 len)
+{
+	for(; len >= 255; len -= 255) out[outPos++] = 255;
+	out[outPos++] = len;
+
+	return outPos;
+}
+
+// A sequence with matchLen 0 is the literals only last sequence
+static u32 lz4WriteSequence(u8 *out, u32 outPos, const u8 *lit, u32 litLen, u32 matchLen, u32 offset)
+{
+	const u32 matchCode = (matchLen ? matchLen - 4 : 0);
+	out[outPos++] = (litLen < 15 ? litLen : 15)<<4 | (matchCode < 15 ? matchCode : 15);
+	if(litLen >= 15) outPos = lz4WriteLength(out, outPos, litLen - 15);
+	for(u32 i = 0; i < litLen; i++) out[outPos++] = lit[i];
+	if(!matchLen) return outPos;
+
+	out[outPos++] = offset;
+	out[outPos++] = offset>>8;
+	if(matchCode >= 15) outPos = lz4WriteLength(out, outPos, matchCode - 15);
+
+	return outPos;
+}
+
+u32 lz4Compress(const u8 *in, u32 size, u8 *out)
+{
+	Matcher m;
+	if(!matcherInit(&m, in, size, 4, 0xFFFFFFFFu, 0xFFFF)) return 0;
+
+	// Block end rules: matches end before the last 5 bytes
+	// and none starts within the last 12 bytes.
+	const u32 lenLimit = (size > 5 ? size - 5 : 0);
+	u32 inPos = 0, anchor = 0, outPos = 0;
+	while(inPos + 12 <= size)
+	{
+		u32 offset = 0;
+		const u32 len = matcherFind(&m, inPos, lenLimit, &offset);
+		if(!len)
+		{
+			matcherInsert(&m, inPos++);
+			continue;
+		}
+
+		outPos = lz4WriteSequence(out, outPos, &in[anchor], inPos - anchor, len, offset);
+		for(const u32 end = inPos + len; inPos < end; inPos++) matcherInsert(&m, inPos);
+		anchor = inPos;
+	}
+	outPos = lz4WriteSequence(out, outPos, &in[anchor], size - anchor, 0, 0);
+
+	matcherFree(&m);
+
+	return outPos;
+}
@@ -0,0 +1,55 @@
+#pragma once
+
+/*
+ *   This file is part of fastboot 3DS
+ *   Copyright (C) 2017 derrek, profi200
+ *
+ *   This program is free software: you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License as published by
+ *   the Free Software Foundation, either version 3 of the License, or
+ *   (at your option) any later version.
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+// Host LZ11 and LZ4 block encoders for splash assets.
+
+#include "types.h"
+
+
+// Worst case output sizes
+#define LZ11_BOUND(size)  ((size) + (size) / 8 + 1)
+#define LZ4_BOUND(size)   ((size) + (size) / 255 + 16)
+
+
+
+/**
+ * @brief      Compresses data to a raw LZ11 stream (no 0x11 header) as read by
+ *             lz11Decompress() and lz11DecompressBounded().
+ *
+ * @param[in]  in    The input data.
+ * @param[in]  size  The input size.
+ * @param      out   The output buffer. Must hold LZ11_BOUND(size) bytes.
+ *
+ * @return     The compressed size or 0 if out of memory.
+ */
+u32 lz11Compress(const u8 *in, u32 size, u8 *out);
+
+/**
+ * @brief      Compresses data to a raw LZ4 block as read by lz4Decompress() and
+ *             lz4DecompressBounded(). Follows the block format end rules
+ *             (last 5 bytes are literals, no match starts in the last 12 bytes).
+ *
+ * @param[in]  in    The input data.
+ * @param[in]  size  The input size.
+ * @param      out   The output buffer. Must hold LZ4_BOUND(size) bytes.
+ *
+ * @return     The compressed size or 0 if out of memory.
+ */
+u32 lz4Compress(const u8 *in, u32 size, u8 *out);
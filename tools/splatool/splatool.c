@@ -0,0 +1,584 @@
+/*
+ *   This file is part of fastboot 3DS
+ *   Copyright (C) 2017 derrek, profi200
+ *
+ *   This program is free software: you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License as published by
+ *   the Free Software Foundation, either version 3 of the License, or
+ *   (at your option) any later version.
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/*
+ * Host tool for splash assets (SPLA files as read by drawSplashscreen()).
+ * Inputs are SPLA files from splashtool (RGB565, rotated, raw or LZ11/LZ4
+ * compressed) or PNGs which are converted the same way.
+ *
+ *   splatool pack [-c none|lz11|lz4] <in.spla|in.png> <out.spla>
+ *       Re-encodes an image with the given compression (default lz11).
+ *   splatool anim [-c lz11|lz4] <in.anim> <out.spla>
+ *       Builds an animated splash (FLAG_ANIMATED) from a frame list.
+ *   splatool raw <in.spla|in.png> <out.bin>
+ *       Writes the decoded rotated RGB565 pixels. For animated splashes
+ *       every frame is written as a full image.
+ *
+ * An .anim file lists one frame per line as "<image> <duration>" with the
+ * duration in VBlanks. Image paths are relative to the .anim file. An
+ * optional "loops <n>" line sets the play count (0 = forever, the default).
+ * Empty lines and lines starting with '#' are ignored.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <ctype.h>
+#include <png.h>
+#include "types.h"
+#include "arm11/menu/splash.h"
+#include "arm11/lz11.h"
+#include "arm11/lz4.h"
+#include "lzenc.h"
+
+
+#define MAX_WIDTH   (400u)
+#define MAX_HEIGHT  (240u)
+#define MAX_FRAMES  (1024u)
+#define MAX_LINE    (1024u)
+
+
+typedef enum
+{
+	CODEC_NONE = 0,
+	CODEC_LZ11 = 1,
+	CODEC_LZ4  = 2
+} Codec;
+
+// Decoded image. Rotated RGB565 columns, bottom pixel first.
+typedef struct
+{
+	u32 width;
+	u32 height;
+	u8 *pixels;
+} Image;
+
+
+
+static bool readFile(const char *const path, u8 **data, u32 *size)
+{
+	FILE *const f = fopen(path, "rb");
+	if(!f) return false;
+
+	bool ok = false;
+	if(fseek(f, 0, SEEK_END) == 0)
+	{
+		const long len = ftell(f);
+		if(len >= 0 && fseek(f, 0, SEEK_SET) == 0 && (*data = (u8*)malloc(len ? len : 1)))
+		{
+			*size = (u32)len;
+			ok = fread(*data, 1, len, f) == (size_t)len;
+			if(!ok) free(*data);
+		}
+	}
+	fclose(f);
+
+	return ok;
+}
+
+static bool writeFile(const char *const path, const void *data, u32 size)
+{
+	FILE *const f = fopen(path, "wb");
+	if(!f) return false;
+
+	const bool ok = fwrite(data, 1, size, f) == size;
+	return (fclose(f) == 0) && ok;
+}
+
+static bool loadPng(const char *const path, Image *img)
+{
+	png_image png;
+	memset(&png, 0, sizeof(png));
+	png.version = PNG_IMAGE_VERSION;
+	if(!png_image_begin_read_from_file(&png, path)) return false;
+
+	png.format = PNG_FORMAT_RGB;
+	const u32 width = png.width, height = png.height;
+	u8 *const rgb = (u8*)malloc(PNG_IMAGE_SIZE(png));
+	if(!rgb || !png_image_finish_read(&png, NULL, rgb, 0, NULL))
+	{
+		free(rgb);
+		png_image_free(&png);
+		return false;
+	}
+
+	img->width = width;
+	img->height = height;
+	img->pixels = (u8*)malloc(width * height * 2);
+	if(!img->pixels)
+	{
+		free(rgb);
+		return false;
+	}
+
+	u16 *const out = (u16*)img->pixels;
+	for(u32 y = 0; y < height; y++)
+	{
+		for(u32 x = 0; x < width; x++)
+		{
+			const u8 *const p = &rgb[(y * width + x) * 3];
+			out[x * height + (height - 1 - y)] = (p[0] & 0xF8u)<<8 | (p[1] & 0xFCu)<<3 | p[2]>>3;
+		}
+	}
+	free(rgb);
+
+	return true;
+}
+
+// Decodes one compressed or raw image of size bytes
+static bool decodePixels(const u8 *src, u32 srcSize, u32 flags, u8 *out, u32 size)
+{
+	if(!(flags & FLAG_COMPRESSED))
+	{
+		if(srcSize < size) return false;
+		memcpy(out, src, size);
+		return true;
+	}
+
+	return (flags & FLAG_LZ4 ? lz4DecompressBounded : lz11DecompressBounded)(src, srcSize, out, size);
+}
+
+static bool validSplaHeader(const SplashHeader *const header, u32 size)
+{
+	if(size < sizeof(SplashHeader) || memcmp(&header->magic, "SPLA", 4)) return false;
+	if(!header->width || header->width > MAX_WIDTH || !header->height || header->height > MAX_HEIGHT)
+		return false;
+
+	const u32 flags = header->flags;
+	return ((flags & FORMAT_INVALID) == FORMAT_RGB565) && (flags & FLAG_ROTATED) && !(flags & FLAG_SWAPPED);
+}
+
+static bool validAnimHeader(const SplashHeader *const header, const SplashAnimHeader *const animHeader, u32 size)
+{
+	if(size < sizeof(SplashHeader) + sizeof(SplashAnimHeader)) return false;
+	if(!(header->flags & FLAG_COMPRESSED) || !animHeader->numFrames) return false;
+	if(size < sizeof(SplashHeader) + sizeof(SplashAnimHeader) + animHeader->numFrames * sizeof(SplashFrame))
+		return false;
+	if(animHeader->frames[0].x != 0 || animHeader->frames[0].width != header->width) return false;
+
+	for(u32 i = 0; i < animHeader->numFrames; i++)
+	{
+		const SplashFrame *const frame = &animHeader->frames[i];
+		if(!frame->width || frame->x + frame->width > header->width) return false;
+		if(frame->offset >= size) return false;
+	}
+
+	return true;
+}
+
+// Plays an animated splash once and returns every frame as a full image
+// in a malloc()ed buffer. *numFrames is set to the frame count.
+static u8* decodeAnim(const u8 *data, u32 size, u32 *numFrames)
+{
+	const SplashHeader *const header = (const SplashHeader*)data;
+	const SplashAnimHeader *const animHeader = (const SplashAnimHeader*)(data + sizeof(SplashHeader));
+	if(!validSplaHeader(header, size) || !(header->flags & FLAG_ANIMATED) || !validAnimHeader(header, animHeader, size))
+		return NULL;
+
+	const u32 height = header->height;
+	const u32 imgSize = header->width * height * 2;
+	u8 *const out = (u8*)malloc(imgSize * animHeader->numFrames);
+	if(!out) return NULL;
+
+	for(u32 i = 0; i < animHeader->numFrames; i++)
+	{
+		const SplashFrame *const frame = &animHeader->frames[i];
+		u8 *const img = out + i * imgSize;
+		if(i) memcpy(img, img - imgSize, imgSize);
+		if(!decodePixels(data + frame->offset, size - frame->offset, header->flags,
+		                 img + frame->x * height * 2, frame->width * height * 2))
+		{
+			free(out);
+			return NULL;
+		}
+	}
+	*numFrames = animHeader->numFrames;
+
+	return out;
+}
+
+static bool loadSpla(const u8 *data, u32 size, Image *img)
+{
+	const SplashHeader *const header = (const SplashHeader*)data;
+	if(!validSplaHeader(header, size)) return false;
+	if(header->flags & FLAG_ANIMATED)
+	{
+		fputs("Animated splashes can't be used as frames\n", stderr);
+		return false;
+	}
+
+	img->width = header->width;
+	img->height = header->height;
+	const u32 imgSize = img->width * img->height * 2;
+	img->pixels = (u8*)malloc(imgSize);
+	if(!img->pixels) return false;
+
+	if(!decodePixels(data + sizeof(SplashHeader), size - sizeof(SplashHeader), header->flags, img->pixels, imgSize))
+	{
+		free(img->pixels);
+		return false;
+	}
+
+	return true;
+}
+
+static bool loadImage(const char *const path, Image *img)
+{
+	u8 *data;
+	u32 size;
+	if(!readFile(path, &data, &size))
+	{
+		fprintf(stderr, "Can't read '%s'\n", path);
+		return false;
+	}
+
+	static const u8 pngSig[8] = {0x89, 'P', 'N', 'G', '\r', '\n', 0x1A, '\n'};
+	bool ok;
+	if(size >= 8 && !memcmp(data, pngSig, 8))
+	{
+		ok = loadPng(path, img);
+		if(ok && (!img->width || img->width > MAX_WIDTH || !img->height || img->height > MAX_HEIGHT))
+		{
+			free(img->pixels);
+			ok = false;
+		}
+	}
+	else ok = loadSpla(data, size, img);
+	free(data);
+
+	if(!ok) fprintf(stderr, "'%s' is not a valid RGB565 rotated splash or PNG up to %ux%u\n", path, MAX_WIDTH, MAX_HEIGHT);
+
+	return ok;
+}
+
+// Returns a malloc()ed buffer with the encoded data or NULL
+static u8* encodePixels(const u8 *pixels, u32 size, Codec codec, u32 *outSize)
+{
+	u8 *const out = (u8*)malloc(LZ4_BOUND(size) > LZ11_BOUND(size) ? LZ4_BOUND(size) : LZ11_BOUND(size));
+	if(!out) return NULL;
+
+	switch(codec)
+	{
+		case CODEC_LZ11:
+			*outSize = lz11Compress(pixels, size, out);
+			break;
+		case CODEC_LZ4:
+			*outSize = lz4Compress(pixels, size, out);
+			break;
+		default:
+			memcpy(out, pixels, size);
+			*outSize = size;
+	}
+	if(!*outSize)
+	{
+		free(out);
+		return NULL;
+	}
+
+	return out;
+}
+
+static u32 codecFlags(Codec codec)
+{
+	return (codec == CODEC_NONE ? 0 : FLAG_COMPRESSED) | (codec == CODEC_LZ4 ? FLAG_LZ4 : 0);
+}
+
+static bool parseCodec(const char *const name, Codec *codec)
+{
+	if(!strcmp(name, "none")) *codec = CODEC_NONE;
+	else if(!strcmp(name, "lz11")) *codec = CODEC_LZ11;
+	else if(!strcmp(name, "lz4")) *codec = CODEC_LZ4;
+	else return false;
+
+	return true;
+}
+
+static int cmdPack(int argc, char *argv[])
+{
+	Codec codec = CODEC_LZ11;
+	int i = 0;
+	if(argc >= 2 && !strcmp(argv[0], "-c"))
+	{
+		if(!parseCodec(argv[1], &codec)) return EXIT_FAILURE;
+		i = 2;
+	}
+	if(argc - i != 2) return EXIT_FAILURE;
+
+	Image img;
+	if(!loadImage(argv[i], &img)) return EXIT_FAILURE;
+
+	const u32 imgSize = img.width * img.height * 2;
+	u32 encSize;
+	u8 *const enc = encodePixels(img.pixels, imgSize, codec, &encSize);
+	u8 *const out = (u8*)malloc(sizeof(SplashHeader) + (enc ? encSize : 0));
+	bool ok = false;
+	if(enc && out)
+	{
+		SplashHeader header;
+		memcpy(&header.magic, "SPLA", 4);
+		header.width = img.width;
+		header.height = img.height;
+		header.flags = FORMAT_RGB565 | FLAG_ROTATED | codecFlags(codec);
+		memcpy(out, &header, sizeof(header));
+		memcpy(out + sizeof(header), enc, encSize);
+		ok = writeFile(argv[i + 1], out, sizeof(header) + encSize);
+	}
+	if(!ok) fprintf(stderr, "Can't write '%s'\n", argv[i + 1]);
+
+	free(out);
+	free(enc);
+	free(img.pixels);
+
+	return (ok ? EXIT_SUCCESS : EXIT_FAILURE);
+}
+
+typedef struct
+{
+	Image img;
+	u32 duration;
+} AnimFrame;
+
+// Parses an .anim frame list and loads all frames. Returns the frame count or 0.
+static u32 loadAnimList(const char *const path, AnimFrame *frames, u32 *loops)
+{
+	FILE *const f = fopen(path, "r");
+	if(!f)
+	{
+		fprintf(stderr, "Can't read '%s'\n", path);
+		return 0;
+	}
+
+	// frame paths are relative to the list
+	const char *const slash = strrchr(path, '/');
+	const int dirLen = (slash ? (int)(slash - path + 1) : 0);
+
+	char line[MAX_LINE];
+	u32 numFrames = 0, lineNum = 0;
+	bool ok = true;
+	while(ok && fgets(line, sizeof(line), f))
+	{
+		lineNum++;
+		char *p = line;
+		while(isspace((unsigned char)*p)) p++;
+		if(*p == '\0' || *p == '#') continue;
+
+		char name[MAX_LINE];
+		unsigned long val;
+		char end;
+		if(sscanf(p, "loops %lu %c", &val, &end) == 1 && val <= 0xFFFFu) *loops = val;
+		else if(sscanf(p, "%1023s %lu %c", name, &val, &end) == 2 && val && val <= 0xFFFFu && numFrames < MAX_FRAMES)
+		{
+			char framePath[MAX_LINE * 2];
+			if(name[0] == '/') snprintf(framePath, sizeof(framePath), "%s", name);
+			else snprintf(framePath, sizeof(framePath), "%.*s%s", dirLen, path, name);
+
+			AnimFrame *const frame = &frames[numFrames];
+			ok = loadImage(framePath, &frame->img);
+			if(!ok) break;
+			frame->duration = val;
+			numFrames++;
+
+			if(frame->img.width != frames[0].img.width || frame->img.height != frames[0].img.height)
+			{
+				fprintf(stderr, "'%s' doesn't have the size of the first frame\n", framePath);
+				ok = false;
+			}
+		}
+		else
+		{
+			fprintf(stderr, "%s:%u: expected \"<image> <duration 1-65535>\" or \"loops <n>\"\n", path, lineNum);
+			ok = false;
+		}
+	}
+	if(ok && ferror(f))
+	{
+		fprintf(stderr, "Can't read '%s'\n", path);
+		ok = false;
+	}
+	fclose(f);
+
+	if(ok && !numFrames) fprintf(stderr, "'%s' has no frames\n", path);
+	if(!ok)
+	{
+		for(u32 i = 0; i < numFrames; i++) free(frames[i].img.pixels);
+		numFrames = 0;
+	}
+
+	return numFrames;
+}
+
+static int cmdAnim(int argc, char *argv[])
+{
+	Codec codec = CODEC_LZ11;
+	int i = 0;
+	if(argc >= 2 && !strcmp(argv[0], "-c"))
+	{
+		if(!parseCodec(argv[1], &codec)) return EXIT_FAILURE;
+		if(codec == CODEC_NONE)
+		{
+			fputs("Animated splashes must be compressed\n", stderr);
+			return EXIT_FAILURE;
+		}
+		i = 2;
+	}
+	if(argc - i != 2) return EXIT_FAILURE;
+
+	AnimFrame *const frames = (AnimFrame*)malloc(MAX_FRAMES * sizeof(AnimFrame));
+	if(!frames) return EXIT_FAILURE;
+	u32 loops = 0;
+	const u32 numFrames = loadAnimList(argv[i], frames, &loops);
+	if(!numFrames)
+	{
+		free(frames);
+		return EXIT_FAILURE;
+	}
+
+	const u32 width = frames[0].img.width, height = frames[0].img.height;
+	const u32 colSize = height * 2;
+	const u32 tableSize = sizeof(SplashHeader) + sizeof(SplashAnimHeader) + numFrames * sizeof(SplashFrame);
+	u32 outSize = tableSize;
+	u8 *out = (u8*)calloc(1, outSize);
+	SplashFrame *const table = (SplashFrame*)calloc(numFrames, sizeof(SplashFrame));
+	u32 outFrames = 0;
+	bool ok = out && table;
+	for(u32 f = 0; ok && f < numFrames; f++)
+	{
+		const u8 *const cur = frames[f].img.pixels;
+
+		// Later frames only hold the columns that changed since the previous one
+		u32 first = 0, last = width;
+		if(f)
+		{
+			const u8 *const prev = frames[f - 1].img.pixels;
+			while(first < width && !memcmp(cur + first * colSize, prev + first * colSize, colSize)) first++;
+			if(first == width && table[outFrames - 1].duration + frames[f].duration <= 0xFFFFu)
+			{
+				// no change. Show the previous frame longer.
+				table[outFrames - 1].duration += frames[f].duration;
+				continue;
+			}
+			if(first == width) first = last - 1;
+			while(last - 1 > first && !memcmp(cur + (last - 1) * colSize, prev + (last - 1) * colSize, colSize)) last--;
+		}
+
+		u32 encSize;
+		u8 *const enc = encodePixels(cur + first * colSize, (last - first) * colSize, codec, &encSize);
+		// keep the frame data word aligned
+		const u32 offset = (outSize + 3) & ~3u;
+		u8 *const tmp = (enc ? (u8*)realloc(out, offset + encSize) : NULL);
+		if(!tmp)
+		{
+			free(enc);
+			ok = false;
+			break;
+		}
+		out = tmp;
+		memset(out + outSize, 0, offset - outSize);
+		memcpy(out + offset, enc, encSize);
+		outSize = offset + encSize;
+		free(enc);
+
+		table[outFrames++] = (SplashFrame){offset, first, last - first, frames[f].duration, 0};
+	}
+
+	if(ok)
+	{
+		SplashHeader header;
+		memcpy(&header.magic, "SPLA", 4);
+		header.width = width;
+		header.height = height;
+		header.flags = FORMAT_RGB565 | FLAG_ROTATED | FLAG_ANIMATED | codecFlags(codec);
+		const SplashAnimHeader animHeader = {outFrames, loops};
+
+		// the unused table entries of merged frames are dropped
+		const u32 usedTable = sizeof(SplashHeader) + sizeof(SplashAnimHeader) + outFrames * sizeof(SplashFrame);
+		memcpy(out, &header, sizeof(header));
+		memcpy(out + sizeof(header), &animHeader, sizeof(animHeader));
+		memcpy(out + sizeof(header) + sizeof(animHeader), table, outFrames * sizeof(SplashFrame));
+		memset(out + usedTable, 0, tableSize - usedTable);
+		ok = writeFile(argv[i + 1], out, outSize);
+		if(!ok) fprintf(stderr, "Can't write '%s'\n", argv[i + 1]);
+		else printf("%s: %u frames, %u bytes\n", argv[i + 1], outFrames, outSize);
+	}
+
+	free(table);
+	free(out);
+	for(u32 f = 0; f < numFrames; f++) free(frames[f].img.pixels);
+	free(frames);
+
+	return (ok ? EXIT_SUCCESS : EXIT_FAILURE);
+}
+
+static int cmdRaw(int argc, char *argv[])
+{
+	if(argc != 2) return EXIT_FAILURE;
+
+	u8 *data;
+	u32 size;
+	if(!readFile(argv[0], &data, &size))
+	{
+		fprintf(stderr, "Can't read '%s'\n", argv[0]);
+		return EXIT_FAILURE;
+	}
+
+	const SplashHeader *const header = (const SplashHeader*)data;
+	u8 *pixels;
+	u32 rawSize = 0;
+	if(size >= sizeof(SplashHeader) && !memcmp(&header->magic, "SPLA", 4) && header->flags & FLAG_ANIMATED)
+	{
+		u32 numFrames;
+		pixels = decodeAnim(data, size, &numFrames);
+		if(pixels) rawSize = header->width * header->height * 2 * numFrames;
+		else fprintf(stderr, "'%s' is not a valid animated splash\n", argv[0]);
+	}
+	else
+	{
+		Image img;
+		pixels = (loadImage(argv[0], &img) ? img.pixels : NULL);
+		if(pixels) rawSize = img.width * img.height * 2;
+	}
+	free(data);
+	if(!pixels) return EXIT_FAILURE;
+
+	const bool ok = writeFile(argv[1], pixels, rawSize);
+	if(!ok) fprintf(stderr, "Can't write '%s'\n", argv[1]);
+	free(pixels);
+
+	return (ok ? EXIT_SUCCESS : EXIT_FAILURE);
+}
+
+static void usage(void)
+{
+	fputs("Usage: splatool pack [-c none|lz11|lz4] <in.spla|in.png> <out.spla>\n"
+	      "       splatool anim [-c lz11|lz4] <in.anim> <out.spla>\n"
+	      "       splatool raw <in.spla|in.png> <out.bin>\n", stderr);
+}
+
+int main(int argc, char *argv[])
+{
+	int res = EXIT_FAILURE;
+	if(argc >= 2)
+	{
+		if(!strcmp(argv[1], "pack")) res = cmdPack(argc - 2, argv + 2);
+		else if(!strcmp(argv[1], "anim")) res = cmdAnim(argc - 2, argv + 2);
+		else if(!strcmp(argv[1], "raw")) res = cmdRaw(argc - 2, argv + 2);
+	}
+	if(res != EXIT_SUCCESS && argc < 3) usage();
+
+	return res;
+}